@@ -60,6 +60,7 @@ using namespace folly::gen;
 
 using apache::thrift::concurrency::ThreadManager;
 using openr::messaging::ReplicateQueue;
+using openr::messaging::SharedReplicateQueue;
 
 namespace {
 //
@@ -245,7 +246,7 @@ main(int argc, char** argv) {
   ReplicateQueue<openr::thrift::InterfaceDatabase> interfaceUpdatesQueue;
   ReplicateQueue<openr::thrift::SparkNeighborEvent> neighborUpdatesQueue;
   ReplicateQueue<openr::thrift::PrefixUpdateRequest> prefixUpdateRequestQueue;
-  ReplicateQueue<openr::thrift::Publication> kvStoreUpdatesQueue;
+  SharedReplicateQueue<openr::thrift::Publication> kvStoreUpdatesQueue;
   ReplicateQueue<openr::thrift::PeerUpdateRequest> peerUpdatesQueue;
   ReplicateQueue<openr::thrift::RouteDatabaseDelta> staticRoutesUpdateQueue;
 
@@ -17,6 +17,7 @@ constexpr folly::StringPiece Constants::kFibTimeMarker;
 constexpr folly::StringPiece Constants::kGlobalCmdLocalIdTemplate;
 constexpr folly::StringPiece Constants::kNodeLabelRangePrefix;
 constexpr folly::StringPiece Constants::kOpenrCtrlSessionContext;
+constexpr folly::StringPiece Constants::kPerAdjDbMarker;
 constexpr folly::StringPiece Constants::kPlatformHost;
 constexpr folly::StringPiece Constants::kPrefixAllocMarker;
 constexpr folly::StringPiece Constants::kPrefixDbMarker;
@@ -45,6 +46,10 @@ constexpr int32_t Constants::kSystemAgentPort;
 constexpr int64_t Constants::kDefaultAdjWeight;
 constexpr int64_t Constants::kTtlInfinity;
 constexpr size_t Constants::kMaxFullSyncPendingCountThreshold;
+constexpr size_t Constants::kMinPrefixesPerRouteBuildShard;
+constexpr size_t Constants::kNumOfKvStoreSyncBuckets;
+constexpr size_t Constants::kKvStoreMinCompressionSize;
+constexpr size_t Constants::kKvStoreMaxUncompressedSize;
 constexpr size_t Constants::kNumTimeSeries;
 constexpr std::chrono::milliseconds Constants::kFloodPendingPublication;
 constexpr std::chrono::milliseconds Constants::kInitialBackoff;
@@ -77,6 +82,7 @@ constexpr std::chrono::seconds Constants::kKeepAliveIntvl;
 constexpr std::chrono::seconds Constants::kKeepAliveTime;
 constexpr std::chrono::seconds Constants::kMemoryThresholdTime;
 constexpr std::chrono::seconds Constants::kNetlinkSyncThrottleInterval;
+constexpr std::chrono::seconds Constants::kPlatformRouteCacheAuditInterval;
 constexpr std::chrono::seconds Constants::kPlatformSyncInterval;
 constexpr std::chrono::seconds Constants::kPlatformThriftIdleTimeout;
 constexpr std::chrono::seconds Constants::kStoreSyncInterval;
@@ -95,6 +95,17 @@ class Constants {
   // kMaxBackoff to send the next sync request
   static constexpr size_t kMaxFullSyncPendingCountThreshold{32};
 
+  // Number of key buckets in KvStore hash summary exchanged during full sync
+  static constexpr size_t kNumOfKvStoreSyncBuckets{4096};
+
+  // Minimum size of serialized KvStore message to compress it for peers
+  // supporting compression. Smaller messages hardly benefit from it
+  static constexpr size_t kKvStoreMinCompressionSize{1024};
+
+  // Maximum size a compressed KvStore message may expand to. Payloads
+  // claiming to be larger are rejected instead of being inflated
+  static constexpr size_t kKvStoreMaxUncompressedSize{256 * 1024 * 1024};
+
   //
   // PrefixAllocator specific
 
@@ -158,6 +169,10 @@ class Constants {
   // time interval to sync between Open/R and Platform
   static constexpr std::chrono::seconds kPlatformSyncInterval{60};
 
+  // time interval to audit routes cached by platform against kernel routes.
+  // Syncs in between are served from the cache
+  static constexpr std::chrono::seconds kPlatformRouteCacheAuditInterval{600};
+
   // time interval for keep alive check between fib and switch agent
   static constexpr std::chrono::milliseconds kKeepAliveCheckInterval{1000};
 
@@ -195,6 +210,7 @@ class Constants {
 
   // KvStore key markers
   static constexpr folly::StringPiece kAdjDbMarker{"adj:"};
+  static constexpr folly::StringPiece kPerAdjDbMarker{"adjacency:"};
   static constexpr folly::StringPiece kPrefixDbMarker{"prefix:"};
   static constexpr folly::StringPiece kPrefixAllocMarker{"allocprefix:"};
   static constexpr folly::StringPiece kFibTimeMarker{"fibtime:"};
@@ -228,6 +244,14 @@ class Constants {
   // hold time for longPoll requests in openrCtrl thrift server
   static constexpr std::chrono::milliseconds kLongPollReqHoldTime{20000};
 
+  //
+  // Decision specific
+  //
+
+  // minimum number of prefixes assigned to each worker when route build is
+  // sharded across threads. Smaller route builds run inline
+  static constexpr size_t kMinPrefixesPerRouteBuildShard{1000};
+
   //
   // Prefix manager specific
   //
@@ -124,6 +124,12 @@ DEFINE_bool(
     enable_rtt_metric,
     true,
     "Use dynamically learned RTT for interface metric values.");
+DEFINE_bool(
+    enable_per_adjacency_keys,
+    false,
+    "Advertise each adjacency under its own key in KvStore instead of full "
+    "adjacency database of the node. Enable only once all nodes run a version "
+    "which understands per adjacency keys");
 DEFINE_bool(
     enable_v4,
     false,
@@ -236,6 +242,15 @@ DEFINE_bool(
     true,
     "Enable performance measurement in network.");
 DEFINE_bool(enable_rib_policy, false, "Enable RibPolicy in Decision module");
+DEFINE_bool(
+    enable_incremental_spf,
+    false,
+    "Incrementally update SPF results on topology changes in Decision module");
+DEFINE_int32(
+    decision_route_build_threads,
+    0,
+    "Number of threads to shard per-prefix route computation in Decision. "
+    "0 or 1 computes routes inline");
 DEFINE_int32(
     decision_debounce_min_ms,
     10,
@@ -54,6 +54,7 @@ DECLARE_string(cert_file_path);
 DECLARE_bool(enable_encryption);
 DECLARE_bool(enable_fib_service_waiting);
 DECLARE_bool(enable_rtt_metric);
+DECLARE_bool(enable_per_adjacency_keys);
 DECLARE_bool(enable_v4);
 DECLARE_bool(enable_lfa);
 DECLARE_bool(enable_ordered_fib_programming);
@@ -84,6 +85,10 @@ DECLARE_bool(enable_perf_measurement);
 
 DECLARE_bool(enable_rib_policy);
 
+DECLARE_bool(enable_incremental_spf);
+
+DECLARE_int32(decision_route_build_threads);
+
 DECLARE_int32(decision_debounce_min_ms);
 DECLARE_int32(decision_debounce_max_ms);
 
@@ -0,0 +1,279 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <folly/IPAddress.h>
+
+namespace openr {
+
+/*
+ * Patricia (path compressed binary radix) trie keyed by IP prefixes. IPv4 and
+ * IPv6 prefixes are kept in separate tries. Supports
+ * - exact match
+ * - longest prefix match (most specific prefix covering a given prefix)
+ * - subtree queries (all prefixes covered by a given prefix)
+ *
+ * Every lookup walks at most one node per prefix length, regardless of the
+ * number of stored prefixes. Address bits beyond prefix length are ignored.
+ */
+template <typename T>
+class PrefixTrie {
+ public:
+  using Entry = std::pair<folly::CIDRNetwork, T>;
+
+  // Insert or overwrite value of the prefix. Returns true if prefix is new
+  bool
+  insert(folly::CIDRNetwork const& prefix, T value) {
+    auto const key = toKey(prefix.first);
+    auto const len = prefix.second;
+    auto* link = &getRoot(prefix.first);
+    while (true) {
+      auto* node = link->get();
+      if (not node) {
+        *link = std::make_unique<Node>(key, len);
+        (*link)->entry.emplace(prefix, std::move(value));
+        ++size_;
+        return true;
+      }
+
+      auto const common =
+          commonPrefixLength(key, node->key, std::min(len, node->len));
+      if (common == node->len) {
+        if (node->len == len) {
+          const bool isNew = not node->entry.has_value();
+          node->entry.emplace(prefix, std::move(value));
+          size_ += isNew ? 1 : 0;
+          return isNew;
+        }
+        // prefix belongs under this node
+        link = &node->children[getBit(key, node->len)];
+        continue;
+      }
+
+      // prefix diverges from node before node's length. Insert a node at the
+      // divergence point with existing node as one of its children
+      auto split = std::make_unique<Node>(maskKey(key, common), common);
+      split->children[getBit(node->key, common)] = std::move(*link);
+      if (common == len) {
+        split->entry.emplace(prefix, std::move(value));
+      } else {
+        auto leaf = std::make_unique<Node>(key, len);
+        leaf->entry.emplace(prefix, std::move(value));
+        split->children[getBit(key, common)] = std::move(leaf);
+      }
+      *link = std::move(split);
+      ++size_;
+      return true;
+    }
+  }
+
+  // Remove prefix. Returns true if prefix existed
+  bool
+  erase(folly::CIDRNetwork const& prefix) {
+    auto const key = toKey(prefix.first);
+    auto const len = prefix.second;
+    std::vector<std::unique_ptr<Node>*> path;
+    auto* link = &getRoot(prefix.first);
+    while (auto* node = link->get()) {
+      if (node->len > len or
+          commonPrefixLength(key, node->key, node->len) != node->len) {
+        return false;
+      }
+      path.emplace_back(link);
+      if (node->len == len) {
+        break;
+      }
+      link = &node->children[getBit(key, node->len)];
+    }
+    if (path.empty() or path.back()->get()->len != len or
+        not path.back()->get()->entry.has_value()) {
+      return false;
+    }
+    path.back()->get()->entry.reset();
+    --size_;
+
+    // compact the path: nodes without entry need at least two children
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+      auto& node = **it;
+      if (node->entry.has_value() or
+          (node->children[0] and node->children[1])) {
+        break;
+      }
+      if (node->children[0] or node->children[1]) {
+        // parent's number of children doesn't change
+        auto child = std::move(node->children[node->children[0] ? 0 : 1]);
+        node = std::move(child);
+        break;
+      }
+      node.reset();
+    }
+    return true;
+  }
+
+  Entry const*
+  exactMatch(folly::CIDRNetwork const& prefix) const {
+    auto const key = toKey(prefix.first);
+    auto const len = prefix.second;
+    auto const* node = getRoot(prefix.first).get();
+    while (node and node->len <= len and
+           commonPrefixLength(key, node->key, node->len) == node->len) {
+      if (node->len == len) {
+        return node->entry ? &*node->entry : nullptr;
+      }
+      node = node->children[getBit(key, node->len)].get();
+    }
+    return nullptr;
+  }
+
+  // Most specific stored prefix covering the given prefix (including itself)
+  Entry const*
+  longestPrefixMatch(folly::CIDRNetwork const& prefix) const {
+    auto const key = toKey(prefix.first);
+    auto const len = prefix.second;
+    Entry const* match{nullptr};
+    auto const* node = getRoot(prefix.first).get();
+    while (node and node->len <= len and
+           commonPrefixLength(key, node->key, node->len) == node->len) {
+      if (node->entry) {
+        match = &*node->entry;
+      }
+      if (node->len == len) {
+        break;
+      }
+      node = node->children[getBit(key, node->len)].get();
+    }
+    return match;
+  }
+
+  // All stored prefixes covered by the given prefix (including itself) in
+  // address order, less specific first
+  std::vector<Entry const*>
+  getSubtree(folly::CIDRNetwork const& prefix) const {
+    auto const key = toKey(prefix.first);
+    auto const len = prefix.second;
+    std::vector<Entry const*> entries;
+    auto const* node = getRoot(prefix.first).get();
+    while (node and node->len < len) {
+      if (commonPrefixLength(key, node->key, node->len) != node->len) {
+        return entries;
+      }
+      node = node->children[getBit(key, node->len)].get();
+    }
+    if (node and commonPrefixLength(key, node->key, len) == len) {
+      collect(node, entries);
+    }
+    return entries;
+  }
+
+  size_t
+  size() const {
+    return size_;
+  }
+
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+  void
+  clear() {
+    v4Root_.reset();
+    v6Root_.reset();
+    size_ = 0;
+  }
+
+ private:
+  // address bytes in network order, IPv4 uses first 4 bytes only
+  using Key = std::array<uint8_t, 16>;
+
+  struct Node {
+    Node(Key const& k, uint8_t l) : key(maskKey(k, l)), len(l) {}
+
+    // prefix of the node, bits beyond len are zero
+    Key key;
+    uint8_t len{0};
+    // set for nodes holding a stored prefix. Others are branching points
+    std::optional<Entry> entry;
+    std::array<std::unique_ptr<Node>, 2> children;
+  };
+
+  static Key
+  toKey(folly::IPAddress const& addr) {
+    Key key{};
+    std::copy(addr.bytes(), addr.bytes() + addr.byteCount(), key.begin());
+    return key;
+  }
+
+  static Key
+  maskKey(Key key, uint8_t len) {
+    for (size_t i = 0; i < key.size(); ++i) {
+      if (len >= 8 * (i + 1)) {
+        continue;
+      }
+      auto const bits = len > 8 * i ? len - 8 * i : 0;
+      key[i] &= static_cast<uint8_t>(0xff00 >> bits);
+    }
+    return key;
+  }
+
+  static size_t
+  getBit(Key const& key, uint8_t pos) {
+    return (key[pos / 8] >> (7 - pos % 8)) & 0x1;
+  }
+
+  // length of common leading bits of a and b, capped at maxLen
+  static uint8_t
+  commonPrefixLength(Key const& a, Key const& b, uint8_t maxLen) {
+    for (size_t i = 0; 8 * i < maxLen; ++i) {
+      const uint8_t diff = a[i] ^ b[i];
+      if (diff) {
+        uint8_t len = 8 * i;
+        for (uint8_t mask = 0x80; not(diff & mask); mask >>= 1) {
+          ++len;
+        }
+        return std::min(len, maxLen);
+      }
+    }
+    return maxLen;
+  }
+
+  static void
+  collect(Node const* node, std::vector<Entry const*>& entries) {
+    if (node->entry) {
+      entries.emplace_back(&*node->entry);
+    }
+    for (auto const& child : node->children) {
+      if (child) {
+        collect(child.get(), entries);
+      }
+    }
+  }
+
+  std::unique_ptr<Node>&
+  getRoot(folly::IPAddress const& addr) {
+    return addr.isV4() ? v4Root_ : v6Root_;
+  }
+
+  std::unique_ptr<Node> const&
+  getRoot(folly::IPAddress const& addr) const {
+    return addr.isV4() ? v4Root_ : v6Root_;
+  }
+
+  std::unique_ptr<Node> v4Root_;
+  std::unique_ptr<Node> v6Root_;
+  size_t size_{0};
+};
+
+} // namespace openr
@@ -16,9 +16,30 @@
 
 namespace openr {
 
-// create RE2 set for the list of key prefixes
+// Split key prefixes into a table of literal prefixes and RE2 set of regexes
 KeyPrefix::KeyPrefix(std::vector<std::string> const& keyPrefixList) {
-  if (keyPrefixList.empty()) {
+  std::vector<std::string> regexes;
+  for (auto const& keyPrefix : keyPrefixList) {
+    if (auto literalPrefix = getLiteralPrefix(keyPrefix)) {
+      literalPrefixes_.emplace_back(std::move(*literalPrefix));
+    } else {
+      regexes.emplace_back(keyPrefix);
+    }
+  }
+
+  // Sorting places a prefix right before all the prefixes extending it. Keep
+  // the shortest one only as it matches superset of keys
+  std::sort(literalPrefixes_.begin(), literalPrefixes_.end());
+  std::vector<std::string> shortestPrefixes;
+  for (auto& prefix : literalPrefixes_) {
+    if (shortestPrefixes.empty() or
+        not folly::StringPiece(prefix).startsWith(shortestPrefixes.back())) {
+      shortestPrefixes.emplace_back(std::move(prefix));
+    }
+  }
+  literalPrefixes_ = std::move(shortestPrefixes);
+
+  if (regexes.empty()) {
     return;
   }
   re2::RE2::Options re2Options;
@@ -27,7 +48,7 @@ KeyPrefix::KeyPrefix(std::vector<std::string> const& keyPrefixList) {
       std::make_unique<re2::RE2::Set>(re2Options, re2::RE2::ANCHOR_START);
   std::string re2AddError{};
 
-  for (auto const& keyPrefix : keyPrefixList) {
+  for (auto const& keyPrefix : regexes) {
     if (keyPrefix_->Add(keyPrefix, &re2AddError) < 0) {
       LOG(FATAL) << "Failed to add prefixes to RE2 set: '" << keyPrefix << "', "
                  << "error: '" << re2AddError << "'";
@@ -40,14 +61,37 @@ KeyPrefix::KeyPrefix(std::vector<std::string> const& keyPrefixList) {
   }
 }
 
+std::optional<std::string>
+KeyPrefix::getLiteralPrefix(std::string const& keyPrefix) {
+  folly::StringPiece literalPrefix(keyPrefix);
+  // Regex is anchored at start only, trailing wildcard matches any suffix
+  while (literalPrefix.removeSuffix(".*")) {
+  }
+  if (literalPrefix.find_first_of("\\^$.|?*+()[]{}") !=
+      folly::StringPiece::npos) {
+    return std::nullopt;
+  }
+  return literalPrefix.str();
+}
+
 // match the key with the list of prefixes
 bool
 KeyPrefix::keyMatch(std::string const& key) const {
-  if (!keyPrefix_) {
+  if (literalPrefixes_.empty() and !keyPrefix_) {
     return true;
   }
-  std::vector<int> matches;
-  return keyPrefix_->Match(key, &matches);
+  // Only literal prefix which can match is the greatest one not greater than
+  // key, since none of them is a prefix of another one
+  auto it = std::upper_bound(
+      literalPrefixes_.begin(), literalPrefixes_.end(), key);
+  if (it != literalPrefixes_.begin() and
+      folly::StringPiece(key).startsWith(*std::prev(it))) {
+    return true;
+  }
+  if (!keyPrefix_) {
+    return false;
+  }
+  return keyPrefix_->Match(key, nullptr);
 }
 
 PrefixKey::PrefixKey(
@@ -707,12 +751,14 @@ createPeerSpec(
     const std::string& cmdUrl,
     const std::string& peerAddr,
     const int32_t port,
-    bool supportFloodOptimization) {
+    bool supportFloodOptimization,
+    bool supportCompression) {
   thrift::PeerSpec peerSpec;
   peerSpec.cmdUrl = cmdUrl;
   peerSpec.peerAddr = peerAddr;
   peerSpec.ctrlPort = port;
   peerSpec.supportFloodOptimization = supportFloodOptimization;
+  peerSpec.supportCompression = supportCompression;
   return peerSpec;
 }
 
@@ -724,7 +770,8 @@ createSparkNeighborEvent(
     int64_t rttUs,
     int32_t label,
     bool supportFloodOptimization,
-    const std::string& area) {
+    const std::string& area,
+    bool supportCompression) {
   thrift::SparkNeighborEvent event;
   event.eventType = eventType;
   event.ifName = ifName;
@@ -733,6 +780,7 @@ createSparkNeighborEvent(
   event.label = label;
   event.supportFloodOptimization = supportFloodOptimization;
   event.area = area;
+  event.supportCompression = supportCompression;
   return event;
 }
 
@@ -1043,6 +1091,25 @@ getNodeNameFromKey(const std::string& key) {
   return split[1];
 }
 
+std::string
+getPerAdjacencyKey(
+    const std::string& node,
+    const std::string& otherNode,
+    const std::string& ifName) {
+  return folly::to<std::string>(
+      Constants::kPerAdjDbMarker,
+      node,
+      Constants::kPrefixNameSeparator,
+      otherNode,
+      Constants::kPrefixNameSeparator,
+      ifName);
+}
+
+bool
+isPerAdjacencyKey(const std::string& key) {
+  return key.find(Constants::kPerAdjDbMarker.toString()) == 0;
+}
+
 std::string
 createPeerSyncId(const std::string& node, const std::string& area) {
   return folly::to<std::string>(node, "::TCP::SYNC::", area);
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <optional>
 #include <random>
 #include <string>
 #include <vector>
@@ -68,10 +69,20 @@ namespace openr {
  */
 class KeyPrefix {
  public:
+  // Entries are regexes anchored at the start of key. Literal ones, like
+  // "adj:" or "prefix:.*", are matched without RE2
   explicit KeyPrefix(std::vector<std::string> const& keyPrefixList);
   bool keyMatch(std::string const& key) const;
 
  private:
+  // Literal prefix of keys matched by the regex if there is one
+  static std::optional<std::string> getLiteralPrefix(
+      std::string const& keyPrefix);
+
+  // Sorted literal prefixes with none being a prefix of another one
+  std::vector<std::string> literalPrefixes_;
+
+  // RE2 set of remaining entries, which are true regexes
   std::unique_ptr<re2::RE2::Set> keyPrefix_;
 };
 
@@ -361,7 +372,8 @@ thrift::PeerSpec createPeerSpec(
     const std::string& cmdUrl,
     const std::string& thriftPeerAddr = "",
     const int32_t port = 0,
-    bool supportFloodOptimization = false);
+    bool supportFloodOptimization = false,
+    bool supportCompression = false);
 
 thrift::SparkNeighbor createSparkNeighbor(
     const std::string& nodeName,
@@ -378,7 +390,8 @@ thrift::SparkNeighborEvent createSparkNeighborEvent(
     int64_t rttUs,
     int32_t label,
     bool supportFloodOptimization,
-    const std::string& area = openr::thrift::KvStore_constants::kDefaultArea());
+    const std::string& area = openr::thrift::KvStore_constants::kDefaultArea(),
+    bool supportCompression = false);
 
 thrift::Adjacency createAdjacency(
     const std::string& nodeName,
@@ -485,6 +498,20 @@ std::vector<thrift::MplsRoute> createMplsRoutesWithBestNextHopsMap(
 
 std::string getNodeNameFromKey(const std::string& key);
 
+/**
+ * Key of a single adjacency of `node` towards `otherNode` over `ifName`, e.g.
+ * `adjacency:<node>:<otherNode>:<ifName>`. Marker differs from the one of full
+ * adjacency database key `adj:<node>`, so that nodes unaware of per adjacency
+ * keys ignore them instead of misparsing them as adjacency database of a node.
+ * getNodeNameFromKey works for both.
+ */
+std::string getPerAdjacencyKey(
+    const std::string& node,
+    const std::string& otherNode,
+    const std::string& ifName);
+
+bool isPerAdjacencyKey(const std::string& key);
+
 std::string createPeerSyncId(const std::string& node, const std::string& area);
 
 namespace MetricVectorUtils {
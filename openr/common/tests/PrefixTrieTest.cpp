@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <map>
+#include <optional>
+#include <random>
+
+#include <folly/Format.h>
+#include <folly/IPAddress.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/PrefixTrie.h>
+
+using namespace openr;
+
+namespace {
+
+folly::CIDRNetwork
+toNetwork(std::string const& prefix) {
+  return folly::IPAddress::createNetwork(prefix);
+}
+
+std::vector<std::string>
+toStrings(std::vector<PrefixTrie<int>::Entry const*> const& entries) {
+  std::vector<std::string> prefixes;
+  for (auto const* entry : entries) {
+    prefixes.emplace_back(folly::IPAddress::networkToString(entry->first));
+  }
+  return prefixes;
+}
+
+} // namespace
+
+TEST(PrefixTrieTest, BasicOperation) {
+  PrefixTrie<int> trie;
+  EXPECT_TRUE(trie.empty());
+  EXPECT_EQ(nullptr, trie.longestPrefixMatch(toNetwork("10.0.0.1/32")));
+
+  EXPECT_TRUE(trie.insert(toNetwork("10.0.0.0/8"), 1));
+  EXPECT_TRUE(trie.insert(toNetwork("10.1.0.0/16"), 2));
+  EXPECT_TRUE(trie.insert(toNetwork("10.1.1.0/24"), 3));
+  EXPECT_TRUE(trie.insert(toNetwork("0.0.0.0/0"), 4));
+  EXPECT_TRUE(trie.insert(toNetwork("fc00::/7"), 5));
+  EXPECT_TRUE(trie.insert(toNetwork("fc00:1::/32"), 6));
+  // overwrite
+  EXPECT_FALSE(trie.insert(toNetwork("10.1.0.0/16"), 7));
+  EXPECT_EQ(6, trie.size());
+
+  // exact match
+  EXPECT_EQ(7, trie.exactMatch(toNetwork("10.1.0.0/16"))->second);
+  EXPECT_EQ(nullptr, trie.exactMatch(toNetwork("10.1.0.0/17")));
+  EXPECT_EQ(nullptr, trie.exactMatch(toNetwork("10.0.0.0/7")));
+
+  // longest prefix match
+  EXPECT_EQ(3, trie.longestPrefixMatch(toNetwork("10.1.1.1/32"))->second);
+  EXPECT_EQ(3, trie.longestPrefixMatch(toNetwork("10.1.1.0/24"))->second);
+  EXPECT_EQ(7, trie.longestPrefixMatch(toNetwork("10.1.0.0/23"))->second);
+  EXPECT_EQ(1, trie.longestPrefixMatch(toNetwork("10.2.0.0/16"))->second);
+  EXPECT_EQ(4, trie.longestPrefixMatch(toNetwork("11.0.0.0/8"))->second);
+  EXPECT_EQ(4, trie.longestPrefixMatch(toNetwork("10.0.0.0/7"))->second);
+  EXPECT_EQ(6, trie.longestPrefixMatch(toNetwork("fc00:1::1/128"))->second);
+  EXPECT_EQ(5, trie.longestPrefixMatch(toNetwork("fd00::1/128"))->second);
+  // no default route for v6
+  EXPECT_EQ(nullptr, trie.longestPrefixMatch(toNetwork("2001::1/128")));
+
+  // subtree
+  EXPECT_EQ(
+      std::vector<std::string>({"10.0.0.0/8", "10.1.0.0/16", "10.1.1.0/24"}),
+      toStrings(trie.getSubtree(toNetwork("10.0.0.0/8"))));
+  EXPECT_EQ(
+      std::vector<std::string>({"10.1.0.0/16", "10.1.1.0/24"}),
+      toStrings(trie.getSubtree(toNetwork("10.1.0.0/15"))));
+  EXPECT_EQ(
+      std::vector<std::string>({"fc00:1::/32"}),
+      toStrings(trie.getSubtree(toNetwork("fc00::/16"))));
+  EXPECT_TRUE(trie.getSubtree(toNetwork("10.2.0.0/16")).empty());
+  EXPECT_EQ(4, trie.getSubtree(toNetwork("0.0.0.0/0")).size());
+
+  // erase
+  EXPECT_TRUE(trie.erase(toNetwork("10.1.0.0/16")));
+  EXPECT_FALSE(trie.erase(toNetwork("10.1.0.0/16")));
+  EXPECT_FALSE(trie.erase(toNetwork("10.1.0.0/17")));
+  EXPECT_EQ(1, trie.longestPrefixMatch(toNetwork("10.1.0.1/32"))->second);
+  EXPECT_EQ(3, trie.longestPrefixMatch(toNetwork("10.1.1.1/32"))->second);
+  EXPECT_EQ(5, trie.size());
+
+  trie.clear();
+  EXPECT_TRUE(trie.empty());
+  EXPECT_EQ(nullptr, trie.longestPrefixMatch(toNetwork("10.1.1.1/32")));
+}
+
+/**
+ * Cross check trie lookups against linear scan over random prefixes
+ */
+TEST(PrefixTrieTest, RandomizedLookups) {
+  std::mt19937 gen(0x5eed);
+  // small address space so that prefixes nest and share branches
+  auto randomNetwork = [&gen]() {
+    const bool isV4 = gen() % 2;
+    auto const addr = isV4
+        ? folly::IPAddress(folly::sformat("10.{}.{}.0", gen() % 4, gen() % 4))
+        : folly::IPAddress(folly::sformat("fc00:{:x}::", gen() % 16));
+    const uint8_t len = gen() % (isV4 ? 33 : 129);
+    return folly::CIDRNetwork(addr.mask(len), len);
+  };
+  auto covers = [](folly::CIDRNetwork const& a, folly::CIDRNetwork const& b) {
+    return a.first.family() == b.first.family() and a.second <= b.second and
+        b.first.mask(a.second) == a.first;
+  };
+
+  PrefixTrie<int> trie;
+  std::map<std::string, std::pair<folly::CIDRNetwork, int>> expected;
+  for (int i = 0; i < 5000; ++i) {
+    auto const prefix = randomNetwork();
+    auto const key = folly::IPAddress::networkToString(prefix);
+    if (gen() % 3) {
+      EXPECT_EQ(0 == expected.count(key), trie.insert(prefix, i));
+      expected.insert_or_assign(key, std::make_pair(prefix, i));
+    } else {
+      EXPECT_EQ(1 == expected.count(key), trie.erase(prefix));
+      expected.erase(key);
+    }
+    ASSERT_EQ(expected.size(), trie.size());
+
+    auto const query = randomNetwork();
+    auto const* exact = trie.exactMatch(query);
+    auto const it = expected.find(folly::IPAddress::networkToString(query));
+    ASSERT_EQ(it != expected.end(), exact != nullptr);
+    if (exact) {
+      EXPECT_EQ(it->second.second, exact->second);
+    }
+
+    std::optional<folly::CIDRNetwork> bestMatch;
+    size_t numCovered{0};
+    for (auto const& [_, entry] : expected) {
+      if (covers(entry.first, query) and
+          (not bestMatch or bestMatch->second < entry.first.second)) {
+        bestMatch = entry.first;
+      }
+      numCovered += covers(query, entry.first) ? 1 : 0;
+    }
+    auto const* match = trie.longestPrefixMatch(query);
+    ASSERT_EQ(bestMatch.has_value(), match != nullptr);
+    if (match) {
+      EXPECT_EQ(*bestMatch, match->first);
+    }
+    auto const subtree = trie.getSubtree(query);
+    EXPECT_EQ(numCovered, subtree.size());
+    for (auto const* entry : subtree) {
+      EXPECT_TRUE(covers(query, entry->first));
+    }
+  }
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
@@ -378,6 +378,52 @@ TEST(UtilTest, checkIncludeExcludeRegex) {
       checkIncludeExcludeRegex("eth", includeRegexList, excludeRegexList));
 }
 
+TEST(UtilTest, KeyPrefixTest) {
+  // no prefixes matches all keys
+  EXPECT_TRUE(KeyPrefix(std::vector<std::string>{}).keyMatch("adj:node1"));
+
+  // literal prefixes, including redundant ones
+  {
+    KeyPrefix keyPrefix({"prefix:", "adj:", "adj:node1", "allocprefix:.*"});
+    EXPECT_TRUE(keyPrefix.keyMatch("adj:node1"));
+    EXPECT_TRUE(keyPrefix.keyMatch("adj:"));
+    EXPECT_TRUE(keyPrefix.keyMatch("prefix:node1:0:[::/0]"));
+    EXPECT_TRUE(keyPrefix.keyMatch("allocprefix:1"));
+    EXPECT_FALSE(keyPrefix.keyMatch("adj"));
+    EXPECT_FALSE(keyPrefix.keyMatch("ad"));
+    EXPECT_FALSE(keyPrefix.keyMatch("node:adj:"));
+    EXPECT_FALSE(keyPrefix.keyMatch("Adj:node1"));
+    EXPECT_FALSE(keyPrefix.keyMatch("b"));
+    EXPECT_FALSE(keyPrefix.keyMatch(""));
+  }
+
+  // chains of prefixes extending each other
+  {
+    KeyPrefix keyPrefix({"abc", "a", "ab", "b", "ba", "bab"});
+    EXPECT_TRUE(keyPrefix.keyMatch("a"));
+    EXPECT_TRUE(keyPrefix.keyMatch("ac"));
+    EXPECT_TRUE(keyPrefix.keyMatch("abd"));
+    EXPECT_TRUE(keyPrefix.keyMatch("bc"));
+    EXPECT_FALSE(keyPrefix.keyMatch("c"));
+  }
+
+  // empty literal prefix matches all keys
+  EXPECT_TRUE(KeyPrefix({"adj:", ""}).keyMatch("prefix:node1"));
+  EXPECT_TRUE(KeyPrefix(std::vector<std::string>{".*"}).keyMatch(""));
+
+  // literal prefixes mixed with regexes
+  {
+    KeyPrefix keyPrefix({"adj:", "prefix:[a-z]+[0-9]", "node\\.1", "a.c"});
+    EXPECT_TRUE(keyPrefix.keyMatch("adj:node1"));
+    EXPECT_TRUE(keyPrefix.keyMatch("prefix:node1"));
+    EXPECT_FALSE(keyPrefix.keyMatch("prefix:1node"));
+    EXPECT_TRUE(keyPrefix.keyMatch("node.1"));
+    EXPECT_FALSE(keyPrefix.keyMatch("nodex1"));
+    EXPECT_TRUE(keyPrefix.keyMatch("abc"));
+    EXPECT_FALSE(keyPrefix.keyMatch("ac"));
+  }
+}
+
 TEST(UtilTest, createLoopbackAddr) {
   {
     auto network = folly::IPAddress::createNetwork("fc00::/64");
@@ -200,6 +200,15 @@ Config::populateInternalDb() {
         "enable_ordered_fib_programming only support single area config"));
   }
 
+  //
+  // Decision
+  //
+  if (config_.decision_route_build_threads < 0) {
+    throw std::out_of_range(folly::sformat(
+        "decision_route_build_threads ({}) should be >= 0",
+        config_.decision_route_build_threads));
+  }
+
   //
   // Kvstore
   //
@@ -99,6 +99,11 @@ class Config {
     return *config_.enable_periodic_sync_ref();
   }
 
+  bool
+  isIncrementalSpfEnabled() const {
+    return *config_.enable_incremental_spf_ref();
+  }
+
   //
   // area
   //
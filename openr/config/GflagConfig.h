@@ -130,6 +130,7 @@ class GflagConfig final {
     lmConf.linkflap_initial_backoff_ms = FLAGS_link_flap_initial_backoff_ms;
     lmConf.linkflap_max_backoff_ms = FLAGS_link_flap_max_backoff_ms;
     lmConf.use_rtt_metric = FLAGS_enable_rtt_metric;
+    lmConf.enable_per_adjacency_keys = FLAGS_enable_per_adjacency_keys;
     folly::split(
         ",", FLAGS_iface_regex_include, lmConf.include_interface_regexes, true);
     folly::split(
@@ -220,6 +221,10 @@ class GflagConfig final {
     // RibPolicy
     config.enable_rib_policy = FLAGS_enable_rib_policy;
 
+    // Decision
+    config.enable_incremental_spf = FLAGS_enable_incremental_spf;
+    config.decision_route_build_threads = FLAGS_decision_route_build_threads;
+
     // KvStore thrift migration knobs
     if (auto v = FLAGS_enable_kvstore_thrift) {
       config.enable_kvstore_thrift = v;
@@ -70,13 +70,13 @@ OpenrCtrlHandler::OpenrCtrlHandler(
 
         SYNCHRONIZED(kvStorePublishers_) {
           for (auto& kv : kvStorePublishers_) {
-            kv.second->publish(maybePublication.value());
+            kv.second->publish(*maybePublication.value());
           }
         }
 
         bool isAdjChanged = false;
         // check if any of KeyVal has 'adj' update
-        for (auto& kv : maybePublication.value().keyVals) {
+        for (auto& kv : maybePublication.value()->keyVals) {
           auto& key = kv.first;
           auto& val = kv.second;
           // check if we have any value update.
@@ -85,8 +85,9 @@ OpenrCtrlHandler::OpenrCtrlHandler(
             continue;
           }
 
-          // "adj:*" key has changed. Update local collection
-          if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
+          // "adj:*" or per adjacency key has changed. Update local collection
+          if (key.find(Constants::kAdjDbMarker.toString()) == 0 or
+              isPerAdjacencyKey(key)) {
             VLOG(3) << "Adj key: " << key << " change received";
             isAdjChanged = true;
             break;
@@ -512,18 +513,21 @@ OpenrCtrlHandler::semifuture_longPollKvStoreAdj(
 
   thrift::KeyDumpParams params;
 
-  // build thrift::KeyVals with "adj:" key ONLY
-  // to ensure KvStore ONLY compare "adj:" key
+  // build thrift::KeyVals with "adj:" and per adjacency keys ONLY
+  // to ensure KvStore ONLY compare adjacency keys
   thrift::KeyVals adjKeyVals;
   for (auto& kv : *snapshot) {
-    if (kv.first.find(Constants::kAdjDbMarker.toString()) == 0) {
+    if (kv.first.find(Constants::kAdjDbMarker.toString()) == 0 or
+        isPerAdjacencyKey(kv.first)) {
       adjKeyVals.emplace(kv.first, kv.second);
     }
   }
 
-  // Only care about "adj:" key
+  // Only care about "adj:" and per adjacency keys
   params.prefix = Constants::kAdjDbMarker;
-  params.keys_ref() = {Constants::kAdjDbMarker.toString()};
+  params.keys_ref() = {
+      Constants::kAdjDbMarker.toString(),
+      Constants::kPerAdjDbMarker.toString()};
   // Only dump difference between KvStore and client snapshot
   params.keyValHashes_ref() = std::move(adjKeyVals);
 
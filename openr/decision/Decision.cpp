@@ -14,6 +14,8 @@
 
 #include <fb303/ServiceData.h>
 #include <folly/Format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/MapUtil.h>
 #include <folly/Memory.h>
 #include <folly/Optional.h>
@@ -44,6 +46,24 @@ using SpfResult = openr::LinkState::SpfResult;
 
 namespace openr {
 
+namespace {
+
+// per adjacency key carries either no adjacency (withdraw) or the single
+// adjacency it is named after
+bool
+isValidPerAdjacencyDb(
+    const std::string& key, const thrift::AdjacencyDatabase& adjDb) {
+  if (adjDb.adjacencies.empty()) {
+    return true;
+  }
+  auto const& adj = adjDb.adjacencies.front();
+  return adjDb.adjacencies.size() == 1 and
+      key ==
+      getPerAdjacencyKey(adjDb.thisNodeName, adj.otherNodeName, adj.ifName);
+}
+
+} // namespace
+
 DecisionRouteUpdate
 getRouteDelta(const DecisionRouteDb& newDb, const DecisionRouteDb& oldDb) {
   DecisionRouteUpdate delta;
@@ -95,13 +115,20 @@ class SpfSolver::SpfSolverImpl {
       bool computeLfaPaths,
       bool enableOrderedFib,
       bool bgpDryRun,
-      bool bgpUseIgpMetric)
+      bool bgpUseIgpMetric,
+      size_t numRouteBuildThreads)
       : myNodeName_(myNodeName),
         enableV4_(enableV4),
         computeLfaPaths_(computeLfaPaths),
         enableOrderedFib_(enableOrderedFib),
         bgpDryRun_(bgpDryRun),
         bgpUseIgpMetric_(bgpUseIgpMetric) {
+    if (numRouteBuildThreads > 1) {
+      routeBuildPool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          numRouteBuildThreads,
+          std::make_shared<folly::NamedThreadFactory>("DecisionRouteBuild"));
+    }
+
     // Initialize stat keys
     fb303::fbData->addStatExportType("decision.adj_db_update", fb303::COUNT);
     fb303::fbData->addStatExportType(
@@ -125,6 +152,11 @@ class SpfSolver::SpfSolverImpl {
     fb303::fbData->addStatExportType("decision.spf_ms", fb303::AVG);
     fb303::fbData->addStatExportType("decision.spf_runs", fb303::COUNT);
     fb303::fbData->addStatExportType("decision.errors", fb303::COUNT);
+    fb303::fbData->addStatExportType(
+        "decision.incremental_route_build_ms", fb303::AVG);
+    fb303::fbData->addStatExportType(
+        "decision.incremental_spf_runs", fb303::COUNT);
+    fb303::fbData->addStatExportType("decision.incremental_spf_us", fb303::AVG);
   }
 
   ~SpfSolverImpl() = default;
@@ -153,6 +185,15 @@ class SpfSolver::SpfSolverImpl {
       std::unordered_map<std::string, LinkState> const& areaLinkStates,
       PrefixState const& prefixState);
 
+  // Build unicast route for a single prefix using global prefix database and
+  // cached SPF computation from perspective of a given router.
+  // Returns std::nullopt if no route should be programmed for the prefix
+  std::optional<RibUnicastEntry> createRouteForPrefix(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      PrefixState const& prefixState,
+      thrift::IpPrefix const& prefix);
+
   // helpers used in best path calculation
   static std::pair<Metric, std::unordered_set<std::string>> getMinCostNodes(
       const SpfResult& spfResult, const std::set<std::string>& dstNodes);
@@ -165,10 +206,19 @@ class SpfSolver::SpfSolverImpl {
   SpfSolverImpl(SpfSolverImpl const&) = delete;
   SpfSolverImpl& operator=(SpfSolverImpl const&) = delete;
 
+  // Compute unicast routes of all prefixes into routeDb by sharding prefixes
+  // across routeBuildPool_. Each shard fills its own DecisionRouteDb fragment
+  // which are merged at the end.
+  void buildUnicastRoutesSharded(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      PrefixState const& prefixState,
+      size_t numShards,
+      DecisionRouteDb& routeDb);
+
   // Given prefixes and the nodes who announce it, get the ecmp routes.
-  // emplace unicastEntry into unicastEntries if valid ecmp exists
-  void selectEcmpOpenr(
-      std::unordered_map<thrift::IpPrefix, RibUnicastEntry>& unicastEntries,
+  // Returns std::nullopt if no valid ecmp exists
+  std::optional<RibUnicastEntry> selectEcmpOpenr(
       std::string const& myNodeName,
       thrift::IpPrefix const& prefix,
       thrift::PrefixEntries const& prefixEntries,
@@ -176,9 +226,8 @@ class SpfSolver::SpfSolverImpl {
       std::unordered_map<std::string, LinkState> const& areaLinkStates);
 
   // Given bgp prefixes and the nodes who announce it, get the ecmp routes.
-  // emplace unicastEntry into unicastEntries if valid ecmp exists
-  void selectEcmpBgp(
-      std::unordered_map<thrift::IpPrefix, RibUnicastEntry>& unicastEntries,
+  // Returns std::nullopt if no valid ecmp exists
+  std::optional<RibUnicastEntry> selectEcmpBgp(
       std::string const& myNodeName,
       thrift::IpPrefix const& prefix,
       thrift::PrefixEntries const& prefixEntries,
@@ -187,8 +236,7 @@ class SpfSolver::SpfSolverImpl {
       PrefixState const& prefixState);
 
   // Given prefixes and the nodes who announce it, get the kspf routes.
-  void selectKsp2(
-      std::unordered_map<thrift::IpPrefix, RibUnicastEntry>& unicastEntries,
+  std::optional<RibUnicastEntry> selectKsp2(
       const thrift::IpPrefix& prefix,
       const string& myNodeName,
       BestPathCalResult const& bestPathCalResult,
@@ -270,6 +318,10 @@ class SpfSolver::SpfSolverImpl {
 
   // Use IGP metric in metric vector comparision
   const bool bgpUseIgpMetric_{false};
+
+  // worker pool for sharding per-prefix route selection in buildRouteDb().
+  // Not set if route build runs inline
+  std::unique_ptr<folly::CPUThreadPoolExecutor> routeBuildPool_;
 };
 
 bool
@@ -310,107 +362,23 @@ SpfSolver::SpfSolverImpl::buildRouteDb(
   // Calculate unicast route best paths: IP and IP2MPLS routes
   //
 
-  for (const auto& [prefix, prefixEntries] : prefixState.prefixes()) {
-    bool hasBGP = false, hasNonBGP = false, missingMv = false;
-
-    for (auto const& [node, areaToPrefixEntries] : prefixEntries) {
-      for (auto const& [area, prefixEntry] : areaToPrefixEntries) {
-        bool isBGP = prefixEntry.type == thrift::PrefixType::BGP;
-        hasBGP |= isBGP;
-        hasNonBGP |= !isBGP;
-        if (isBGP and not prefixEntry.mv_ref().has_value()) {
-          missingMv = true;
-          LOG(ERROR) << "Prefix entry for prefix "
-                     << toString(prefixEntry.prefix) << " advertised by "
-                     << node << ", area " << area
-                     << " is of type BGP but does not contain a metric vector.";
-        }
-      }
-    }
-    // skip adding route for BGP prefixes that have issues
-    if (hasBGP) {
-      if (hasNonBGP) {
-        LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
-                   << " which is advertised with BGP and non-BGP type.";
-        fb303::fbData->addStatValue(
-            "decision.skipped_unicast_route", 1, fb303::COUNT);
-        continue;
-      }
-      if (missingMv) {
-        LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
-                   << " at least one advertiser is missing its metric vector.";
-        fb303::fbData->addStatValue(
-            "decision.skipped_unicast_route", 1, fb303::COUNT);
-        continue;
-      }
-    }
-
-    // skip adding route for prefixes advertised by this node
-    if (prefixEntries.count(myNodeName) and not hasBGP) {
-      continue;
-    }
-
-    // Check for enabledV4_
-    auto prefixStr = prefix.prefixAddress.addr;
-    bool isV4Prefix = prefixStr.size() == folly::IPAddressV4::byteCount();
-    if (isV4Prefix && !enableV4_) {
-      LOG(WARNING) << "Received v4 prefix while v4 is not enabled.";
-      fb303::fbData->addStatValue(
-          "decision.skipped_unicast_route", 1, fb303::COUNT);
-      continue;
-    }
-
-    const auto& prefixForwardingAlgo =
-        getPrefixForwardingAlgorithm(prefixEntries);
-    const auto& prefixForwardingType = getPrefixForwardingType(prefixEntries);
-
-    // MPLS for SP_ECMP / KSP2_ED_ECMP
-    if (prefixForwardingType == thrift::PrefixForwardingType::SR_MPLS) {
-      const auto nodes = getBestAnnouncingNodes(
-          myNodeName, prefix, prefixEntries, hasBGP, true, areaLinkStates);
-      if (not nodes.success or nodes.nodes.size() == 0) {
-        continue;
-      }
-      selectKsp2(
-          routeDb.unicastEntries,
-          prefix,
-          myNodeName,
-          nodes,
-          prefixEntries,
-          hasBGP,
-          areaLinkStates,
-          prefixState,
-          prefixForwardingAlgo);
-    }
-    // IP for SP_ECMP, KSP2_ED_ECMP is not supported in IP routing
-    else {
-      if (prefixForwardingAlgo == thrift::PrefixForwardingAlgorithm::SP_ECMP) {
-        if (hasBGP) {
-          selectEcmpBgp(
-              routeDb.unicastEntries,
-              myNodeName,
-              prefix,
-              prefixEntries,
-              isV4Prefix,
-              areaLinkStates,
-              prefixState);
-        } else {
-          selectEcmpOpenr(
-              routeDb.unicastEntries,
-              myNodeName,
-              prefix,
-              prefixEntries,
-              isV4Prefix,
-              areaLinkStates);
-        }
-      } else {
-        LOG(ERROR) << "prefix not supported: " << toString(prefix);
-        fb303::fbData->addStatValue(
-            "decision.incompatible_forwarding_type", 1, fb303::COUNT);
+  auto const& prefixes = prefixState.prefixes();
+  const size_t numShards = routeBuildPool_
+      ? std::min(
+            routeBuildPool_->numThreads(),
+            prefixes.size() / Constants::kMinPrefixesPerRouteBuildShard)
+      : 0;
+  if (numShards > 1) {
+    buildUnicastRoutesSharded(
+        myNodeName, areaLinkStates, prefixState, numShards, routeDb);
+  } else {
+    for (const auto& [prefix, _] : prefixes) {
+      if (auto maybeEntry = createRouteForPrefix(
+              myNodeName, areaLinkStates, prefixState, prefix)) {
+        routeDb.unicastEntries.emplace(prefix, std::move(maybeEntry).value());
       }
-    }
-
-  } // for prefixState.prefixes()
+    } // for prefixState.prefixes()
+  }
 
   //
   // Create MPLS routes for all nodeLabel
@@ -541,6 +509,163 @@ SpfSolver::SpfSolverImpl::buildRouteDb(
   return routeDb;
 } // buildRouteDb
 
+void
+SpfSolver::SpfSolverImpl::buildUnicastRoutesSharded(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    PrefixState const& prefixState,
+    size_t numShards,
+    DecisionRouteDb& routeDb) {
+  CHECK(routeBuildPool_);
+
+  // Warm up SPF results every prefix is going to look up. LinkState caches
+  // are safe for concurrent readers, this merely avoids all workers racing to
+  // compute the same SPF results.
+  for (auto const& [_, linkState] : areaLinkStates) {
+    linkState.getSpfResult(myNodeName);
+    if (computeLfaPaths_) {
+      for (auto const& link : linkState.linksFromNode(myNodeName)) {
+        linkState.getSpfResult(link->getOtherNodeName(myNodeName));
+      }
+    }
+  }
+
+  std::vector<thrift::IpPrefix const*> prefixes;
+  prefixes.reserve(prefixState.prefixes().size());
+  for (auto const& [prefix, _] : prefixState.prefixes()) {
+    prefixes.emplace_back(&prefix);
+  }
+
+  std::vector<folly::Future<DecisionRouteDb>> shardFutures;
+  shardFutures.reserve(numShards);
+  const size_t shardSize = (prefixes.size() + numShards - 1) / numShards;
+  for (size_t begin = 0; begin < prefixes.size(); begin += shardSize) {
+    const size_t end = std::min(begin + shardSize, prefixes.size());
+    shardFutures.emplace_back(
+        folly::via(routeBuildPool_.get(), [&, begin, end]() {
+          DecisionRouteDb shardRouteDb;
+          for (size_t i = begin; i < end; ++i) {
+            auto const& prefix = *prefixes[i];
+            if (auto maybeEntry = createRouteForPrefix(
+                    myNodeName, areaLinkStates, prefixState, prefix)) {
+              shardRouteDb.unicastEntries.emplace(
+                  prefix, std::move(maybeEntry).value());
+            }
+          }
+          return shardRouteDb;
+        }));
+  }
+
+  // wait for all shards. Prefixes are disjoint across shards
+  for (auto& shardRouteDb : folly::collect(std::move(shardFutures)).get()) {
+    routeDb.unicastEntries.merge(shardRouteDb.unicastEntries);
+  }
+}
+
+std::optional<RibUnicastEntry>
+SpfSolver::SpfSolverImpl::createRouteForPrefix(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    PrefixState const& prefixState,
+    thrift::IpPrefix const& prefix) {
+  // Prefix has been withdrawn by all of its advertisers
+  auto prefixIt = prefixState.prefixes().find(prefix);
+  if (prefixIt == prefixState.prefixes().end()) {
+    return std::nullopt;
+  }
+  auto const& prefixEntries = prefixIt->second;
+
+  bool hasBGP = false, hasNonBGP = false, missingMv = false;
+
+  for (auto const& [node, areaToPrefixEntries] : prefixEntries) {
+    for (auto const& [area, prefixEntry] : areaToPrefixEntries) {
+      bool isBGP = prefixEntry.type == thrift::PrefixType::BGP;
+      hasBGP |= isBGP;
+      hasNonBGP |= !isBGP;
+      if (isBGP and not prefixEntry.mv_ref().has_value()) {
+        missingMv = true;
+        LOG(ERROR) << "Prefix entry for prefix " << toString(prefixEntry.prefix)
+                   << " advertised by " << node << ", area " << area
+                   << " is of type BGP but does not contain a metric vector.";
+      }
+    }
+  }
+  // skip adding route for BGP prefixes that have issues
+  if (hasBGP) {
+    if (hasNonBGP) {
+      LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
+                 << " which is advertised with BGP and non-BGP type.";
+      fb303::fbData->addStatValue(
+          "decision.skipped_unicast_route", 1, fb303::COUNT);
+      return std::nullopt;
+    }
+    if (missingMv) {
+      LOG(ERROR) << "Skipping route for prefix " << toString(prefix)
+                 << " at least one advertiser is missing its metric vector.";
+      fb303::fbData->addStatValue(
+          "decision.skipped_unicast_route", 1, fb303::COUNT);
+      return std::nullopt;
+    }
+  }
+
+  // skip adding route for prefixes advertised by this node
+  if (prefixEntries.count(myNodeName) and not hasBGP) {
+    return std::nullopt;
+  }
+
+  // Check for enabledV4_
+  auto prefixStr = prefix.prefixAddress.addr;
+  bool isV4Prefix = prefixStr.size() == folly::IPAddressV4::byteCount();
+  if (isV4Prefix && !enableV4_) {
+    LOG(WARNING) << "Received v4 prefix while v4 is not enabled.";
+    fb303::fbData->addStatValue(
+        "decision.skipped_unicast_route", 1, fb303::COUNT);
+    return std::nullopt;
+  }
+
+  const auto& prefixForwardingAlgo =
+      getPrefixForwardingAlgorithm(prefixEntries);
+  const auto& prefixForwardingType = getPrefixForwardingType(prefixEntries);
+
+  // MPLS for SP_ECMP / KSP2_ED_ECMP
+  if (prefixForwardingType == thrift::PrefixForwardingType::SR_MPLS) {
+    const auto nodes = getBestAnnouncingNodes(
+        myNodeName, prefix, prefixEntries, hasBGP, true, areaLinkStates);
+    if (not nodes.success or nodes.nodes.size() == 0) {
+      return std::nullopt;
+    }
+    return selectKsp2(
+        prefix,
+        myNodeName,
+        nodes,
+        prefixEntries,
+        hasBGP,
+        areaLinkStates,
+        prefixState,
+        prefixForwardingAlgo);
+  }
+
+  // IP for SP_ECMP, KSP2_ED_ECMP is not supported in IP routing
+  if (prefixForwardingAlgo == thrift::PrefixForwardingAlgorithm::SP_ECMP) {
+    if (hasBGP) {
+      return selectEcmpBgp(
+          myNodeName,
+          prefix,
+          prefixEntries,
+          isV4Prefix,
+          areaLinkStates,
+          prefixState);
+    }
+    return selectEcmpOpenr(
+        myNodeName, prefix, prefixEntries, isV4Prefix, areaLinkStates);
+  }
+
+  LOG(ERROR) << "prefix not supported: " << toString(prefix);
+  fb303::fbData->addStatValue(
+      "decision.incompatible_forwarding_type", 1, fb303::COUNT);
+  return std::nullopt;
+}
+
 BestPathCalResult
 SpfSolver::SpfSolverImpl::getBestAnnouncingNodes(
     std::string const& myNodeName,
@@ -665,9 +790,8 @@ SpfSolver::SpfSolverImpl::maybeFilterDrainedNodes(
   return filtered.nodes.empty() ? result : filtered;
 }
 
-void
+std::optional<RibUnicastEntry>
 SpfSolver::SpfSolverImpl::selectEcmpOpenr(
-    std::unordered_map<thrift::IpPrefix, RibUnicastEntry>& unicastEntries,
     std::string const& myNodeName,
     thrift::IpPrefix const& prefix,
     thrift::PrefixEntries const& prefixEntries,
@@ -677,7 +801,7 @@ SpfSolver::SpfSolverImpl::selectEcmpOpenr(
   const auto& ret = getBestAnnouncingNodes(
       myNodeName, prefix, prefixEntries, false, false, areaLinkStates);
   if (not ret.success) {
-    return;
+    return std::nullopt;
   }
 
   std::set<std::string> prefixNodes = ret.nodes;
@@ -691,10 +815,10 @@ SpfSolver::SpfSolverImpl::selectEcmpOpenr(
     LOG(WARNING) << "No route to prefix " << toString(prefix)
                  << ", advertised by: " << folly::join(", ", prefixNodes);
     fb303::fbData->addStatValue("decision.no_route_to_prefix", 1, fb303::COUNT);
-    return;
+    return std::nullopt;
   }
 
-  RibUnicastEntry entry(
+  return RibUnicastEntry(
       toIPNetwork(prefix), // prefix
       getNextHopsThrift(
           myNodeName,
@@ -708,7 +832,6 @@ SpfSolver::SpfSolverImpl::selectEcmpOpenr(
           ret.areas), // nexthops
       prefixEntries.at(ret.bestNode).at(ret.bestArea), // bestPrefixEntry
       ret.bestArea); // bestArea
-  unicastEntries.emplace(prefix, std::move(entry));
 }
 
 BestPathCalResult
@@ -799,9 +922,8 @@ SpfSolver::SpfSolverImpl::runBestPathSelectionBgp(
   return maybeFilterDrainedNodes(std::move(ret), areaLinkStates);
 }
 
-void
+std::optional<RibUnicastEntry>
 SpfSolver::SpfSolverImpl::selectEcmpBgp(
-    std::unordered_map<thrift::IpPrefix, RibUnicastEntry>& unicastEntries,
     std::string const& myNodeName,
     thrift::IpPrefix const& prefix,
     thrift::PrefixEntries const& prefixEntries,
@@ -816,7 +938,7 @@ SpfSolver::SpfSolverImpl::selectEcmpBgp(
   const auto dstInfo = getBestAnnouncingNodes(
       myNodeName, prefix, prefixEntries, true, false, areaLinkStates);
   if (not dstInfo.success) {
-    return;
+    return std::nullopt;
   }
 
   if (dstInfo.nodes.empty() or dstInfo.nodes.count(myNodeName)) {
@@ -827,7 +949,7 @@ SpfSolver::SpfSolverImpl::selectEcmpBgp(
       fb303::fbData->addStatValue(
           "decision.no_route_to_prefix", 1, fb303::COUNT);
     }
-    return;
+    return std::nullopt;
   }
 
   auto bestNextHop = prefixState.getLoopbackVias(
@@ -837,13 +959,13 @@ SpfSolver::SpfSolverImpl::selectEcmpBgp(
         "decision.missing_loopback_addr", 1, fb303::SUM);
     LOG(ERROR) << "Cannot find the best paths loopback address. "
                << "Skipping route for prefix: " << toString(prefix);
-    return;
+    return std::nullopt;
   }
 
   const auto nextHopsWithMetric =
       getNextHopsWithMetric(myNodeName, dstInfo.nodes, false, areaLinkStates);
 
-  RibUnicastEntry entry(
+  return RibUnicastEntry(
       toIPNetwork(prefix),
       getNextHopsThrift(
           myNodeName,
@@ -861,8 +983,6 @@ SpfSolver::SpfSolverImpl::selectEcmpBgp(
       bgpDryRun_, // doNotInstall
       bestNextHop.at(0) // bestNexthop
   );
-
-  unicastEntries.emplace(prefix, std::move(entry));
 }
 
 std::optional<DecisionRouteUpdate>
@@ -906,9 +1026,8 @@ SpfSolver::SpfSolverImpl::processStaticRouteUpdates() {
   return ret;
 }
 
-void
+std::optional<RibUnicastEntry>
 SpfSolver::SpfSolverImpl::selectKsp2(
-    std::unordered_map<thrift::IpPrefix, RibUnicastEntry>& unicastEntries,
     const thrift::IpPrefix& prefix,
     const string& myNodeName,
     BestPathCalResult const& bestPathCalResult,
@@ -964,7 +1083,7 @@ SpfSolver::SpfSolverImpl::selectKsp2(
   }
 
   if (paths.size() == 0) {
-    return;
+    return std::nullopt;
   }
 
   for (const auto& path : paths) {
@@ -1047,7 +1166,7 @@ SpfSolver::SpfSolverImpl::selectKsp2(
     LOG(WARNING) << "Dropping routes to " << toString(prefix) << " because of "
                  << dynamicNextHop << " of nexthops is smaller than "
                  << minNextHop.value();
-    return;
+    return std::nullopt;
   }
 
   if (hasBgp) {
@@ -1062,7 +1181,7 @@ SpfSolver::SpfSolverImpl::selectKsp2(
       entry.doNotInstall = bgpDryRun_;
     }
   }
-  unicastEntries.emplace(prefix, std::move(entry));
+  return entry;
 }
 
 std::pair<Metric, std::unordered_set<std::string>>
@@ -1280,14 +1399,16 @@ SpfSolver::SpfSolver(
     bool computeLfaPaths,
     bool enableOrderedFib,
     bool bgpDryRun,
-    bool bgpUseIgpMetric)
+    bool bgpUseIgpMetric,
+    size_t numRouteBuildThreads)
     : impl_(new SpfSolver::SpfSolverImpl(
           myNodeName,
           enableV4,
           computeLfaPaths,
           enableOrderedFib,
           bgpDryRun,
-          bgpUseIgpMetric)) {}
+          bgpUseIgpMetric,
+          numRouteBuildThreads)) {}
 
 SpfSolver::~SpfSolver() {}
 
@@ -1315,6 +1436,16 @@ SpfSolver::buildRouteDb(
   return impl_->buildRouteDb(myNodeName, areaLinkStates, prefixState);
 }
 
+std::optional<RibUnicastEntry>
+SpfSolver::createRouteForPrefix(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    PrefixState const& prefixState,
+    thrift::IpPrefix const& prefix) {
+  return impl_->createRouteForPrefix(
+      myNodeName, areaLinkStates, prefixState, prefix);
+}
+
 std::optional<DecisionRouteUpdate>
 SpfSolver::processStaticRouteUpdates() {
   return impl_->processStaticRouteUpdates();
@@ -1330,7 +1461,7 @@ Decision::Decision(
     bool bgpDryRun,
     std::chrono::milliseconds debounceMinDur,
     std::chrono::milliseconds debounceMaxDur,
-    messaging::RQueue<thrift::Publication> kvStoreUpdatesQueue,
+    messaging::SharedRQueue<thrift::Publication> kvStoreUpdatesQueue,
     messaging::RQueue<thrift::RouteDatabaseDelta> staticRoutesUpdateQueue,
     messaging::ReplicateQueue<DecisionRouteUpdate>& routeUpdatesQueue)
     : config_(config),
@@ -1342,13 +1473,25 @@ Decision::Decision(
             rebuildRoutes("DECISION_DEBOUNCE");
           }) {
   auto tConfig = config->getConfig();
+
+  // Depth and queueing delay of KvStore updates per read
+  fb303::fbData->addHistogram(
+      "decision.kvstore_updates_queue_depth", 10, 0, 1000);
+  fb303::fbData->exportHistogramPercentile(
+      "decision.kvstore_updates_queue_depth", 50, 95, 99);
+  fb303::fbData->addHistogram(
+      "decision.kvstore_updates_wait_us", 1000, 0, 100000);
+  fb303::fbData->exportHistogramPercentile(
+      "decision.kvstore_updates_wait_us", 50, 95, 99);
+
   spfSolver_ = std::make_unique<SpfSolver>(
       tConfig.node_name,
       tConfig.enable_v4_ref().value_or(false),
       computeLfaPaths,
       tConfig.enable_ordered_fib_programming_ref().value_or(false),
       bgpDryRun,
-      tConfig.bgp_use_igp_metric_ref().value_or(false));
+      tConfig.bgp_use_igp_metric_ref().value_or(false),
+      tConfig.decision_route_build_threads);
 
   coldStartTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     pendingUpdates_.setNeedsFullRebuild();
@@ -1383,14 +1526,23 @@ Decision::Decision(
   addFiberTask([q = std::move(kvStoreUpdatesQueue), this]() mutable noexcept {
     LOG(INFO) << "Starting KvStore updates processing fiber";
     while (true) {
-      auto maybeThriftPub = q.get(); // perform read
-      VLOG(2) << "Received KvStore update";
-      if (maybeThriftPub.hasError()) {
+      // Drain all pending publications in one wakeup. Routes are rebuilt once
+      // for the whole batch
+      messaging::QueueReadStats readStats;
+      auto maybeThriftPubs = q.getAll(&readStats); // perform read
+      if (maybeThriftPubs.hasError()) {
         LOG(INFO) << "Terminating KvStore updates processing fiber";
         break;
       }
+      VLOG(2) << "Received " << maybeThriftPubs->size() << " KvStore updates";
+      fb303::fbData->addHistogramValue(
+          "decision.kvstore_updates_queue_depth", readStats.depth);
+      fb303::fbData->addHistogramValue(
+          "decision.kvstore_updates_wait_us", readStats.maxWaitTime.count());
       try {
-        processPublication(maybeThriftPub.value());
+        for (auto const& thriftPub : maybeThriftPubs.value()) {
+          processPublication(*thriftPub);
+        }
       } catch (const std::exception& e) {
 #if FOLLY_USE_SYMBOLIZER
         // collect stack strace then fail the process
@@ -1628,13 +1780,68 @@ Decision::updateNodePrefixDatabase(
   return nodePrefixDb;
 }
 
+std::optional<thrift::AdjacencyDatabase>
+Decision::updateNodeAdjacencyDatabase(
+    const std::string& area,
+    const std::string& key,
+    std::optional<thrift::AdjacencyDatabase> adjDb) {
+  auto const nodeName = getNodeNameFromKey(key);
+  auto& areaNodeAdjacencies = nodeAdjacencies_[area];
+  auto& nodeAdjacencies = areaNodeAdjacencies[nodeName];
+
+  std::optional<thrift::PerfEvents> perfEvents;
+  if (adjDb.has_value()) {
+    perfEvents = castToStd(adjDb->perfEvents_ref());
+  }
+
+  if (isPerAdjacencyKey(key)) {
+    // empty database signifies withdraw of the adjacency
+    if (adjDb.has_value() and not adjDb->adjacencies.empty()) {
+      nodeAdjacencies.perAdjKeys[key] = std::move(adjDb->adjacencies.at(0));
+    } else {
+      nodeAdjacencies.perAdjKeys.erase(key);
+    }
+  } else {
+    nodeAdjacencies.fullDb = std::move(adjDb);
+  }
+
+  if (not nodeAdjacencies.fullDb.has_value() and
+      nodeAdjacencies.perAdjKeys.empty()) {
+    areaNodeAdjacencies.erase(nodeName);
+    return std::nullopt;
+  }
+
+  thrift::AdjacencyDatabase nodeAdjDb;
+  if (nodeAdjacencies.fullDb.has_value()) {
+    nodeAdjDb.thisNodeName = nodeAdjacencies.fullDb->thisNodeName;
+    nodeAdjDb.isOverloaded = nodeAdjacencies.fullDb->isOverloaded;
+    nodeAdjDb.nodeLabel = nodeAdjacencies.fullDb->nodeLabel;
+    for (auto const& adj : nodeAdjacencies.fullDb->adjacencies) {
+      if (nodeAdjacencies.perAdjKeys.empty() or
+          not nodeAdjacencies.perAdjKeys.count(getPerAdjacencyKey(
+              nodeName, adj.otherNodeName, adj.ifName))) {
+        nodeAdjDb.adjacencies.emplace_back(adj);
+      }
+    }
+  } else {
+    nodeAdjDb.thisNodeName = nodeName;
+  }
+  for (auto const& kv : nodeAdjacencies.perAdjKeys) {
+    nodeAdjDb.adjacencies.emplace_back(kv.second);
+  }
+  nodeAdjDb.area = area;
+  fromStdOptional(nodeAdjDb.perfEvents_ref(), perfEvents);
+  return nodeAdjDb;
+}
+
 void
 Decision::processPublication(thrift::Publication const& thriftPub) {
   CHECK(not thriftPub.area.empty());
   auto const& area = thriftPub.area;
 
   if (!areaLinkStates_.count(area)) {
-    areaLinkStates_.emplace(area, area);
+    areaLinkStates_.emplace(
+        area, LinkState(area, config_->isIncrementalSpfEnabled()));
   }
   auto& areaLinkState = areaLinkStates_.at(area);
 
@@ -1658,14 +1865,33 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
     }
 
     try {
-      if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
+      if (key.find(Constants::kAdjDbMarker.toString()) == 0 or
+          isPerAdjacencyKey(key)) {
         // update adjacencyDb
         auto adjacencyDb =
             fbzmq::util::readThriftObjStr<thrift::AdjacencyDatabase>(
                 rawVal.value_ref().value(), serializer_);
-        // TODO this sould come from KvStore.
-        adjacencyDb.area_ref() = area;
         CHECK_EQ(nodeName, adjacencyDb.thisNodeName);
+        if (isPerAdjacencyKey(key) and
+            not isValidPerAdjacencyDb(key, adjacencyDb)) {
+          LOG(ERROR) << "Skipping malformed per adjacency key " << key
+                     << " with " << adjacencyDb.adjacencies.size()
+                     << " adjacencies";
+          fb303::fbData->addStatValue(
+              "decision.invalid_per_adj_key", 1, fb303::COUNT);
+          continue;
+        }
+        auto maybeNodeAdjDb =
+            updateNodeAdjacencyDatabase(area, key, std::move(adjacencyDb));
+        if (not maybeNodeAdjDb.has_value()) {
+          pendingUpdates_.applyLinkStateChange(
+              nodeName,
+              areaLinkState.deleteAdjacencyDatabase(nodeName),
+              castToStd(thrift::PrefixDatabase().perfEvents_ref()));
+          continue;
+        }
+        // merged database of full and per adjacency keys of the node
+        adjacencyDb = std::move(maybeNodeAdjDb).value();
         LinkStateMetric holdUpTtl = 0, holdDownTtl = 0;
         if (config_->getConfig().enable_ordered_fib_programming_ref().value_or(
                 false)) {
@@ -1706,9 +1932,8 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
                 << " from area " << area;
         fb303::fbData->addStatValue(
             "decision.prefix_db_update", 1, fb303::COUNT);
-        pendingUpdates_.applyPrefixStateChange(
-            prefixState_.updatePrefixDatabase(nodePrefixDb)),
-            castToStd(nodePrefixDb.perfEvents_ref());
+        applyPrefixDatabase(
+            nodePrefixDb, castToStd(nodePrefixDb.perfEvents_ref()));
         continue;
       }
 
@@ -1733,7 +1958,18 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
   for (const auto& key : thriftPub.expiredKeys) {
     std::string nodeName = getNodeNameFromKey(key);
 
-    if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
+    if (key.find(Constants::kAdjDbMarker.toString()) == 0 or
+        isPerAdjacencyKey(key)) {
+      auto maybeNodeAdjDb =
+          updateNodeAdjacencyDatabase(area, key, std::nullopt);
+      if (maybeNodeAdjDb.has_value()) {
+        // node still has other adjacency keys alive
+        pendingUpdates_.applyLinkStateChange(
+            nodeName,
+            areaLinkState.updateAdjacencyDatabase(maybeNodeAdjDb.value()),
+            castToStd(thrift::PrefixDatabase().perfEvents_ref()));
+        continue;
+      }
       pendingUpdates_.applyLinkStateChange(
           nodeName,
           areaLinkState.deleteAdjacencyDatabase(nodeName),
@@ -1755,13 +1991,37 @@ Decision::processPublication(thrift::Publication const& thriftPub) {
 
       // TODO - this should directly come from KvStore.
       nodePrefixDb.area = area;
-      pendingUpdates_.applyPrefixStateChange(
-          prefixState_.updatePrefixDatabase(nodePrefixDb));
+      applyPrefixDatabase(nodePrefixDb);
       continue;
     }
   }
 }
 
+void
+Decision::applyPrefixDatabase(
+    thrift::PrefixDatabase const& nodePrefixDb,
+    std::optional<thrift::PerfEvents> const& perfEvents) {
+  auto const& nodeName = nodePrefixDb.thisNodeName;
+  auto const oldLoopbackV4 =
+      folly::get_optional(prefixState_.getNodeHostLoopbacksV4(), nodeName);
+  auto const oldLoopbackV6 =
+      folly::get_optional(prefixState_.getNodeHostLoopbacksV6(), nodeName);
+
+  pendingUpdates_.applyPrefixStateChange(
+      prefixState_.updatePrefixDatabase(nodePrefixDb), perfEvents);
+
+  // BGP routes resolve their best nexthop via loopback address of the best
+  // node. Change of a loopback can affect routes of prefixes which are not
+  // reported as changed, hence rebuild all of them.
+  if (oldLoopbackV4 !=
+          folly::get_optional(prefixState_.getNodeHostLoopbacksV4(), nodeName) or
+      oldLoopbackV6 !=
+          folly::get_optional(
+              prefixState_.getNodeHostLoopbacksV6(), nodeName)) {
+    pendingUpdates_.setNeedsFullRebuild();
+  }
+}
+
 void
 Decision::pushRoutesDeltaUpdates(
     thrift::RouteDatabaseDelta& staticRoutesDelta) {
@@ -1796,16 +2056,20 @@ Decision::rebuildRoutes(std::string const& event) {
     }
   }
 
-  std::optional<DecisionRouteDb> maybeRouteDb = std::nullopt;
-  if (pendingUpdates_.needsRouteUpdate() || staticRoutesUpdated) {
+  std::optional<DecisionRouteUpdate> maybeRouteUpdate = std::nullopt;
+  if (pendingUpdates_.needsFullRebuild() || staticRoutesUpdated) {
     // if only static routes gets updated, we still need to update routes
     // because there maybe routes depended on static routes.
-    maybeRouteDb =
-        spfSolver_->buildRouteDb(myNodeName_, areaLinkStates_, prefixState_);
+    maybeRouteUpdate = buildFullRouteUpdate();
+  } else if (pendingUpdates_.needsRouteUpdate()) {
+    // only prefixes have changed, topology is intact. Recompute routes for
+    // changed prefixes against cached SPF results.
+    maybeRouteUpdate = buildIncrementalRouteUpdate();
   }
   pendingUpdates_.addEvent("ROUTE_UPDATE");
-  if (maybeRouteDb.has_value()) {
-    sendRouteUpdate(std::move(*maybeRouteDb), pendingUpdates_.moveOutEvents());
+  if (maybeRouteUpdate.has_value()) {
+    sendRouteUpdate(
+        std::move(*maybeRouteUpdate), pendingUpdates_.moveOutEvents());
   } else {
     LOG(WARNING) << "rebuildRoutes incurred no routes";
   }
@@ -1828,37 +2092,103 @@ Decision::decrementOrderedFibHolds() {
   return stillHasHolds;
 }
 
-void
-Decision::sendRouteUpdate(
-    DecisionRouteDb&& routeDb, std::optional<thrift::PerfEvents>&& perfEvents) {
+std::optional<DecisionRouteUpdate>
+Decision::buildFullRouteUpdate() {
+  auto maybeRouteDb =
+      spfSolver_->buildRouteDb(myNodeName_, areaLinkStates_, prefixState_);
+  if (not maybeRouteDb.has_value()) {
+    return std::nullopt;
+  }
+  auto& routeDb = maybeRouteDb.value();
+
   //
   // Apply RibPolicy to computed route db before sending out
   //
-  if (ribPolicy_ && ribPolicy_->isActive()) {
-    auto i = routeDb.unicastEntries.begin();
-    while (i != routeDb.unicastEntries.end()) {
-      auto& entry = i->second;
-      if (ribPolicy_->applyAction(entry)) {
-        VLOG(1) << "RibPolicy transformed the route "
-                << folly::IPAddress::networkToString(entry.prefix);
-      }
-      // Skip route if no valid next-hop
-      if (entry.nexthops.empty()) {
-        VLOG(1) << "Removing route for "
-                << folly::IPAddress::networkToString(entry.prefix)
-                << " because of no remaining valid next-hops";
-        i = routeDb.unicastEntries.erase(i);
-        continue;
-      }
-      ++i;
+  auto i = routeDb.unicastEntries.begin();
+  while (i != routeDb.unicastEntries.end()) {
+    if (not applyRibPolicy(i->second)) {
+      i = routeDb.unicastEntries.erase(i);
+      continue;
     }
+    ++i;
   }
 
   auto delta = getRouteDelta(routeDb, routeDb_);
 
   // update decision routeDb cache
   routeDb_ = std::move(routeDb);
+  return delta;
+}
+
+std::optional<DecisionRouteUpdate>
+Decision::buildIncrementalRouteUpdate() {
+  bool nodeExist{false};
+  for (const auto& [_, linkState] : areaLinkStates_) {
+    nodeExist |= linkState.hasNode(myNodeName_);
+  }
+  if (not nodeExist) {
+    return std::nullopt;
+  }
 
+  const auto startTime = std::chrono::steady_clock::now();
+  fb303::fbData->addStatValue("decision.route_build_runs", 1, fb303::COUNT);
+
+  DecisionRouteUpdate delta;
+  for (auto const& prefix : pendingUpdates_.updatedPrefixes()) {
+    auto maybeEntry = spfSolver_->createRouteForPrefix(
+        myNodeName_, areaLinkStates_, prefixState_, prefix);
+    if (maybeEntry.has_value() and not applyRibPolicy(*maybeEntry)) {
+      maybeEntry.reset();
+    }
+
+    auto const it = routeDb_.unicastEntries.find(prefix);
+    if (maybeEntry.has_value()) {
+      // new prefix, or prefix entry changed
+      if (it == routeDb_.unicastEntries.end() or
+          not(it->second == *maybeEntry)) {
+        delta.unicastRoutesToUpdate.emplace_back(std::move(*maybeEntry));
+      }
+    } else if (it != routeDb_.unicastEntries.end()) {
+      delta.unicastRoutesToDelete.emplace_back(toIPNetwork(prefix));
+    }
+  }
+
+  // update decision routeDb cache
+  routeDb_.update(delta);
+
+  auto deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTime);
+  VLOG(1) << "Decision::buildIncrementalRouteUpdate took " << deltaTime.count()
+          << "ms for " << pendingUpdates_.updatedPrefixes().size()
+          << " prefixes.";
+  fb303::fbData->addStatValue(
+      "decision.incremental_route_build_ms", deltaTime.count(), fb303::AVG);
+  return delta;
+}
+
+bool
+Decision::applyRibPolicy(RibUnicastEntry& entry) const {
+  if (not ribPolicy_ or not ribPolicy_->isActive()) {
+    return true;
+  }
+  if (ribPolicy_->applyAction(entry)) {
+    VLOG(1) << "RibPolicy transformed the route "
+            << folly::IPAddress::networkToString(entry.prefix);
+  }
+  // Skip route if no valid next-hop
+  if (entry.nexthops.empty()) {
+    VLOG(1) << "Removing route for "
+            << folly::IPAddress::networkToString(entry.prefix)
+            << " because of no remaining valid next-hops";
+    return false;
+  }
+  return true;
+}
+
+void
+Decision::sendRouteUpdate(
+    DecisionRouteUpdate&& delta,
+    std::optional<thrift::PerfEvents>&& perfEvents) {
   // publish the new route state to fib
   delta.perfEvents = perfEvents;
   routeUpdatesQueue_.push(std::move(delta));
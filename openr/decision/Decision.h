@@ -8,6 +8,7 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -71,6 +72,28 @@ struct DecisionRouteDb {
     }
     return tRouteDb;
   }
+
+  // Apply route delta in place. Used to keep the cached routeDb in sync when
+  // only a subset of routes is recomputed.
+  void
+  update(DecisionRouteUpdate const& delta) {
+    for (auto const& network : delta.unicastRoutesToDelete) {
+      unicastEntries.erase(toIpPrefix(network));
+    }
+    // NOTE: entries are not assignable (const key fields), hence erase first
+    for (auto const& entry : delta.unicastRoutesToUpdate) {
+      auto const prefix = toIpPrefix(entry.prefix);
+      unicastEntries.erase(prefix);
+      unicastEntries.emplace(prefix, entry);
+    }
+    for (auto const& label : delta.mplsRoutesToDelete) {
+      mplsEntries.erase(label);
+    }
+    for (auto const& entry : delta.mplsRoutesToUpdate) {
+      mplsEntries.erase(entry.label);
+      mplsEntries.emplace(entry.label, entry);
+    }
+  }
 };
 
 /*
@@ -219,7 +242,10 @@ class SpfSolver {
       bool computeLfaPaths,
       bool enableOrderedFib = false,
       bool bgpDryRun = false,
-      bool bgpUseIgpMetric = false);
+      bool bgpUseIgpMetric = false,
+      // number of worker threads to shard per-prefix route selection across.
+      // 0 or 1 means routes are computed inline by caller
+      size_t numRouteBuildThreads = 0);
   ~SpfSolver();
 
   //
@@ -243,6 +269,15 @@ class SpfSolver {
       std::unordered_map<std::string, LinkState> const& areaLinkStates,
       PrefixState const& prefixState);
 
+  // Build unicast route for a single prefix using cached SPF results. This is
+  // used to incrementally update routes when only prefixes have changed.
+  // Returns std::nullopt if no route should be programmed for the prefix
+  std::optional<RibUnicastEntry> createRouteForPrefix(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      PrefixState const& prefixState,
+      thrift::IpPrefix const& prefix);
+
  private:
   // no-copy
   SpfSolver(SpfSolver const&) = delete;
@@ -278,7 +313,7 @@ class Decision : public OpenrEventBase {
       bool bgpDryRun,
       std::chrono::milliseconds debounceMinDur,
       std::chrono::milliseconds debounceMaxDur,
-      messaging::RQueue<thrift::Publication> kvStoreUpdatesQueue,
+      messaging::SharedRQueue<thrift::Publication> kvStoreUpdatesQueue,
       messaging::RQueue<thrift::RouteDatabaseDelta> staticRoutesUpdateQueue,
       messaging::ReplicateQueue<DecisionRouteUpdate>& routeUpdatesQueue);
 
@@ -354,16 +389,43 @@ class Decision : public OpenrEventBase {
   // linkstate has remaining holds
   bool decrementOrderedFibHolds();
 
+  // Rebuild all routes and return delta against cached routeDb_. Returns
+  // std::nullopt if this node doesn't have any adjacency database yet.
+  std::optional<DecisionRouteUpdate> buildFullRouteUpdate();
+
+  // Recompute routes only for prefixes updated in pendingUpdates_, reusing
+  // cached SPF results, and return delta against cached routeDb_.
+  std::optional<DecisionRouteUpdate> buildIncrementalRouteUpdate();
+
+  // Apply RibPolicy (if active) on the route. Returns false if route is left
+  // with no valid next-hop and must not be programmed.
+  bool applyRibPolicy(RibUnicastEntry& entry) const;
+
+  // Attach perf events to route delta and publish it to Fib
   void sendRouteUpdate(
-      DecisionRouteDb&& routeDb,
+      DecisionRouteUpdate&& delta,
       std::optional<thrift::PerfEvents>&& perfEvents);
 
+  // Apply node prefix database on prefixState_ and record changed prefixes
+  // in pendingUpdates_
+  void applyPrefixDatabase(
+      thrift::PrefixDatabase const& nodePrefixDb,
+      std::optional<thrift::PerfEvents> const& perfEvents = std::nullopt);
+
   std::chrono::milliseconds getMaxFib();
 
   // node to prefix entries database for nodes advertising per prefix keys
   std::optional<thrift::PrefixDatabase> updateNodePrefixDatabase(
       const std::string& key, const thrift::PrefixDatabase& prefixDb);
 
+  // merge adjacencies of the node advertised with full `adj:<node>` key and
+  // per adjacency keys. `adjDb` is std::nullopt for expired key. Returns
+  // std::nullopt if node has no adjacency key left in the area
+  std::optional<thrift::AdjacencyDatabase> updateNodeAdjacencyDatabase(
+      const std::string& area,
+      const std::string& key,
+      std::optional<thrift::AdjacencyDatabase> adjDb);
+
   // cached routeDb
   DecisionRouteDb routeDb_;
 
@@ -411,6 +473,17 @@ class Decision : public OpenrEventBase {
       std::unordered_map<thrift::IpPrefix, thrift::PrefixEntry>>
       perPrefixPrefixEntries_, fullDbPrefixEntries_;
 
+  // adjacency keys of a node. Per adjacency keys take precedence over entries
+  // of the full database for the same neighbor and interface
+  struct NodeAdjacencies {
+    std::optional<thrift::AdjacencyDatabase> fullDb;
+    std::unordered_map<std::string /* key */, thrift::Adjacency> perAdjKeys;
+  };
+  std::unordered_map<
+      std::string /* area */,
+      std::unordered_map<std::string /* node */, NodeAdjacencies>>
+      nodeAdjacencies_;
+
   // this node's name and the key markers
   const std::string myNodeName_;
 
@@ -9,6 +9,11 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <shared_mutex>
 #include <utility>
 
 #include <fb303/ServiceData.h>
@@ -376,7 +381,8 @@ Link::directionalToString(const std::string& fromNode) const {
       getIfaceFromNode(getOtherNodeName(fromNode)));
 }
 
-LinkState::LinkState(const std::string& area) : area_(area) {}
+LinkState::LinkState(const std::string& area, bool enableIncrementalSpf)
+    : area_(area), enableIncrementalSpf_(enableIncrementalSpf) {}
 
 size_t
 LinkState::LinkPtrHash::operator()(const std::shared_ptr<Link>& l) const {
@@ -507,6 +513,7 @@ LinkState::decrementHolds() {
     change.topologyChanged |= kv.second.decrementTtl();
   }
   if (change.topologyChanged) {
+    spfGraph_.reset();
     spfResults_.clear();
     kthPathResults_.clear();
   }
@@ -593,12 +600,12 @@ LinkState::updateAdjacencyDatabase(
   auto oldLinks = orderedLinksFromNode(nodeName);
   auto newLinks = getOrderedLinkSet(newAdjacencyDb);
 
-  // fill these sets with the appropriate links
-  std::unordered_set<Link> linksUp;
-  std::unordered_set<Link> linksDown;
+  // links which went up/down or whose metric changed
+  std::vector<std::shared_ptr<Link>> changedLinks;
 
-  change.topologyChanged |= updateNodeOverloaded(
+  const bool nodeOverloadChanged = updateNodeOverloaded(
       nodeName, newAdjacencyDb.isOverloaded, holdUpTtl, holdDownTtl);
+  change.topologyChanged |= nodeOverloadChanged;
 
   change.nodeLabelChanged =
       priorAdjacencyDb.nodeLabel != newAdjacencyDb.nodeLabel;
@@ -611,7 +618,10 @@ LinkState::updateAdjacencyDatabase(
       // newIter is pointing at a Link not currently present, record this as a
       // link to add and advance newIter
       (*newIter)->setHoldUpTtl(holdUpTtl);
-      change.topologyChanged |= (*newIter)->isUp();
+      if ((*newIter)->isUp()) {
+        change.topologyChanged = true;
+        changedLinks.emplace_back(*newIter);
+      }
       // even if we are holding a change, we apply the change to our link state
       // and check for holds when running spf. this ensures we don't add the
       // same hold twice
@@ -626,7 +636,10 @@ LinkState::updateAdjacencyDatabase(
       // as a link to remove and advance oldIter.
       // If this link was previously overloaded or had a hold up, this does not
       // change the topology.
-      change.topologyChanged |= (*oldIter)->isUp();
+      if ((*oldIter)->isUp()) {
+        change.topologyChanged = true;
+        changedLinks.emplace_back(*oldIter);
+      }
       removeLink(*oldIter);
       VLOG(1) << "removeLink " << (*oldIter)->toString();
       ++oldIter;
@@ -646,11 +659,14 @@ LinkState::updateAdjacencyDatabase(
           newLink.directionalToString(nodeName),
           oldLink.getMetricFromNode(nodeName),
           newLink.getMetricFromNode(nodeName));
-      change.topologyChanged |= oldLink.setMetricFromNode(
-          nodeName,
-          newLink.getMetricFromNode(nodeName),
-          holdUpTtl,
-          holdDownTtl);
+      if (oldLink.setMetricFromNode(
+              nodeName,
+              newLink.getMetricFromNode(nodeName),
+              holdUpTtl,
+              holdDownTtl)) {
+        change.topologyChanged = true;
+        changedLinks.emplace_back(*oldIter);
+      }
     }
 
     if (newLink.getOverloadFromNode(nodeName) !=
@@ -660,11 +676,14 @@ LinkState::updateAdjacencyDatabase(
           newLink.directionalToString(nodeName),
           oldLink.getOverloadFromNode(nodeName),
           newLink.getOverloadFromNode(nodeName));
-      change.topologyChanged |= oldLink.setOverloadFromNode(
-          nodeName,
-          newLink.getOverloadFromNode(nodeName),
-          holdUpTtl,
-          holdDownTtl);
+      if (oldLink.setOverloadFromNode(
+              nodeName,
+              newLink.getOverloadFromNode(nodeName),
+              holdUpTtl,
+              holdDownTtl)) {
+        change.topologyChanged = true;
+        changedLinks.emplace_back(*oldIter);
+      }
     }
 
     // Check if adjacency label has changed
@@ -710,8 +729,9 @@ LinkState::updateAdjacencyDatabase(
     ++oldIter;
   }
   if (change.topologyChanged) {
-    spfResults_.clear();
-    kthPathResults_.clear();
+    // node overload changes transit property of all links of the node, don't
+    // bother repairing SPF results in this case
+    updateSpfResults(changedLinks, not nodeOverloadChanged);
   }
   return change;
 }
@@ -723,10 +743,15 @@ LinkState::deleteAdjacencyDatabase(const std::string& nodeName) {
   auto search = adjacencyDatabases_.find(nodeName);
 
   if (search != adjacencyDatabases_.end()) {
+    std::vector<std::shared_ptr<Link>> changedLinks;
+    for (auto const& link : linksFromNode(nodeName)) {
+      if (link->isUp()) {
+        changedLinks.emplace_back(link);
+      }
+    }
     removeNode(nodeName);
     adjacencyDatabases_.erase(search);
-    spfResults_.clear();
-    kthPathResults_.clear();
+    updateSpfResults(changedLinks, true);
     change.topologyChanged = true;
   } else {
     LOG(WARNING) << "Trying to delete adjacency db for nonexisting node "
@@ -762,46 +787,374 @@ LinkState::getKthPaths(
     const std::string& src, const std::string& dest, size_t k) const {
   CHECK_GE(k, 1);
   std::tuple<std::string, std::string, size_t> key(src, dest, k);
-  auto entryIter = kthPathResults_.find(key);
-  if (kthPathResults_.end() == entryIter) {
-    LinkSet linksToIgnore;
-    for (size_t i = 1; i < k; ++i) {
-      for (auto const& path : getKthPaths(src, dest, i)) {
-        for (auto const& link : path) {
-          linksToIgnore.insert(link);
-        }
-      }
+  {
+    std::shared_lock<folly::SharedMutex> lock(*memoizationLock_);
+    auto entryIter = kthPathResults_.find(key);
+    if (kthPathResults_.end() != entryIter) {
+      return entryIter->second;
     }
-    std::vector<LinkState::Path> paths;
-    auto const& res = linksToIgnore.empty() ? getSpfResult(src, true)
-                                            : runSpf(src, true, linksToIgnore);
-    if (res.count(dest)) {
-      LinkSet visitedLinks;
-      auto path = traceOnePath(src, dest, res, visitedLinks);
-      while (path && !path->empty()) {
-        paths.push_back(std::move(*path));
-        path = traceOnePath(src, dest, res, visitedLinks);
+  }
+  // compute without holding the lock. concurrent callers may compute the same
+  // paths, first one to finish wins
+  LinkSet linksToIgnore;
+  for (size_t i = 1; i < k; ++i) {
+    for (auto const& path : getKthPaths(src, dest, i)) {
+      for (auto const& link : path) {
+        linksToIgnore.insert(link);
       }
     }
-    entryIter = kthPathResults_.emplace(key, std::move(paths)).first;
   }
-  return entryIter->second;
+  std::vector<LinkState::Path> paths;
+  auto const& res = linksToIgnore.empty()
+      ? getSpfResult(src, true)
+      : runSpfToNode(src, dest, linksToIgnore);
+  if (res.count(dest)) {
+    LinkSet visitedLinks;
+    auto path = traceOnePath(src, dest, res, visitedLinks);
+    while (path && !path->empty()) {
+      paths.push_back(std::move(*path));
+      path = traceOnePath(src, dest, res, visitedLinks);
+    }
+  }
+  std::unique_lock<folly::SharedMutex> lock(*memoizationLock_);
+  return kthPathResults_.emplace(std::move(key), std::move(paths))
+      .first->second;
 }
 
 LinkState::SpfResult const&
 LinkState::getSpfResult(
     const std::string& thisNodeName, bool useLinkMetric) const {
   std::pair<std::string, bool> key{thisNodeName, useLinkMetric};
-  auto entryIter = spfResults_.find(key);
-  if (spfResults_.end() == entryIter) {
-    auto res = runSpf(thisNodeName, useLinkMetric);
-    entryIter = spfResults_.emplace(std::move(key), std::move(res)).first;
+  {
+    std::shared_lock<folly::SharedMutex> lock(*memoizationLock_);
+    auto entryIter = spfResults_.find(key);
+    if (spfResults_.end() != entryIter) {
+      return entryIter->second;
+    }
+  }
+  // see getKthPaths() for concurrent access
+  auto res = runSpf(thisNodeName, useLinkMetric);
+  std::unique_lock<folly::SharedMutex> lock(*memoizationLock_);
+  return spfResults_.emplace(std::move(key), std::move(res)).first->second;
+}
+
+void
+LinkState::updateSpfResults(
+    std::vector<std::shared_ptr<Link>> const& changedLinks, bool canRepair) {
+  spfGraph_.reset();
+  kthPathResults_.clear();
+  if (not enableIncrementalSpf_ or not canRepair) {
+    spfResults_.clear();
+    return;
+  }
+  for (auto& [key, result] : spfResults_) {
+    updateSpfResult(key.first, key.second, changedLinks, result);
   }
-  return entryIter->second;
+}
+
+/**
+ * Incrementally repair shortest-path result of src after changedLinks went
+ * up/down or changed metric. This follows the dynamic SPF approach of
+ * Ramalingam-Reps with the following steps
+ *
+ * 1) Nodes which used any of changed links on their shortest paths, along
+ *    with their descendants in the shortest path DAG, may see their metric
+ *    increase. Their metric is recomputed with Dijkstra seeded from unaffected
+ *    neighbors.
+ * 2) Metric decreases are propagated from the changed links and recomputed
+ *    nodes, as in Dijkstra.
+ * 3) Path links and nexthops are rebuilt for nodes whose metric changed or
+ *    whose predecessors changed, in the same order as runSpf() extracts nodes
+ *    so that the result is identical to a full SPF run.
+ */
+void
+LinkState::updateSpfResult(
+    const std::string& src,
+    bool useLinkMetric,
+    std::vector<std::shared_ptr<Link>> const& changedLinks,
+    SpfResult& result) const {
+  fb303::fbData->addStatValue("decision.incremental_spf_runs", 1, fb303::COUNT);
+  const auto startTime = std::chrono::steady_clock::now();
+
+  constexpr auto kInfinity = std::numeric_limits<LinkStateMetric>::max();
+  using NodeMetric = std::pair<LinkStateMetric, std::string>;
+
+  // updated metric of nodes, kInfinity denotes a node became unreachable
+  std::unordered_map<std::string, LinkStateMetric> newMetrics;
+
+  auto getMetric = [&](std::string const& node) {
+    auto newIt = newMetrics.find(node);
+    if (newIt != newMetrics.end()) {
+      return newIt->second;
+    }
+    auto it = result.find(node);
+    return it != result.end() ? it->second.metric() : kInfinity;
+  };
+  auto getLinkMetric = [&](Link const& link, std::string const& fromNode) {
+    return useLinkMetric ? link.getMetricFromNode(fromNode) : 1;
+  };
+  // no transit traffic through overloaded nodes (see runSpf)
+  auto isTransitNode = [&](std::string const& node) {
+    return node == src or not isNodeOverloaded(node);
+  };
+  // check if link from prevNode is on shortest paths towards node
+  auto isOnShortestPath = [&](std::string const& node,
+                              std::string const& prevNode,
+                              Link const& link) {
+    auto it = result.find(node);
+    if (it == result.end()) {
+      return false;
+    }
+    for (auto const& pathLink : it->second.pathLinks()) {
+      if (pathLink.prevNode == prevNode and *pathLink.link == link) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  //
+  // 1) Find affected nodes: the ones reaching src via any of changed links
+  // and all their descendants in shortest path DAG
+  //
+  std::unordered_set<std::string> affected;
+  std::vector<std::string> toVisit;
+  for (auto const& link : changedLinks) {
+    for (auto const& node : {link->firstNodeName(), link->secondNodeName()}) {
+      if (isOnShortestPath(node, link->getOtherNodeName(node), *link) and
+          affected.insert(node).second) {
+        toVisit.emplace_back(node);
+      }
+    }
+  }
+  while (not toVisit.empty()) {
+    auto const node = std::move(toVisit.back());
+    toVisit.pop_back();
+    for (auto const& link : linksFromNode(node)) {
+      auto const& otherNode = link->getOtherNodeName(node);
+      if (not affected.count(otherNode) and
+          isOnShortestPath(otherNode, node, *link)) {
+        affected.insert(otherNode);
+        toVisit.emplace_back(otherNode);
+      }
+    }
+  }
+
+  // Recompute metric of affected nodes, seeded from unaffected neighbors
+  std::priority_queue<NodeMetric, std::vector<NodeMetric>, std::greater<>> q;
+  for (auto const& node : affected) {
+    newMetrics[node] = kInfinity;
+  }
+  for (auto const& node : affected) {
+    for (auto const& link : linksFromNode(node)) {
+      auto const& prevNode = link->getOtherNodeName(node);
+      auto const prevMetric = getMetric(prevNode);
+      if (not link->isUp() or affected.count(prevNode) or
+          prevMetric == kInfinity or not isTransitNode(prevNode)) {
+        continue;
+      }
+      auto const metric = prevMetric + getLinkMetric(*link, prevNode);
+      if (metric < newMetrics.at(node)) {
+        newMetrics[node] = metric;
+        q.emplace(metric, node);
+      }
+    }
+  }
+  std::unordered_set<std::string> settled;
+  while (not q.empty()) {
+    auto const [metric, node] = q.top();
+    q.pop();
+    if (metric > getMetric(node) or not settled.insert(node).second or
+        not isTransitNode(node)) {
+      continue;
+    }
+    for (auto const& link : linksFromNode(node)) {
+      auto const& otherNode = link->getOtherNodeName(node);
+      if (not link->isUp() or not affected.count(otherNode) or
+          settled.count(otherNode)) {
+        continue;
+      }
+      auto const otherMetric = metric + getLinkMetric(*link, node);
+      if (otherMetric < getMetric(otherNode)) {
+        newMetrics[otherNode] = otherMetric;
+        q.emplace(otherMetric, otherNode);
+      }
+    }
+  }
+
+  //
+  // 2) Propagate metric decreases from recomputed nodes and changed links
+  //
+  for (auto const& node : affected) {
+    if (getMetric(node) != kInfinity) {
+      q.emplace(getMetric(node), node);
+    }
+  }
+  for (auto const& link : changedLinks) {
+    for (auto const& node : {link->firstNodeName(), link->secondNodeName()}) {
+      if (getMetric(node) != kInfinity) {
+        q.emplace(getMetric(node), node);
+      }
+    }
+  }
+  while (not q.empty()) {
+    auto const [metric, node] = q.top();
+    q.pop();
+    if (metric != getMetric(node) or not isTransitNode(node)) {
+      continue;
+    }
+    for (auto const& link : linksFromNode(node)) {
+      if (not link->isUp()) {
+        continue;
+      }
+      auto const& otherNode = link->getOtherNodeName(node);
+      auto const otherMetric = metric + getLinkMetric(*link, node);
+      if (otherMetric < getMetric(otherNode)) {
+        newMetrics[otherNode] = otherMetric;
+        q.emplace(otherMetric, otherNode);
+      }
+    }
+  }
+
+  //
+  // 3) Rebuild path links and nexthops in the order runSpf() would have
+  // extracted nodes from DijkstraQ
+  //
+  std::set<NodeMetric> toUpdate;
+  auto markToUpdate = [&](std::string const& node) {
+    auto const metric = getMetric(node);
+    if (metric != kInfinity) {
+      toUpdate.emplace(metric, node);
+    }
+  };
+  auto markNeighborsToUpdate = [&](std::string const& node) {
+    for (auto const& link : linksFromNode(node)) {
+      markToUpdate(link->getOtherNodeName(node));
+    }
+  };
+  for (auto const& [node, metric] : newMetrics) {
+    if (metric == kInfinity) {
+      result.erase(node);
+      markNeighborsToUpdate(node);
+    } else {
+      markToUpdate(node);
+    }
+  }
+  for (auto const& link : changedLinks) {
+    markToUpdate(link->firstNodeName());
+    markToUpdate(link->secondNodeName());
+  }
+
+  while (not toUpdate.empty()) {
+    auto const [metric, node] = *toUpdate.begin();
+    toUpdate.erase(toUpdate.begin());
+
+    NodeSpfResult nodeResult(metric);
+    if (node != src) {
+      // predecessors on shortest paths, ordered as extracted by runSpf()
+      std::set<NodeMetric> prevNodes;
+      for (auto const& link : linksFromNode(node)) {
+        auto const& prevNode = link->getOtherNodeName(node);
+        auto const prevMetric = getMetric(prevNode);
+        if (link->isUp() and prevMetric != kInfinity and
+            isTransitNode(prevNode) and
+            prevMetric + getLinkMetric(*link, prevNode) == metric and
+            std::tie(prevMetric, prevNode) < std::tie(metric, node)) {
+          prevNodes.emplace(prevMetric, prevNode);
+        }
+      }
+      for (auto const& [prevMetric, prevNode] : prevNodes) {
+        // same order as the relax step of runSpf()
+        for (auto const& link : linksFromNode(prevNode)) {
+          if (link->getOtherNodeName(prevNode) != node or not link->isUp() or
+              prevMetric + getLinkMetric(*link, prevNode) != metric) {
+            continue;
+          }
+          nodeResult.addPath(link, prevNode);
+          nodeResult.addNextHops(result.at(prevNode).nextHops());
+          if (nodeResult.nextHops().empty()) {
+            // directly connected node
+            nodeResult.addNextHop(node);
+          }
+        }
+      }
+    }
+
+    // nexthops and metric are inherited by descendants, update them as well
+    auto it = result.find(node);
+    if (it == result.end()) {
+      result.emplace(node, std::move(nodeResult));
+      markNeighborsToUpdate(node);
+    } else {
+      const bool changed = it->second.metric() != nodeResult.metric() or
+          it->second.nextHops() != nodeResult.nextHops();
+      it->second = std::move(nodeResult);
+      if (changed) {
+        markNeighborsToUpdate(node);
+      }
+    }
+  }
+
+  VLOG(3) << "Incremental SPF affected nodes: " << affected.size()
+          << ", updated nodes: " << newMetrics.size();
+  auto deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - startTime);
+  VLOG(2) << "Incremental SPF elapsed time: " << deltaTime.count() << "us.";
+  fb303::fbData->addStatValue(
+      "decision.incremental_spf_us", deltaTime.count(), fb303::AVG);
+}
+
+LinkState::SpfGraph const&
+LinkState::getSpfGraph() const {
+  {
+    std::shared_lock<folly::SharedMutex> lock(*memoizationLock_);
+    if (spfGraph_) {
+      return *spfGraph_;
+    }
+  }
+  std::unique_lock<folly::SharedMutex> lock(*memoizationLock_);
+  if (spfGraph_) {
+    return *spfGraph_;
+  }
+
+  auto& graph = spfGraph_.emplace();
+  graph.nodeNames.reserve(linkMap_.size());
+  for (auto const& [nodeName, _] : linkMap_) {
+    graph.nodeNames.emplace_back(nodeName);
+  }
+  std::sort(graph.nodeNames.begin(), graph.nodeNames.end());
+  graph.nodeIds.reserve(graph.nodeNames.size());
+  for (LinkStateNodeId id = 0; id < graph.nodeNames.size(); ++id) {
+    graph.nodeIds.emplace(graph.nodeNames[id], id);
+  }
+
+  graph.offsets.reserve(graph.nodeNames.size() + 1);
+  graph.edges.reserve(2 * allLinks_.size());
+  graph.edgeLinks.reserve(2 * allLinks_.size());
+  graph.overloaded.reserve(graph.nodeNames.size());
+  for (auto const& nodeName : graph.nodeNames) {
+    graph.offsets.emplace_back(graph.edges.size());
+    graph.overloaded.emplace_back(isNodeOverloaded(nodeName));
+    // keep iteration order of linksFromNode() for stable path links order
+    for (auto const& link : linksFromNode(nodeName)) {
+      if (not link->isUp()) {
+        continue;
+      }
+      graph.edges.push_back(SpfGraph::Edge{
+          graph.nodeIds.at(link->getOtherNodeName(nodeName)),
+          link->getMetricFromNode(nodeName)});
+      graph.edgeLinks.emplace_back(link);
+    }
+  }
+  graph.offsets.emplace_back(graph.edges.size());
+  return graph;
 }
 
 /**
  * Compute shortest-path routes from perspective of nodeName;
+ *
+ * Dijkstra is run on the integer-indexed CSR graph (see getSpfGraph()) with
+ * node names only resolved when filling in the result.
  */
 LinkState::SpfResult
 LinkState::runSpf(
@@ -813,65 +1166,99 @@ LinkState::runSpf(
   fb303::fbData->addStatValue("decision.spf_runs", 1, fb303::COUNT);
   const auto startTime = std::chrono::steady_clock::now();
 
-  DijkstraQ q;
-  q.insertNode(thisNodeName, 0);
-  uint64_t loop = 0;
-  while (auto node = q.extractMin()) {
-    ++loop;
+  auto const& graph = getSpfGraph();
+  auto const srcIt = graph.nodeIds.find(thisNodeName);
+  if (srcIt == graph.nodeIds.end()) {
+    // node without any links
+    result.emplace(thisNodeName, NodeSpfResult(0));
+    return result;
+  }
+  auto const src = srcIt->second;
+  auto const numNodes = graph.nodeNames.size();
+
+  // path links (as edge index and previous node) and nexthops (sorted) of
+  // every node discovered so far
+  std::vector<std::vector<std::pair<size_t, LinkStateNodeId>>> pathEdges(
+      numNodes);
+  std::vector<std::vector<LinkStateNodeId>> nextHops(numNodes);
+  std::vector<bool> settled(numNodes, false);
+  // nodes in the order their shortest paths were found
+  std::vector<LinkStateNodeId> settledNodes;
+  std::vector<LinkStateNodeId> mergedNextHops;
+
+  DijkstraQ q(numNodes);
+  q.insertOrDecrease(src, 0);
+  while (not q.empty()) {
     // we've found this node's shortest paths. record it
-    auto emplaceRc = result.emplace(node->nodeName, std::move(node->result));
-    CHECK(emplaceRc.second);
-
-    auto const& recordedNodeName = emplaceRc.first->first;
-    auto const recordedNodeMetric = emplaceRc.first->second.metric();
-    auto const& recordedNodeNextHops = emplaceRc.first->second.nextHops();
+    auto const node = q.extractMin();
+    settled[node] = true;
+    settledNodes.emplace_back(node);
+    auto const nodeMetric = q.metric(node);
 
-    if (isNodeOverloaded(recordedNodeName) &&
-        recordedNodeName != thisNodeName) {
+    if (graph.overloaded[node] && node != src) {
       // no transit traffic through this node. we've recorded the nexthops to
       // this node, but will not consider any of it's adjancecies as offering
       // lower cost paths towards further away nodes. This effectively drains
       // traffic away from this node
       continue;
     }
-    // we have the shortest path nexthops for recordedNodeName. Use these
-    // nextHops for any node that is connected to recordedNodeName that doesn't
-    // already have a lower cost path from thisNodeName
+    // we have the shortest path nexthops for node. Use these nextHops for any
+    // node that is connected to node that doesn't already have a lower cost
+    // path from thisNodeName
     //
     // this is the "relax" step in the Dijkstra Algorithm pseudocode in CLRS
-    for (const auto& link : linksFromNode(recordedNodeName)) {
-      auto& otherNodeName = link->getOtherNodeName(recordedNodeName);
-      if (!link->isUp() or result.count(otherNodeName) or
-          linksToIgnore.count(link)) {
+    for (auto e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+      auto const& edge = graph.edges[e];
+      auto const otherNode = edge.otherNode;
+      if (settled[otherNode] or
+          (not linksToIgnore.empty() and
+           linksToIgnore.count(graph.edgeLinks[e]))) {
         continue;
       }
-      auto metric =
-          useLinkMetric ? link->getMetricFromNode(recordedNodeName) : 1;
-      auto otherNode = q.get(otherNodeName);
-      if (!otherNode) {
-        q.insertNode(otherNodeName, recordedNodeMetric + metric);
-        otherNode = q.get(otherNodeName);
-      }
-      if (otherNode->result.metric() >= recordedNodeMetric + metric) {
-        // recordedNodeName is either along an alternate shortest path towards
-        // otherNodeName or is along a new shorter path. In either case,
-        // otherNodeName should use recordedNodeName's nextHops until it finds
-        // some shorter path
-        if (otherNode->result.metric() > recordedNodeMetric + metric) {
-          // if this is strictly better, forget about any other paths
-          otherNode->result.reset(recordedNodeMetric + metric);
-          q.reMake();
-        }
-        otherNode->result.addPath(link, recordedNodeName);
-        otherNode->result.addNextHops(recordedNodeNextHops);
-        if (otherNode->result.nextHops().empty()) {
-          // directly connected node
-          otherNode->result.addNextHop(otherNodeName);
-        }
+      auto const metric = nodeMetric + (useLinkMetric ? edge.metric : 1);
+      if (q.metric(otherNode) < metric) {
+        continue;
+      }
+      // node is either along an alternate shortest path towards otherNode or
+      // is along a new shorter path. In either case, otherNode should use
+      // node's nextHops until it finds some shorter path
+      if (q.metric(otherNode) > metric) {
+        // if this is strictly better, forget about any other paths
+        q.insertOrDecrease(otherNode, metric);
+        pathEdges[otherNode].clear();
+        nextHops[otherNode].clear();
+      }
+      pathEdges[otherNode].emplace_back(e, node);
+      auto& otherNextHops = nextHops[otherNode];
+      mergedNextHops.clear();
+      std::set_union(
+          otherNextHops.begin(),
+          otherNextHops.end(),
+          nextHops[node].begin(),
+          nextHops[node].end(),
+          std::back_inserter(mergedNextHops));
+      if (mergedNextHops.empty()) {
+        // directly connected node
+        mergedNextHops.emplace_back(otherNode);
       }
+      otherNextHops.swap(mergedNextHops);
+    }
+  }
+
+  // translate node ids back to names
+  result.reserve(settledNodes.size());
+  for (auto const node : settledNodes) {
+    NodeSpfResult nodeResult(q.metric(node));
+    for (auto const& [e, prevNode] : pathEdges[node]) {
+      nodeResult.addPath(graph.edgeLinks[e], graph.nodeNames[prevNode]);
+    }
+    for (auto const nextHop : nextHops[node]) {
+      nodeResult.addNextHop(graph.nodeNames[nextHop]);
     }
+    result.emplace(graph.nodeNames[node], std::move(nodeResult));
   }
-  VLOG(3) << "Dijkstra loop count: " << loop;
+
+  VLOG(3) << "Dijkstra loop count: " << settledNodes.size();
   auto deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - startTime);
   LOG(INFO) << "SPF elapsed time: " << deltaTime.count() << "ms.";
@@ -879,4 +1266,113 @@ LinkState::runSpf(
   return result;
 }
 
+/**
+ * Targeted variant of runSpf(). Relaxation order is identical to runSpf() so
+ * that path links of dest and the nodes leading to it come out the same.
+ * Dijkstra terminates once dest is extracted. Nodes farther away than dest
+ * are never settled, and only nodes on dest's shortest paths are translated
+ * back to names.
+ */
+LinkState::SpfResult
+LinkState::runSpfToNode(
+    const std::string& thisNodeName,
+    const std::string& dest,
+    const LinkState::LinkSet& linksToIgnore) const {
+  LinkState::SpfResult result;
+
+  fb303::fbData->addStatValue("decision.spf_runs", 1, fb303::COUNT);
+
+  auto const& graph = getSpfGraph();
+  auto const srcIt = graph.nodeIds.find(thisNodeName);
+  auto const destIt = graph.nodeIds.find(dest);
+  if (srcIt == graph.nodeIds.end() or destIt == graph.nodeIds.end()) {
+    if (thisNodeName == dest) {
+      result.emplace(thisNodeName, NodeSpfResult(0));
+    }
+    return result;
+  }
+  auto const src = srcIt->second;
+  auto const target = destIt->second;
+  auto const numNodes = graph.nodeNames.size();
+
+  // resolve ignored links into edge indexes once instead of hashing every
+  // relaxed edge's link
+  std::vector<bool> ignoredEdges(graph.edges.size(), false);
+  for (auto const& link : linksToIgnore) {
+    for (auto const* nodeName :
+         {&link->firstNodeName(), &link->secondNodeName()}) {
+      auto const nodeIt = graph.nodeIds.find(*nodeName);
+      if (nodeIt == graph.nodeIds.end()) {
+        continue;
+      }
+      auto const node = nodeIt->second;
+      for (auto e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+        if (*graph.edgeLinks[e] == *link) {
+          ignoredEdges[e] = true;
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<std::pair<size_t, LinkStateNodeId>>> pathEdges(
+      numNodes);
+  std::vector<bool> settled(numNodes, false);
+
+  DijkstraQ q(numNodes);
+  q.insertOrDecrease(src, 0);
+  while (not q.empty()) {
+    auto const node = q.extractMin();
+    settled[node] = true;
+    if (node == target) {
+      // path links of dest and of every node before it are final
+      break;
+    }
+    if (graph.overloaded[node] && node != src) {
+      // no transit traffic through overloaded nodes (see runSpf)
+      continue;
+    }
+    auto const nodeMetric = q.metric(node);
+    for (auto e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+      auto const& edge = graph.edges[e];
+      auto const otherNode = edge.otherNode;
+      if (settled[otherNode] or ignoredEdges[e]) {
+        continue;
+      }
+      auto const metric = nodeMetric + edge.metric;
+      if (q.metric(otherNode) < metric) {
+        continue;
+      }
+      if (q.metric(otherNode) > metric) {
+        q.insertOrDecrease(otherNode, metric);
+        pathEdges[otherNode].clear();
+      }
+      pathEdges[otherNode].emplace_back(e, node);
+    }
+  }
+
+  if (not settled[target]) {
+    // dest is unreachable
+    return result;
+  }
+
+  // walk back from dest over its shortest paths DAG
+  std::vector<bool> visited(numNodes, false);
+  std::vector<LinkStateNodeId> toVisit{target};
+  visited[target] = true;
+  while (not toVisit.empty()) {
+    auto const node = toVisit.back();
+    toVisit.pop_back();
+    NodeSpfResult nodeResult(q.metric(node));
+    for (auto const& [e, prevNode] : pathEdges[node]) {
+      nodeResult.addPath(graph.edgeLinks[e], graph.nodeNames[prevNode]);
+      if (not visited[prevNode]) {
+        visited[prevNode] = true;
+        toVisit.emplace_back(prevNode);
+      }
+    }
+    result.emplace(graph.nodeNames[node], std::move(nodeResult));
+  }
+  return result;
+}
+
 } // namespace openr
@@ -8,12 +8,16 @@
 #pragma once
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <folly/SharedMutex.h>
+
 #include <openr/if/gen-cpp2/Lsdb_types.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 
@@ -21,6 +25,9 @@ namespace openr {
 
 using LinkStateMetric = uint64_t;
 
+// Dense node index used for running SPF on integer-indexed graph
+using LinkStateNodeId = uint32_t;
+
 // HoldableValue is the basic building block for ordered FIB programming
 // (rfc 6976)
 //
@@ -176,7 +183,10 @@ class Link {
 
 class LinkState {
  public:
-  explicit LinkState(const std::string& area);
+  // If enableIncrementalSpf is set, memoized SPF results are repaired on
+  // topology change instead of being recomputed from scratch
+  explicit LinkState(
+      const std::string& area, bool enableIncrementalSpf = false);
 
   struct LinkPtrHash {
     size_t operator()(const std::shared_ptr<Link>& l) const;
@@ -265,9 +275,15 @@ class LinkState {
   // - getSpfResult()
   // - getKthPaths()
   //
-  // each is memoized all params. memoization invalidated for any topolgy
+  // each is memoized all params and safe to call concurrently from multiple
+  // threads as long as no non-const method is called at the same time.
+  // memoization invalidated for any topolgy
   // altering calls, i.e. if decrementHolds(), updateAdjacencyDatabase(), or
   // deleteAdjacencyDatabase() returns with LinkState::topologyChanged set true
+  //
+  // With incremental SPF enabled, memoized SPF results are instead repaired
+  // for link up/down and link metric changes. Only nodes whose shortest paths
+  // are affected by the changed links are recomputed.
   SpfResult const& getSpfResult(
       const std::string& nodeName, bool useLinkMetric = true) const;
 
@@ -275,6 +291,15 @@ class LinkState {
   // LinkState belongs to a unique area
   const std::string area_;
 
+  // repair memoized SPF results on topology change instead of clearing them
+  const bool enableIncrementalSpf_{false};
+
+  // guards lazily filled memoization structures (spfResults_,
+  // kthPathResults_, spfGraph_) against concurrent const access. Held by
+  // pointer to keep LinkState movable
+  std::unique_ptr<folly::SharedMutex> memoizationLock_{
+      std::make_unique<folly::SharedMutex>()};
+
   // memoization structure for getSpfResult()
   mutable std::unordered_map<
       std::pair<std::string /* nodeName */, bool /* useLinkMetric */>,
@@ -432,6 +457,45 @@ class LinkState {
       LinkStateMetric holdUpTtl,
       LinkStateMetric holdDownTtl);
 
+  // invalidate memoization structures after topology change caused by
+  // changedLinks (links which went up/down or whose metric changed). SPF
+  // results are repaired if incremental SPF is enabled and canRepair is set,
+  // otherwise they are cleared and recomputed on next access.
+  void updateSpfResults(
+      std::vector<std::shared_ptr<Link>> const& changedLinks, bool canRepair);
+
+  // incrementally repair SPF result computed from src before changedLinks
+  // were updated. Result is the same as running runSpf(src, useLinkMetric)
+  // on the updated link state graph.
+  void updateSpfResult(
+      const std::string& src,
+      bool useLinkMetric,
+      std::vector<std::shared_ptr<Link>> const& changedLinks,
+      SpfResult& result) const;
+
+  // Immutable snapshot of up links in compressed sparse row (CSR) layout, which
+  // runSpf() operates on. Node names are interned into dense ids assigned in
+  // node name order, so that comparing ids is equivalent to comparing names.
+  // Rebuilt lazily after topology changes.
+  struct SpfGraph {
+    struct Edge {
+      LinkStateNodeId otherNode;
+      LinkStateMetric metric; // metric from this node towards otherNode
+    };
+
+    std::vector<std::string> nodeNames;
+    std::unordered_map<std::string, LinkStateNodeId> nodeIds;
+    // edges of node id i are edges[offsets[i], offsets[i + 1]), in the same
+    // order as linksFromNode(nodeNames[i])
+    std::vector<size_t> offsets;
+    std::vector<Edge> edges;
+    // link object of each edge, kept apart to keep edges compact
+    std::vector<std::shared_ptr<Link>> edgeLinks;
+    std::vector<bool> overloaded;
+  };
+
+  SpfGraph const& getSpfGraph() const;
+
   // run Dijkstra's Shortest Path First algorithm on the link state graph
   SpfResult runSpf(
       const std::string& src, /* the source node for the SPF run */
@@ -442,6 +506,16 @@ class LinkState {
           {} /* optionaly specify a set of links to not use when running */)
       const;
 
+  // run Dijkstra from src towards dest only, respecting link metrics and
+  // ignoring linksToIgnore. Stops as soon as dest is settled. Result holds
+  // dest and nodes on its shortest paths with the same path links as
+  // runSpf() would find, but without nexthops. Used for k-th paths (k > 1)
+  // which need a separate SPF run for every destination.
+  SpfResult runSpfToNode(
+      const std::string& src,
+      const std::string& dest,
+      const LinkSet& linksToIgnore) const;
+
   // returns Link object if the reverse adjancency is present in
   // adjacencyDatabases_.at(adj.otherNodeName), else returns nullptr
   std::shared_ptr<Link> maybeMakeLink(
@@ -459,6 +533,9 @@ class LinkState {
   // useful for iterating over all the links
   LinkSet allLinks_;
 
+  // cached CSR graph for runSpf(), reset on any topology change
+  mutable std::optional<SpfGraph> spfGraph_;
+
   std::unordered_map<std::string /* nodeName */, HoldableValue<bool>>
       nodeOverloads_;
 
@@ -468,70 +545,108 @@ class LinkState {
 
 }; // class LinkState
 
-// Classes needed for running Dijkstra
-// In addition to implementing the priority queue at the heart of Dijkstra's
-// algorithm, this structure also allows us to store appication specfic data:
-// nexthops.
-class DijkstraQNode {
- public:
-  DijkstraQNode(const std::string& n, LinkStateMetric m)
-      : nodeName(n), result(m) {}
-  const std::string nodeName;
-  LinkState::NodeSpfResult result;
-};
-
+// Priority queue at the heart of Dijkstra's algorithm. Implemented as a flat
+// d-ary min-heap of node ids with a position index for decrease-key. Ties on
+// metric are broken by node id, i.e. by node name (see LinkState::SpfGraph).
+// Metric of a node remains accessible after it is extracted.
 class DijkstraQ {
- private:
-  std::vector<std::shared_ptr<DijkstraQNode>> heap_;
-  std::unordered_map<std::string, std::shared_ptr<DijkstraQNode>> nameToNode_;
+ public:
+  explicit DijkstraQ(size_t numNodes)
+      : metrics_(numNodes, std::numeric_limits<LinkStateMetric>::max()),
+        positions_(numNodes, kNotInHeap) {}
 
-  struct {
-    bool
-    operator()(
-        std::shared_ptr<DijkstraQNode> a,
-        std::shared_ptr<DijkstraQNode> b) const {
-      if (a->result.metric() != b->result.metric()) {
-        return a->result.metric() > b->result.metric();
-      }
-      return a->nodeName > b->nodeName;
-    }
-  } DijkstraQNodeGreater;
+  bool
+  empty() const {
+    return heap_.empty();
+  }
 
- public:
-  void
-  insertNode(const std::string& nodeName, LinkStateMetric d) {
-    heap_.push_back(std::make_shared<DijkstraQNode>(nodeName, d));
-    nameToNode_[nodeName] = heap_.back();
-    std::push_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
+  LinkStateMetric
+  metric(LinkStateNodeId node) const {
+    return metrics_[node];
   }
 
-  std::shared_ptr<DijkstraQNode>
-  get(const std::string& nodeName) {
-    if (nameToNode_.count(nodeName)) {
-      return nameToNode_.at(nodeName);
+  // insert node or decrease its metric if it is already in the queue
+  void
+  insertOrDecrease(LinkStateNodeId node, LinkStateMetric metric) {
+    metrics_[node] = metric;
+    if (positions_[node] == kNotInHeap) {
+      positions_[node] = heap_.size();
+      heap_.push_back(node);
     }
-    return nullptr;
+    siftUp(positions_[node]);
   }
 
-  std::shared_ptr<DijkstraQNode>
+  LinkStateNodeId
   extractMin() {
-    if (heap_.empty()) {
-      return nullptr;
-    }
-    auto min = heap_.at(0);
-    CHECK(nameToNode_.erase(min->nodeName));
-    std::pop_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
+    auto const min = heap_.front();
+    positions_[min] = kNotInHeap;
+    heap_.front() = heap_.back();
     heap_.pop_back();
+    if (not heap_.empty()) {
+      positions_[heap_.front()] = 0;
+      siftDown(0);
+    }
     return min;
   }
 
+ private:
+  static constexpr size_t kArity{4};
+  static constexpr size_t kNotInHeap{std::numeric_limits<size_t>::max()};
+
+  bool
+  less(LinkStateNodeId a, LinkStateNodeId b) const {
+    if (metrics_[a] != metrics_[b]) {
+      return metrics_[a] < metrics_[b];
+    }
+    return a < b;
+  }
+
   void
-  reMake() {
-    // this is a bit slow but is rarely called in our application. In fact,
-    // in networks where the metric is hop count, this will never be called
-    // and the Dijkstra run is no different than BFS
-    std::make_heap(heap_.begin(), heap_.end(), DijkstraQNodeGreater);
+  siftUp(size_t pos) {
+    auto const node = heap_[pos];
+    while (pos > 0) {
+      auto const parentPos = (pos - 1) / kArity;
+      if (not less(node, heap_[parentPos])) {
+        break;
+      }
+      heap_[pos] = heap_[parentPos];
+      positions_[heap_[pos]] = pos;
+      pos = parentPos;
+    }
+    heap_[pos] = node;
+    positions_[node] = pos;
   }
+
+  void
+  siftDown(size_t pos) {
+    auto const node = heap_[pos];
+    while (true) {
+      auto const firstChildPos = pos * kArity + 1;
+      if (firstChildPos >= heap_.size()) {
+        break;
+      }
+      auto const lastChildPos =
+          std::min(firstChildPos + kArity, heap_.size());
+      auto minChildPos = firstChildPos;
+      for (auto i = firstChildPos + 1; i < lastChildPos; ++i) {
+        if (less(heap_[i], heap_[minChildPos])) {
+          minChildPos = i;
+        }
+      }
+      if (not less(heap_[minChildPos], node)) {
+        break;
+      }
+      heap_[pos] = heap_[minChildPos];
+      positions_[heap_[pos]] = pos;
+      pos = minChildPos;
+    }
+    heap_[pos] = node;
+    positions_[node] = pos;
+  }
+
+  std::vector<LinkStateMetric> metrics_;
+  std::vector<size_t> positions_;
+  std::vector<LinkStateNodeId> heap_;
 };
 } // namespace openr
 
@@ -137,7 +137,8 @@ class DecisionWrapper {
       const std::string& nodeId,
       int64_t version,
       const std::vector<thrift::IpPrefix>& prefixes,
-      thrift::PrefixForwardingAlgorithm forwardingAlgorithm) {
+      thrift::PrefixForwardingAlgorithm forwardingAlgorithm,
+      const std::optional<thrift::PerfEvents>& perfEvents = std::nullopt) {
     std::vector<thrift::PrefixEntry> prefixEntries;
     for (const auto& prefix : prefixes) {
       prefixEntries.emplace_back(createPrefixEntry(prefix));
@@ -148,12 +149,15 @@ class DecisionWrapper {
             thrift::PrefixForwardingType::SR_MPLS;
       }
     }
+    auto prefixDb = createPrefixDb(nodeId, prefixEntries);
+    if (perfEvents.has_value()) {
+      fromStdOptional(prefixDb.perfEvents_ref(), perfEvents);
+    }
     return thrift::Value(
         FRAGILE,
         version,
         "originator-1",
-        fbzmq::util::writeThriftObjStr(
-            createPrefixDb(nodeId, prefixEntries), serializer),
+        fbzmq::util::writeThriftObjStr(prefixDb, serializer),
         Constants::kTtlInfinity /* ttl */,
         0 /* ttl version */,
         0 /* hash */);
@@ -191,7 +195,7 @@ class DecisionWrapper {
   CompactSerializer serializer{};
 
   std::shared_ptr<Config> config;
-  messaging::ReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
+  messaging::SharedReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
   messaging::ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue;
   messaging::ReplicateQueue<thrift::RouteDatabaseDelta> staticRoutesUpdateQueue;
   messaging::RQueue<DecisionRouteUpdate> routeUpdatesQueueReader{
@@ -665,6 +669,78 @@ updateRandomGridAdjs(
       decisionWrapper, newPub, nodeName, adjs, processTimes, overloadBit);
 }
 
+//
+// Advertise prefixes spread evenly across all nodes of n * n grid. Prefix
+// keys in initialPub are replaced. Returns advertised prefixes per node.
+//
+std::vector<std::vector<thrift::IpPrefix>>
+createGridPrefixes(
+    const std::shared_ptr<DecisionWrapper>& decisionWrapper,
+    thrift::Publication& initialPub,
+    const int n,
+    const uint32_t numOfPrefixes,
+    thrift::PrefixForwardingAlgorithm forwardingAlgorithm) {
+  std::vector<std::vector<thrift::IpPrefix>> nodePrefixes(n * n);
+  for (uint32_t i = 0; i < numOfPrefixes; ++i) {
+    const auto nodeId = i % (n * n);
+    nodePrefixes[nodeId].emplace_back(toIpPrefix(
+        folly::sformat("fd00:{}:{}::/64", toHex(nodeId), toHex(i / (n * n)))));
+  }
+
+  for (int nodeId = 0; nodeId < n * n; ++nodeId) {
+    auto nodeName = folly::sformat("{}", nodeId);
+    initialPub.keyVals[folly::sformat("prefix:{}", nodeName)] =
+        decisionWrapper->createPrefixValue(
+            nodeName, 1, nodePrefixes[nodeId], forwardingAlgorithm);
+  }
+  return nodePrefixes;
+}
+
+//
+// Choose a random node and let it advertise one more prefix, or revert the
+// last update by withdrawing it again. Topology is left intact.
+//
+void
+updateRandomGridPrefixes(
+    const std::shared_ptr<DecisionWrapper>& decisionWrapper,
+    std::optional<int>& selectedNode,
+    std::vector<std::vector<thrift::IpPrefix>> const& nodePrefixes,
+    thrift::PrefixForwardingAlgorithm forwardingAlgorithm,
+    int64_t& version,
+    std::vector<uint64_t>& processTimes) {
+  const int nodeId = selectedNode.has_value()
+      ? selectedNode.value()
+      : folly::Random::rand32() % nodePrefixes.size();
+  const auto nodeName = folly::sformat("{}", nodeId);
+
+  auto prefixes = nodePrefixes.at(nodeId);
+  if (not selectedNode.has_value()) {
+    prefixes.emplace_back(
+        toIpPrefix(folly::sformat("fd01:{}::/64", toHex(nodeId))));
+  }
+  selectedNode =
+      selectedNode.has_value() ? std::nullopt : std::optional<int>(nodeId);
+
+  thrift::PerfEvents perfEvents;
+  addPerfEvent(perfEvents, nodeName, "DECISION_INIT_UPDATE");
+
+  thrift::Publication newPub;
+  newPub.keyVals[folly::sformat("prefix:{}", nodeName)] =
+      decisionWrapper->createPrefixValue(
+          nodeName,
+          ++version,
+          prefixes,
+          forwardingAlgorithm,
+          std::move(perfEvents));
+  decisionWrapper->sendKvPublication(newPub);
+
+  // Receive route update from Decision
+  auto routes = decisionWrapper->recvMyRouteDb();
+  if (routes.perfEvents.has_value()) {
+    accumulatePerfTimes(routes.perfEvents.value(), processTimes);
+  }
+}
+
 //
 // Get average processTimes and insert as user counters.
 //
@@ -799,6 +875,58 @@ BM_DecisionFabric(
   insertUserCounters(counters, iters, processTimes);
 }
 
+//
+// Benchmark test for single prefix churn. Fixed size grid topology with
+// numOfPrefixes prefixes advertised across all nodes. Only one prefix changes
+// per iteration.
+//
+static void
+BM_DecisionGridPrefixUpdates(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfPrefixes,
+    thrift::PrefixForwardingAlgorithm forwardingAlgorithm) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"1"};
+  auto decisionWrapper = std::make_shared<DecisionWrapper>(nodeName);
+  const int n = 10;
+  auto initialPub = createGrid(decisionWrapper, n, forwardingAlgorithm);
+  const auto nodePrefixes = createGridPrefixes(
+      decisionWrapper, initialPub, n, numOfPrefixes, forwardingAlgorithm);
+
+  //
+  // Publish initial link state info to KvStore, This should trigger the
+  // SPF run.
+  //
+  decisionWrapper->sendKvPublication(initialPub);
+
+  // Receive RouteUpdate from Decision
+  decisionWrapper->recvMyRouteDb();
+
+  // Record the updated node
+  std::optional<int> selectedNode = std::nullopt;
+  int64_t version{1};
+
+  // See BM_DecisionGrid for processTimes layout
+  std::vector<uint64_t> processTimes{0, 0, 0};
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    // Advertise prefix update. This should not trigger the SPF run.
+    updateRandomGridPrefixes(
+        decisionWrapper,
+        selectedNode,
+        nodePrefixes,
+        forwardingAlgorithm,
+        version,
+        processTimes);
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  // Insert processTimes as user counters
+  insertUserCounters(counters, iters, processTimes);
+}
+
 auto SP_ECMP = thrift::PrefixForwardingAlgorithm::SP_ECMP;
 auto KSP2_ED_ECMP = thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP;
 
@@ -811,6 +939,7 @@ BENCHMARK_COUNTERS_PARAM(BM_DecisionGrid, counters, 10000, SP_ECMP);
 BENCHMARK_COUNTERS_PARAM(BM_DecisionGrid, counters, 10, KSP2_ED_ECMP);
 BENCHMARK_COUNTERS_PARAM(BM_DecisionGrid, counters, 100, KSP2_ED_ECMP);
 BENCHMARK_COUNTERS_PARAM(BM_DecisionGrid, counters, 1000, KSP2_ED_ECMP);
+BENCHMARK_COUNTERS_PARAM(BM_DecisionGrid, counters, 10000, KSP2_ED_ECMP);
 
 // The integer parameter is numOfGivenNodes in topology,
 // which >= numOfActualNodesInTopo.
@@ -822,6 +951,14 @@ BENCHMARK_COUNTERS_PARAM(BM_DecisionFabric, counters, 344, SP_ECMP);
 BENCHMARK_COUNTERS_PARAM(BM_DecisionFabric, counters, 1000, SP_ECMP);
 BENCHMARK_COUNTERS_PARAM(BM_DecisionFabric, counters, 5000, SP_ECMP);
 
+// The integer parameter is the number of prefixes advertised in the network
+// out of which one prefix is updated per iteration
+BENCHMARK_COUNTERS_PARAM(BM_DecisionGridPrefixUpdates, counters, 1000, SP_ECMP);
+BENCHMARK_COUNTERS_PARAM(
+    BM_DecisionGridPrefixUpdates, counters, 10000, SP_ECMP);
+BENCHMARK_COUNTERS_PARAM(
+    BM_DecisionGridPrefixUpdates, counters, 100000, SP_ECMP);
+
 } // namespace openr
 
 int
@@ -4009,6 +4009,38 @@ TEST_P(GridTopologyFixture, ShortestPathTest) {
   EXPECT_EQ(gridDistance(src, dst, n), nextHops.begin()->metric);
 }
 
+// Route build sharded across worker threads must yield the same routes as
+// inline route build
+TEST(GridTopology, ParallelRouteBuild) {
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(kDefaultArea, LinkState(kDefaultArea));
+  auto& linkState = areaLinkStates.at(kDefaultArea);
+  PrefixState prefixState;
+
+  // enough prefixes for multiple route build shards
+  const int n = 50;
+  createGrid(linkState, prefixState, n);
+  ASSERT_GT(
+      static_cast<size_t>(n * n), 2 * Constants::kMinPrefixesPerRouteBuildShard);
+
+  SpfSolver spfSolver("1", false, true);
+  SpfSolver parallelSpfSolver(
+      "1", false, true, false, false, false, 4 /* numRouteBuildThreads */);
+  for (auto const& node : {"0", "523", "2499"}) {
+    // parallel first so that workers start with empty SPF caches
+    auto parallelRouteDb =
+        parallelSpfSolver.buildRouteDb(node, areaLinkStates, prefixState);
+    auto routeDb = spfSolver.buildRouteDb(node, areaLinkStates, prefixState);
+    ASSERT_TRUE(parallelRouteDb.has_value());
+    ASSERT_TRUE(routeDb.has_value());
+    EXPECT_EQ(
+        static_cast<size_t>(n * n - 1),
+        parallelRouteDb->unicastEntries.size());
+    EXPECT_EQ(routeDb->unicastEntries, parallelRouteDb->unicastEntries);
+    EXPECT_EQ(routeDb->mplsEntries, parallelRouteDb->mplsEntries);
+  }
+}
+
 // measure SPF execution time for large networks
 TEST(GridTopology, StressTest) {
   if (!FLAGS_stress_test) {
@@ -4209,7 +4241,7 @@ class DecisionTestFixture : public ::testing::Test {
   CompactSerializer serializer{};
 
   std::shared_ptr<Config> config;
-  messaging::ReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
+  messaging::SharedReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
   messaging::ReplicateQueue<thrift::RouteDatabaseDelta> staticRoutesUpdateQueue;
   messaging::ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue;
   messaging::RQueue<DecisionRouteUpdate> routeUpdatesQueueReader{
@@ -4821,7 +4853,7 @@ TEST(Decision, RibPolicyFeatureKnob) {
   auto config = std::make_shared<Config>(tConfig);
   ASSERT_FALSE(config->isRibPolicyEnabled());
 
-  messaging::ReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
+  messaging::SharedReplicateQueue<thrift::Publication> kvStoreUpdatesQueue;
   messaging::ReplicateQueue<thrift::RouteDatabaseDelta> staticRoutesUpdateQueue;
   messaging::ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue;
   auto decision = std::make_unique<Decision>(
@@ -4981,6 +5013,103 @@ TEST_F(DecisionTestFixture, ParallelLinks) {
       NextHops({createNextHopFromAdj(adj12_2, false, 800)}));
 }
 
+/**
+ * Node 2 advertises its adjacencies with per adjacency keys and node
+ * attributes with full adjacency key. Decision must merge both and apply
+ * withdraw and expiry of individual adjacency keys
+ */
+TEST_F(DecisionTestFixture, PerAdjacencyKeys) {
+  auto adj12_1 =
+      createAdjacency("2", "1/2-1", "2/1-1", "fe80::2", "192.168.0.2", 100, 0);
+  auto adj12_2 =
+      createAdjacency("2", "1/2-2", "2/1-2", "fe80::2", "192.168.0.2", 800, 0);
+  auto adj21_1 =
+      createAdjacency("1", "2/1-1", "1/2-1", "fe80::1", "192.168.0.1", 100, 0);
+  auto adj21_2 =
+      createAdjacency("1", "2/1-2", "1/2-2", "fe80::1", "192.168.0.1", 800, 0);
+  const auto adjKey21_1 = getPerAdjacencyKey("2", "1", "2/1-1");
+  const auto adjKey21_2 = getPerAdjacencyKey("2", "1", "2/1-2");
+  EXPECT_TRUE(isPerAdjacencyKey(adjKey21_1));
+  EXPECT_FALSE(isPerAdjacencyKey("adj:2"));
+  EXPECT_EQ("2", getNodeNameFromKey(adjKey21_1));
+
+  auto checkNextHops = [&](NextHops const& nextHops) {
+    auto routeDbDelta = recvMyRouteDb("1", serializer);
+    EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+    auto routeDb = dumpRouteDb({"1"})["1"];
+    RouteMap routeMap;
+    fillRouteMap("1", routeMap, routeDb);
+    EXPECT_EQ(routeMap[make_pair("1", toString(addr2))], nextHops);
+  };
+
+  // full key of node 2 carries no adjacencies
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue("1", 1, {adj12_1, adj12_2})},
+       {"adj:2", createAdjValue("2", 1, {})},
+       {adjKey21_1, createAdjValue("2", 1, {adj21_1})},
+       {adjKey21_2, createAdjValue("2", 1, {adj21_2})},
+       {"prefix:1", createPrefixValue("1", 1, {addr1})},
+       {"prefix:2", createPrefixValue("2", 1, {addr2})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  checkNextHops({createNextHopFromAdj(adj12_1, false, 100),
+                 createNextHopFromAdj(adj12_2, false, 800)});
+
+  // withdraw single adjacency with empty database
+  publication = createThriftPublication(
+      {{adjKey21_1, createAdjValue("2", 2, {})}}, {}, {}, {}, std::string(""));
+  sendKvPublication(publication);
+  checkNextHops({createNextHopFromAdj(adj12_2, false, 800)});
+
+  // re-advertise it. Per adjacency key overrides same adjacency in full key
+  auto adj21_1_overloaded = adj21_1;
+  adj21_1_overloaded.isOverloaded = true;
+  publication = createThriftPublication(
+      {{"adj:2", createAdjValue("2", 2, {adj21_1_overloaded})},
+       {adjKey21_1, createAdjValue("2", 3, {adj21_1})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  checkNextHops({createNextHopFromAdj(adj12_1, false, 100),
+                 createNextHopFromAdj(adj12_2, false, 800)});
+
+  // expiry of per adjacency key removes only that adjacency
+  publication =
+      createThriftPublication({}, {adjKey21_2}, {}, {}, std::string(""));
+  sendKvPublication(publication);
+  checkNextHops({createNextHopFromAdj(adj12_1, false, 100)});
+
+  // malformed per adjacency keys are skipped. Key carrying more than one
+  // adjacency or an adjacency it isn't named after
+  fb303::fbData->resetAllData();
+  publication = createThriftPublication(
+      {{adjKey21_1, createAdjValue("2", 4, {adj21_1, adj21_2})},
+       {adjKey21_2, createAdjValue("2", 4, {adj21_1})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+
+  // valid key after malformed ones is still processed
+  publication = createThriftPublication(
+      {{adjKey21_2, createAdjValue("2", 5, {adj21_2})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  checkNextHops({createNextHopFromAdj(adj12_1, false, 100),
+                 createNextHopFromAdj(adj12_2, false, 800)});
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_EQ(2, counters.at("decision.invalid_per_adj_key.count"));
+}
+
 // The following topology is used:
 //
 // 1---2---3---4
@@ -5132,6 +5261,91 @@ TEST_F(DecisionTestFixture, PubDebouncing) {
   EXPECT_EQ(5, counters["decision.route_build_runs.count"]);
 }
 
+//
+// Prefix only updates must be processed incrementally. Only changed prefixes
+// are recomputed (against cached SPF results) and published in the delta.
+//
+TEST_F(DecisionTestFixture, IncrementalPrefixUpdate) {
+  fb303::fbData->resetAllData();
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue("1", 1, {adj12, adj13})},
+       {"adj:2", createAdjValue("2", 1, {adj21})},
+       {"adj:3", createAdjValue("3", 1, {adj31})},
+       {"prefix:1", createPrefixValue("1", 1, {addr1})},
+       {"prefix:2", createPrefixValue("2", 1, {addr2})},
+       {"prefix:3", createPrefixValue("3", 1, {addr3})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  auto routeDbDelta = recvMyRouteDb("1", serializer);
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+
+  auto counters = fb303::fbData->getCounters();
+  const auto spfRuns = counters["decision.spf_runs.count"];
+  const auto routeBuildRuns = counters["decision.route_build_runs.count"];
+
+  //
+  // Node 2 starts advertising new prefix. Only route for new prefix must be
+  // published and no SPF run is expected.
+  //
+  publication = createThriftPublication(
+      {{"prefix:2", createPrefixValue("2", 2, {addr2, addr5})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvMyRouteDb("1", serializer);
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(toIPNetwork(addr5), routeDbDelta.unicastRoutesToUpdate[0].prefix);
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(0, routeDbDelta.mplsRoutesToUpdate.size());
+  EXPECT_EQ(0, routeDbDelta.mplsRoutesToDelete.size());
+
+  counters = fb303::fbData->getCounters();
+  EXPECT_EQ(spfRuns, counters["decision.spf_runs.count"]);
+  EXPECT_EQ(routeBuildRuns + 1, counters["decision.route_build_runs.count"]);
+
+  //
+  // Node 2 withdraws a prefix. Only withdrawn route must be deleted.
+  //
+  publication = createThriftPublication(
+      {{"prefix:2", createPrefixValue("2", 3, {addr5})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvMyRouteDb("1", serializer);
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr2), routeDbDelta.unicastRoutesToDelete[0]);
+
+  //
+  // Prefix advertised by myself must not be programmed, route towards
+  // node 3 must be withdrawn once we start advertising it as well
+  //
+  publication = createThriftPublication(
+      {{"prefix:1", createPrefixValue("1", 2, {addr1, addr3})}},
+      {},
+      {},
+      {},
+      std::string(""));
+  sendKvPublication(publication);
+  routeDbDelta = recvMyRouteDb("1", serializer);
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete[0]);
+
+  // Incrementally maintained routes must match with full route computation
+  auto routeDb = dumpRouteDb({"1"})["1"];
+  ASSERT_EQ(1, routeDb.unicastRoutes.size());
+  EXPECT_EQ(toIPNetwork(addr5), toIPNetwork(routeDb.unicastRoutes[0].dest));
+  EXPECT_EQ(spfRuns, fb303::fbData->getCounters()["decision.spf_runs.count"]);
+}
+
 //
 // Send unrelated key-value pairs to Decision
 // Make sure they do not trigger SPF runs, but rather ignored
@@ -5,6 +5,11 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <map>
+#include <random>
+#include <set>
+
+#include <folly/Format.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -315,6 +320,87 @@ TEST(LinkStateTest, getKthPaths) {
   }
 }
 
+/**
+ * Verify second paths towards every destination of a random topology against
+ * a reference Dijkstra run with first paths' links removed
+ */
+TEST(LinkStateTest, getKthPathsRandomized) {
+  const int kNumNodes = 40;
+  std::mt19937 gen(0x5eed);
+
+  std::unordered_map<int, std::vector<std::pair<int, int>>> adjMap;
+  for (int node = 0; node < kNumNodes; ++node) {
+    adjMap[node];
+    for (int i = 0; i < 2; ++i) {
+      int other = gen() % kNumNodes;
+      if (other != node) {
+        const int metric = 1 + gen() % 3;
+        adjMap[node].emplace_back(other, metric);
+        adjMap[other].emplace_back(node, metric);
+      }
+    }
+  }
+  auto linkState = openr::getLinkState(adjMap);
+
+  const std::string src{"0"};
+  // returns node at the end of the path and path cost
+  auto walkPath = [&](openr::LinkState::Path const& path) {
+    std::string node = src;
+    openr::LinkStateMetric cost = 0;
+    for (auto const& link : path) {
+      cost += link->getMetricFromNode(node);
+      node = link->getOtherNodeName(node);
+    }
+    return std::make_pair(node, cost);
+  };
+
+  for (int dest = 1; dest < kNumNodes; ++dest) {
+    auto const destName = folly::sformat("{}", dest);
+    openr::LinkState::LinkSet firstPathLinks;
+    for (auto const& path : linkState.getKthPaths(src, destName, 1)) {
+      EXPECT_EQ(destName, walkPath(path).first);
+      firstPathLinks.insert(path.begin(), path.end());
+    }
+
+    // reference Dijkstra
+    std::map<std::string, openr::LinkStateMetric> dist{{src, 0}};
+    std::set<std::pair<openr::LinkStateMetric, std::string>> q{{0, src}};
+    while (not q.empty()) {
+      auto const [metric, node] = *q.begin();
+      q.erase(q.begin());
+      for (auto const& link : linkState.linksFromNode(node)) {
+        if (not link->isUp() or firstPathLinks.count(link)) {
+          continue;
+        }
+        auto const& other = link->getOtherNodeName(node);
+        auto const otherMetric = metric + link->getMetricFromNode(node);
+        if (not dist.count(other) or otherMetric < dist.at(other)) {
+          q.erase({dist.count(other) ? dist.at(other) : 0, other});
+          dist[other] = otherMetric;
+          q.emplace(otherMetric, other);
+        }
+      }
+    }
+
+    auto const& secondPaths = linkState.getKthPaths(src, destName, 2);
+    if (firstPathLinks.empty() or not dist.count(destName)) {
+      EXPECT_TRUE(secondPaths.empty());
+      continue;
+    }
+    EXPECT_FALSE(secondPaths.empty());
+    openr::LinkState::LinkSet secondPathLinks;
+    for (auto const& path : secondPaths) {
+      auto const [node, cost] = walkPath(path);
+      EXPECT_EQ(destName, node);
+      EXPECT_EQ(dist.at(destName), cost);
+      for (auto const& link : path) {
+        EXPECT_EQ(0, firstPathLinks.count(link));
+        EXPECT_TRUE(secondPathLinks.insert(link).second);
+      }
+    }
+  }
+}
+
 TEST(LinkStateTest, getHopCounts) {
   {
     // box
@@ -376,6 +462,134 @@ TEST(LinkStateTest, getHopCounts) {
   }
 }
 
+namespace {
+void
+expectSpfResultsEqual(
+    openr::LinkState::SpfResult const& expected,
+    openr::LinkState::SpfResult const& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (auto const& [node, expectedResult] : expected) {
+    ASSERT_EQ(1, actual.count(node)) << node;
+    auto const& actualResult = actual.at(node);
+    EXPECT_EQ(expectedResult.metric(), actualResult.metric()) << node;
+    EXPECT_EQ(expectedResult.nextHops(), actualResult.nextHops()) << node;
+    auto const& expectedPathLinks = expectedResult.pathLinks();
+    auto const& actualPathLinks = actualResult.pathLinks();
+    ASSERT_EQ(expectedPathLinks.size(), actualPathLinks.size()) << node;
+    for (size_t i = 0; i < expectedPathLinks.size(); ++i) {
+      EXPECT_EQ(*expectedPathLinks.at(i).link, *actualPathLinks.at(i).link);
+      EXPECT_EQ(
+          expectedPathLinks.at(i).prevNode, actualPathLinks.at(i).prevNode);
+    }
+  }
+}
+} // namespace
+
+/**
+ * Apply random topology changes to link states with and without incremental
+ * SPF and verify memoized SPF results are identical to full SPF runs
+ */
+TEST(LinkStateTest, IncrementalSpf) {
+  using folly::sformat;
+  const int kNumNodes = 30;
+  const int kNumSources = 4;
+  std::mt19937 gen(0x1234);
+
+  // node -> neighbor -> metric, small metrics to create plenty of ECMP
+  std::map<int, std::map<int, int>> topology;
+  for (int node = 0; node < kNumNodes; ++node) {
+    topology[node];
+    for (int i = 0; i < 3; ++i) {
+      int other = gen() % kNumNodes;
+      if (other != node) {
+        topology[node][other] = 1 + gen() % 3;
+        topology[other][node] = 1 + gen() % 3;
+      }
+    }
+  }
+
+  auto getAdjDb = [&](int node) {
+    std::vector<openr::thrift::Adjacency> adjs;
+    for (auto const& [adj, metric] : topology.at(node)) {
+      adjs.emplace_back(openr::createAdjacency(
+          sformat("{}", adj),
+          sformat("{}/{}", node, adj),
+          sformat("{}/{}", adj, node),
+          sformat("fe80::{:x}", adj + 1),
+          sformat("192.168.0.{}", adj + 1),
+          metric,
+          (node << 16) + adj));
+    }
+    return openr::createAdjDb(sformat("{}", node), adjs, node + 1);
+  };
+
+  openr::LinkState fullState{kDefaultArea};
+  openr::LinkState incrementalState{kDefaultArea, true};
+  for (auto const& [node, _] : topology) {
+    fullState.updateAdjacencyDatabase(getAdjDb(node), 0, 0);
+    incrementalState.updateAdjacencyDatabase(getAdjDb(node), 0, 0);
+  }
+
+  auto verifyAll = [&]() {
+    for (int src = 0; src < kNumSources; ++src) {
+      for (bool useLinkMetric : {true, false}) {
+        expectSpfResultsEqual(
+            fullState.getSpfResult(sformat("{}", src), useLinkMetric),
+            incrementalState.getSpfResult(sformat("{}", src), useLinkMetric));
+      }
+    }
+  };
+  // populate memoized results which will be repaired from now on
+  verifyAll();
+
+  for (int round = 0; round < 200; ++round) {
+    const int node = gen() % kNumNodes;
+    const int other = gen() % kNumNodes;
+    switch (gen() % 4) {
+    case 0:
+      // metric change of an existing link in one direction
+      if (topology.at(node).count(other)) {
+        topology[node][other] = 1 + gen() % 3;
+      }
+      break;
+    case 1:
+      // link down
+      topology[node].erase(other);
+      topology[other].erase(node);
+      break;
+    case 2:
+      // link up
+      if (node != other) {
+        topology[node][other] = 1 + gen() % 3;
+        topology[other][node] = 1 + gen() % 3;
+      }
+      break;
+    case 3:
+      // node withdraws its adjacencies altogether
+      if (node >= kNumSources) {
+        EXPECT_EQ(
+            fullState.deleteAdjacencyDatabase(sformat("{}", node))
+                .topologyChanged,
+            incrementalState.deleteAdjacencyDatabase(sformat("{}", node))
+                .topologyChanged);
+        verifyAll();
+      }
+      break;
+    }
+    EXPECT_EQ(
+        fullState.updateAdjacencyDatabase(getAdjDb(node), 0, 0)
+            .topologyChanged,
+        incrementalState.updateAdjacencyDatabase(getAdjDb(node), 0, 0)
+            .topologyChanged);
+    EXPECT_EQ(
+        fullState.updateAdjacencyDatabase(getAdjDb(other), 0, 0)
+            .topologyChanged,
+        incrementalState.updateAdjacencyDatabase(getAdjDb(other), 0, 0)
+            .topologyChanged);
+    verifyAll();
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
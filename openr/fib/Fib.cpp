@@ -23,6 +23,39 @@ namespace fb303 = facebook::fb303;
 
 namespace openr {
 
+namespace {
+
+// Add or remove `key` in the ifName reverse index for every interface used
+// by the given nexthops
+template <typename Key>
+void
+updateIfNameIndex(
+    std::unordered_map<std::string, std::unordered_set<Key>>& index,
+    Key const& key,
+    std::vector<thrift::NextHopThrift> const& nextHops,
+    bool add) {
+  for (auto const& nextHop : nextHops) {
+    auto const ifName = nextHop.address.ifName_ref();
+    if (not ifName.has_value()) {
+      continue;
+    }
+    if (add) {
+      index[*ifName].emplace(key);
+      continue;
+    }
+    auto it = index.find(*ifName);
+    if (it == index.end()) {
+      continue;
+    }
+    it->second.erase(key);
+    if (it->second.empty()) {
+      index.erase(it);
+    }
+  }
+}
+
+} // namespace
+
 Fib::Fib(
     std::shared_ptr<const Config> config,
     int32_t thriftPort,
@@ -256,10 +289,9 @@ Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
     const auto inputPrefix = maybePrefix.value();
 
     // do longest prefix match, add the matched prefix to the result set
-    const auto& matchedPrefix =
-        Fib::longestPrefixMatch(inputPrefix, routeState_.unicastRoutes);
-    if (matchedPrefix.has_value()) {
-      matchPrefixSet.insert(matchedPrefix.value());
+    if (auto matchedEntry =
+            routeState_.unicastRoutesIndex.longestPrefixMatch(inputPrefix)) {
+      matchPrefixSet.insert(matchedEntry->second);
     }
   }
 
@@ -323,25 +355,47 @@ Fib::processRouteUpdates(thrift::RouteDatabaseDelta&& routeDelta) {
 
   // Add/Update unicast routes to update
   for (const auto& route : routeDelta.unicastRoutesToUpdate) {
-    routeState_.unicastRoutes[route.dest] = route;
+    auto& entry = routeState_.unicastRoutes[route.dest];
+    updateIfNameIndex(
+        routeState_.ifNameToPrefixes, route.dest, entry.nextHops, false);
+    entry = route;
+    updateIfNameIndex(
+        routeState_.ifNameToPrefixes, route.dest, route.nextHops, true);
+    routeState_.unicastRoutesIndex.insert(toIPNetwork(route.dest), route.dest);
     routeState_.dirtyPrefixes.erase(route.dest);
   }
 
   // Add mpls routes to update
   for (const auto& route : routeDelta.mplsRoutesToUpdate) {
-    routeState_.mplsRoutes[route.topLabel] = route;
+    auto& entry = routeState_.mplsRoutes[route.topLabel];
+    updateIfNameIndex(
+        routeState_.ifNameToLabels, route.topLabel, entry.nextHops, false);
+    entry = route;
+    updateIfNameIndex(
+        routeState_.ifNameToLabels, route.topLabel, route.nextHops, true);
     routeState_.dirtyLabels.erase(route.topLabel);
   }
 
   // Delete unicast routes
   for (const auto& dest : routeDelta.unicastRoutesToDelete) {
-    routeState_.unicastRoutes.erase(dest);
+    auto it = routeState_.unicastRoutes.find(dest);
+    if (it != routeState_.unicastRoutes.end()) {
+      updateIfNameIndex(
+          routeState_.ifNameToPrefixes, dest, it->second.nextHops, false);
+      routeState_.unicastRoutes.erase(it);
+    }
+    routeState_.unicastRoutesIndex.erase(toIPNetwork(dest));
     routeState_.dirtyPrefixes.erase(dest);
   }
 
   // Delete mpls routes
   for (const auto& topLabel : routeDelta.mplsRoutesToDelete) {
-    routeState_.mplsRoutes.erase(topLabel);
+    auto it = routeState_.mplsRoutes.find(topLabel);
+    if (it != routeState_.mplsRoutes.end()) {
+      updateIfNameIndex(
+          routeState_.ifNameToLabels, topLabel, it->second.nextHops, false);
+      routeState_.mplsRoutes.erase(it);
+    }
     routeState_.dirtyLabels.erase(topLabel);
   }
 
@@ -363,11 +417,16 @@ Fib::processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb) {
   //
   // Update interface states
   //
+  std::unordered_set<std::string> changedIfNames;
   for (auto const& kv : interfaceDb.interfaces) {
     const auto& ifName = kv.first;
     const auto isUp = kv.second.isUp;
     const auto wasUp = folly::get_default(interfaceStatusDb_, ifName, false);
 
+    if (wasUp != isUp) {
+      changedIfNames.emplace(ifName);
+    }
+
     // UP -> DOWN transition
     if (wasUp and not isUp) {
       LOG(INFO) << "Interface " << ifName << " transitioned from UP -> DOWN";
@@ -381,14 +440,37 @@ Fib::processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb) {
     interfaceStatusDb_[ifName] = isUp;
   }
 
+  //
+  // Collect routes to re-evaluate. Routes over interfaces whose status changed
+  // and routes over interfaces which are not up, as Decision may have
+  // programmed them over an interface already down or never reported. Rest of
+  // the routes are unaffected by this update
+  //
+  auto const isAffected = [&](std::string const& ifName) {
+    return changedIfNames.count(ifName) or
+        not folly::get_default(interfaceStatusDb_, ifName, false);
+  };
+  std::unordered_set<thrift::IpPrefix> affectedPrefixes;
+  for (auto const& [ifName, prefixes] : routeState_.ifNameToPrefixes) {
+    if (isAffected(ifName)) {
+      affectedPrefixes.insert(prefixes.begin(), prefixes.end());
+    }
+  }
+  std::unordered_set<uint32_t> affectedLabels;
+  for (auto const& [ifName, labels] : routeState_.ifNameToLabels) {
+    if (isAffected(ifName)) {
+      affectedLabels.insert(labels.begin(), labels.end());
+    }
+  }
+
   thrift::RouteDatabaseDelta routeDbDelta;
   routeDbDelta.perfEvents_ref().move_from(interfaceDb.perfEvents_ref());
 
   //
   // Compute unicast route changes
   //
-  for (auto const& kv : routeState_.unicastRoutes) {
-    auto const& route = kv.second;
+  for (auto const& prefix : affectedPrefixes) {
+    auto const& route = routeState_.unicastRoutes.at(prefix);
 
     // Find valid nexthops for route
     std::vector<thrift::NextHopThrift> validNextHops;
@@ -430,13 +512,13 @@ Fib::processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb) {
       routeDbDelta.unicastRoutesToUpdate.emplace_back(route);
       routeState_.dirtyPrefixes.erase(route.dest); // Remove from dirty list
     }
-  } // end for ... routeDb_.unicastRoutes
+  } // end for ... affectedPrefixes
 
   //
   // Compute MPLS route changes
   //
-  for (const auto& kv : routeState_.mplsRoutes) {
-    const auto& route = kv.second;
+  for (const auto& label : affectedLabels) {
+    const auto& route = routeState_.mplsRoutes.at(label);
 
     // Find valid nexthops for route
     std::vector<thrift::NextHopThrift> validNextHops;
@@ -479,7 +561,7 @@ Fib::processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb) {
       routeDbDelta.mplsRoutesToUpdate.emplace_back(route);
       routeState_.dirtyLabels.erase(route.topLabel); // Remove from dirty list
     }
-  } // end for ... routeDb_.mplsRoutes
+  } // end for ... affectedLabels
 
   updateRoutes(routeDbDelta);
 }
@@ -18,6 +18,7 @@
 
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/PrefixTrie.h>
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
 #include <openr/decision/RouteUpdate.h>
@@ -83,6 +84,9 @@ class Fib final : public OpenrEventBase {
    * @param unicastRoutes - current unicast routes in RouteDatabase
    *
    * @return the matched IpPrefix if prefix matching succeed.
+   *
+   * NOTE: This scans all routes. Fib itself performs lookups on the prefix
+   * trie maintained along with its route state.
    */
   static std::optional<thrift::IpPrefix> longestPrefixMatch(
       const folly::CIDRNetwork& inputPrefix,
@@ -126,6 +130,8 @@ class Fib final : public OpenrEventBase {
   /**
    * Process interface status information from LinkMonitor. We remove all
    * routes associated with interface if we detect that it just went down.
+   * Only routes with nexthops over interfaces whose status changed are
+   * re-evaluated.
    */
   void processInterfaceDb(thrift::InterfaceDatabase&& interfaceDb);
 
@@ -185,6 +191,18 @@ class Fib final : public OpenrEventBase {
     std::unordered_map<thrift::IpPrefix, thrift::UnicastRoute> unicastRoutes;
     std::unordered_map<uint32_t, thrift::MplsRoute> mplsRoutes;
 
+    // Index of unicastRoutes keys for longest prefix match and subtree
+    // lookups. Must be updated along with unicastRoutes
+    PrefixTrie<thrift::IpPrefix> unicastRoutesIndex;
+
+    // Reverse index of nexthop interface to routes using it. Lets interface
+    // events touch only affected routes. Must be updated along with
+    // unicastRoutes and mplsRoutes
+    std::unordered_map<std::string, std::unordered_set<thrift::IpPrefix>>
+        ifNameToPrefixes;
+    std::unordered_map<std::string, std::unordered_set<uint32_t>>
+        ifNameToLabels;
+
     // indicates we've received a decision route publication and therefore have
     // routes to sync. will not synce routes with system until this is set
     bool hasRoutesFromDecision{false};
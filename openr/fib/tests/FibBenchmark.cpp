@@ -15,6 +15,7 @@
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <thrift/lib/cpp2/util/ScopedServerThread.h>
 
+#include <openr/common/PrefixTrie.h>
 #include <openr/config/Config.h>
 #include <openr/config/tests/Utils.h>
 #include <openr/fib/Fib.h>
@@ -55,6 +56,10 @@ static const long kBitMaskLen = 128;
 static const uint32_t kDeltaSize = 10;
 // Number of nexthops
 const uint8_t kNumOfNexthops = 128;
+// Number of longest prefix match lookups per iteration
+const uint32_t kNumOfLpmQueries = 1000;
+// Number of interfaces nexthops are spread over
+const uint32_t kNumOfInterfaces = 16;
 
 } // anonymous namespace
 
@@ -272,12 +277,170 @@ BM_Fib(folly::UserCounters& counters, uint32_t iters, unsigned numOfPrefixes) {
   counters["route_install"] = processTimes[2];
 }
 
+/**
+ * Benchmark for longest prefix match lookups as performed by Fib for
+ * getUnicastRoutesFiltered()
+ * 1. Generate routes of mixed prefix lengths and index them
+ * 2. Look up kNumOfLpmQueries host addresses within the routes
+ */
+static std::pair<
+    std::vector<thrift::IpPrefix>,
+    std::vector<folly::CIDRNetwork>>
+generateLpmRoutesAndQueries(unsigned numOfRoutes) {
+  std::vector<thrift::IpPrefix> routes;
+  routes.reserve(numOfRoutes);
+  for (auto const len : {48, 56, 64, 128}) {
+    auto prefixes = PrefixGenerator::ipv6PrefixGenerator(numOfRoutes / 4, len);
+    routes.insert(routes.end(), prefixes.begin(), prefixes.end());
+  }
+
+  std::vector<folly::CIDRNetwork> queries;
+  queries.reserve(kNumOfLpmQueries);
+  for (uint32_t i = 0; i < kNumOfLpmQueries; ++i) {
+    auto const& route = routes.at(i * routes.size() / kNumOfLpmQueries);
+    queries.emplace_back(toIPNetwork(route).first, kBitMaskLen);
+  }
+  return {std::move(routes), std::move(queries)};
+}
+
+static void
+BM_FibLongestPrefixMatch(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto const [routes, queries] = generateLpmRoutesAndQueries(numOfRoutes);
+  PrefixTrie<thrift::IpPrefix> routesIndex;
+  for (auto const& route : routes) {
+    routesIndex.insert(toIPNetwork(route), route);
+  }
+  suspender.dismiss(); // Start measuring benchmark time
+
+  size_t numOfMatches{0};
+  for (uint32_t i = 0; i < iters; i++) {
+    for (auto const& query : queries) {
+      auto const* match = routesIndex.longestPrefixMatch(query);
+      folly::doNotOptimizeAway(match);
+      numOfMatches += match ? 1 : 0;
+    }
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  counters["num_routes"] = routesIndex.size();
+  counters["matches"] = numOfMatches / (iters == 0 ? 1 : iters);
+}
+
+/**
+ * Baseline for BM_FibLongestPrefixMatch using linear scan over routes
+ */
+static void
+BM_FibLongestPrefixMatchLinear(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto const [routes, queries] = generateLpmRoutesAndQueries(numOfRoutes);
+  std::unordered_map<thrift::IpPrefix, thrift::UnicastRoute> unicastRoutes;
+  for (auto const& route : routes) {
+    unicastRoutes[route].dest = route;
+  }
+  suspender.dismiss(); // Start measuring benchmark time
+
+  size_t numOfMatches{0};
+  for (uint32_t i = 0; i < iters; i++) {
+    for (auto const& query : queries) {
+      auto const match = Fib::longestPrefixMatch(query, unicastRoutes);
+      folly::doNotOptimizeAway(match);
+      numOfMatches += match.has_value() ? 1 : 0;
+    }
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  counters["num_routes"] = unicastRoutes.size();
+  counters["matches"] = numOfMatches / (iters == 0 ? 1 : iters);
+}
+
+/**
+ * Benchmark for interface down event processing
+ * 1. Create a fib with routes spread over kNumOfInterfaces interfaces. Each
+ *    route has nexthops over two interfaces
+ * 2. Bring one interface down and wait for Fib to shrink affected routes
+ * 3. Bring the interface back up (not measured)
+ */
+static void
+BM_FibInterfaceDown(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfPrefixes) {
+  auto suspender = folly::BenchmarkSuspender();
+  // Fib starts with clean route database
+  auto fibWrapper = std::make_unique<FibWrapper>();
+
+  // Initial syncFib debounce
+  fibWrapper->mockFibHandler->waitForSyncFib();
+
+  // Bring up all interfaces
+  thrift::InterfaceDatabase intfDb;
+  intfDb.thisNodeName = "node-1";
+  for (uint32_t i = 0; i < kNumOfInterfaces; i++) {
+    intfDb.interfaces.emplace(
+        folly::sformat("iface{}", i), createThriftInterfaceInfo(true, i, {}));
+  }
+  fibWrapper->interfaceUpdatesQueue.push(intfDb);
+
+  // Generate routes with nexthops over two consecutive interfaces
+  auto prefixes = fibWrapper->prefixGenerator.ipv6PrefixGenerator(
+      numOfPrefixes, kBitMaskLen);
+  {
+    DecisionRouteUpdate routeUpdate;
+    for (size_t i = 0; i < prefixes.size(); i++) {
+      std::unordered_set<thrift::NextHopThrift> nhsSet;
+      for (auto const offset : {0, 1}) {
+        auto const intf = (i + offset) % kNumOfInterfaces;
+        nhsSet.emplace(createNextHop(
+            toBinaryAddress(folly::IPAddress(folly::sformat("fe80::{}", intf))),
+            folly::sformat("iface{}", intf)));
+      }
+      routeUpdate.unicastRoutesToUpdate.emplace_back(
+          RibUnicastEntry(toIPNetwork(prefixes[i]), nhsSet));
+    }
+    fibWrapper->routeUpdatesQueue.push(std::move(routeUpdate));
+  }
+  fibWrapper->mockFibHandler->waitForUpdateUnicastRoutes();
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto const ifName = folly::sformat("iface{}", i % kNumOfInterfaces);
+
+    // Interface down: affected routes shrink to single nexthop
+    intfDb.interfaces.at(ifName).isUp = false;
+    fibWrapper->interfaceUpdatesQueue.push(intfDb);
+    fibWrapper->mockFibHandler->waitForUpdateUnicastRoutes();
+
+    suspender.rehire(); // Stop measuring time again
+    // Interface up: affected routes restored
+    intfDb.interfaces.at(ifName).isUp = true;
+    fibWrapper->interfaceUpdatesQueue.push(intfDb);
+    fibWrapper->mockFibHandler->waitForUpdateUnicastRoutes();
+    suspender.dismiss(); // Start measuring benchmark time
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  counters["num_routes"] = prefixes.size();
+  counters["affected_routes"] = 2 * prefixes.size() / kNumOfInterfaces;
+}
+
 // The parameter is the number of prefixes sent to fib
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 10);
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 100);
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 1000);
 BENCHMARK_COUNTERS_PARAM(BM_Fib, counters, 9000);
 
+// The parameter is the number of routes to perform longest prefix match on
+BENCHMARK_COUNTERS_PARAM(BM_FibLongestPrefixMatch, counters, 10000);
+BENCHMARK_COUNTERS_PARAM(BM_FibLongestPrefixMatch, counters, 100000);
+BENCHMARK_COUNTERS_PARAM(BM_FibLongestPrefixMatch, counters, 1000000);
+BENCHMARK_COUNTERS_PARAM(BM_FibLongestPrefixMatchLinear, counters, 10000);
+
+// The parameter is the number of prefixes in fib on interface down
+BENCHMARK_COUNTERS_PARAM(BM_FibInterfaceDown, counters, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_FibInterfaceDown, counters, 10000);
+BENCHMARK_COUNTERS_PARAM(BM_FibInterfaceDown, counters, 100000);
+
 } // namespace openr
 
 int
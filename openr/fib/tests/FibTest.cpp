@@ -637,6 +637,80 @@ TEST_F(FibTestFixture, processInterfaceDbWithNoIfnameNexthop) {
   EXPECT_EQ(routes[0].nextHops.size(), 1);
 }
 
+// verify routes are re-evaluated on interface updates as per nexthop
+// interfaces, including routes programmed over interface which is down
+TEST_F(FibTestFixture, processInterfaceDbUpDown) {
+  // initial syncFib debounce
+  mockFibHandler->waitForSyncFib();
+  mockFibHandler->waitForSyncMplsFib();
+
+  const auto ifName1 = path1_2_1.address.ifName_ref().value();
+  const auto ifName2 = path1_2_2.address.ifName_ref().value();
+  auto createIntfDb = [&](bool isUp1, bool isUp2) {
+    thrift::InterfaceDatabase intfDb(
+        FRAGILE,
+        "node-1",
+        {
+            {ifName1, createThriftInterfaceInfo(isUp1, 121, {})},
+            {ifName2, createThriftInterfaceInfo(isUp2, 122, {})},
+        },
+        thrift::PerfEvents());
+    intfDb.perfEvents_ref().reset();
+    return intfDb;
+  };
+
+  // Routes over interfaces not reported yet are programmed as is
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.unicastRoutesToUpdate.emplace_back(
+        RibUnicastEntry(toIPNetwork(prefix1), {path1_2_1}));
+    routeUpdate.unicastRoutesToUpdate.emplace_back(
+        RibUnicastEntry(toIPNetwork(prefix2), {path1_2_2}));
+    routeUpdatesQueue.push(std::move(routeUpdate));
+  }
+  mockFibHandler->waitForUpdateUnicastRoutes();
+  EXPECT_EQ(mockFibHandler->getAddRoutesCount(), 2);
+
+  // Only first interface comes up. Route over second interface, which is
+  // down without having changed state, gets removed
+  interfaceUpdatesQueue.push(createIntfDb(true, false));
+  mockFibHandler->waitForDeleteUnicastRoutes();
+  EXPECT_EQ(mockFibHandler->getAddRoutesCount(), 2);
+  EXPECT_EQ(mockFibHandler->getDelRoutesCount(), 1);
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  ASSERT_EQ(routes.size(), 1);
+  EXPECT_EQ(routes.at(0).dest, prefix1);
+
+  // Second interface comes up. Route over it is restored
+  interfaceUpdatesQueue.push(createIntfDb(true, true));
+  mockFibHandler->waitForUpdateUnicastRoutes();
+  EXPECT_EQ(mockFibHandler->getAddRoutesCount(), 3);
+  EXPECT_EQ(mockFibHandler->getDelRoutesCount(), 1);
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(routes.size(), 2);
+
+  // Move route of prefix1 to second interface
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.unicastRoutesToUpdate.emplace_back(
+        RibUnicastEntry(toIPNetwork(prefix1), {path1_2_2}));
+    routeUpdatesQueue.push(std::move(routeUpdate));
+  }
+  mockFibHandler->waitForUpdateUnicastRoutes();
+  EXPECT_EQ(mockFibHandler->getAddRoutesCount(), 4);
+
+  // First interface going down doesn't affect any route anymore. Second
+  // interface going down removes both routes
+  interfaceUpdatesQueue.push(createIntfDb(false, true));
+  interfaceUpdatesQueue.push(createIntfDb(false, false));
+  mockFibHandler->waitForDeleteUnicastRoutes();
+  EXPECT_EQ(mockFibHandler->getAddRoutesCount(), 4);
+  EXPECT_EQ(mockFibHandler->getDelRoutesCount(), 3);
+  mockFibHandler->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(routes.size(), 0);
+}
+
 TEST_F(FibTestFixture, basicAddAndDelete) {
   // Make sure fib starts with clean route database
   std::vector<thrift::UnicastRoute> routes;
@@ -107,6 +107,11 @@ struct KeyDumpParams {
   // kinds of updates. For example, a consumer might be interesred in
   // getting "adj:.*" keys from open/r domain.
   5: optional list<string> keys;
+
+  // optional hash summary of peer's KvStore, one hash per key bucket. If set,
+  // respond ONLY with keyVals in buckets on which hash differs (see
+  // Publication.syncBuckets). Filters are ignored for such requests.
+  7: optional list<i64> keyValHashBuckets
 }
 
 // Peer's publication and command socket URLs
@@ -124,6 +129,9 @@ struct PeerSpec {
 
   // thrift port
   4: i32 ctrlPort = 0
+
+  // peer accepts zstd compressed KvStore requests and responses over ZMQ
+  5: bool supportCompression = 0
 }
 
 typedef map<string, PeerSpec>
@@ -219,6 +227,14 @@ struct KvStoreRequest {
   6: optional KeyDumpParams keyDumpParams
   9: optional Dual.DualMessages dualMessages
   10: optional FloodTopoSetParams floodTopoSetParams
+
+  // zstd compressed KvStoreRequest. If set, request is decoded from it and
+  // all other attributes are ignored. Only sent to peers supporting it
+  12: optional binary compressedRequest
+
+  // requester accepts compressed KEY_DUMP response (see
+  // Publication.compressedPublication)
+  13: bool compressResponse = 0
 }
 
 //
@@ -246,4 +262,14 @@ struct Publication {
 
   // area to which this publication belogs
   7: string area = kDefaultArea;
+
+  // key buckets on which hash summary differs. This is only used for
+  // full-sync response to keyValHashBuckets request. keyVals contains all
+  // responder's keys in these buckets, initiator sends back its better keys
+  8: optional list<i32> syncBuckets;
+
+  // zstd compressed Publication. If set, publication is decoded from it and
+  // all other attributes are ignored. Only sent in response to requests with
+  // KvStoreRequest.compressResponse
+  9: optional binary compressedPublication;
 }
@@ -30,6 +30,19 @@ struct KvstoreConfig {
   # flood optimization
   8: optional bool enable_flood_optimization
   9: optional bool is_flood_root
+
+  # exchange hash summary of key buckets instead of per key hashes on full
+  # sync. Requires peers to support it
+  10: optional bool enable_hash_bucket_sync
+
+  # run KvStoreDb of every area on its own event base thread instead of
+  # sharing the KvStore thread. Areas are then processed in parallel
+  11: optional bool enable_per_area_threads
+
+  # zstd compress large KvStore messages exchanged with peers over ZMQ, e.g.
+  # flooding and full sync. Applied only towards peers advertising support
+  # for it in their Spark handshake
+  12: optional bool enable_compression
 }
 
 struct LinkMonitorConfig {
@@ -39,6 +52,13 @@ struct LinkMonitorConfig {
   4: list<string> include_interface_regexes = []
   5: list<string> exclude_interface_regexes = []
   6: list<string> redistribute_interface_regexes = []
+  # Advertise every adjacency under its own `adjacency:<node>:<peer>:<ifName>`
+  # key instead of a single full AdjacencyDatabase per node. Reduces flooding
+  # on metric changes for nodes with many adjacencies. Decision understands
+  # both encodings, while older versions ignore per adjacency keys and would
+  # see the node without adjacencies. Enable only once every node in the area
+  # runs a version supporting them. Disabled by default
+  7: bool enable_per_adjacency_keys = false
 }
 
 struct StepDetectorConfig {
@@ -232,6 +252,16 @@ struct OpenrConfig {
   26: bool enable_kvstore_thrift = 0
   27: bool enable_periodic_sync = 1
 
+  # Incrementally repair cached SPF results in Decision on link up/down and
+  # metric changes instead of re-running full SPF.
+  # Disabled by default
+  28: bool enable_incremental_spf = 0
+
+  # Number of worker threads Decision shards per-prefix route selection
+  # across. Useful with large number of prefixes (e.g. BGP route reflectors).
+  # 0 or 1 computes routes inline on Decision thread
+  29: i32 decision_route_build_threads = 0
+
   # bgp
   100: optional bool enable_bgp_peering
   102: optional BgpConfig.BgpConfig bgp_config
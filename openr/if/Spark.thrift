@@ -104,6 +104,9 @@ struct SparkHandshakeMsg {
   // TODO: Remove optional qualifier after AREA negotiation
   //       is fully in use
   11: optional string neighborNodeName
+
+  // support decompressing KvStore messages or not
+  12: bool supportCompression = 0
 }
 
 //
@@ -164,6 +167,8 @@ struct SparkNeighborEvent {
   6: bool supportFloodOptimization = 0
   // area ID
   7: string area = KvStore.kDefaultArea
+  // support KvStore message compression or not
+  8: bool supportCompression = 0
 }
 
 //
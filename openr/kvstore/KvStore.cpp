@@ -14,6 +14,10 @@
 #include <folly/GLog.h>
 #include <folly/Random.h>
 #include <folly/String.h>
+#include <folly/hash/Hash.h>
+#include <folly/io/Compression.h>
+#include <folly/io/IOBufQueue.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/Util.h>
@@ -58,6 +62,7 @@ KvStoreFilters::KvStoreFilters(
     std::set<std::string> const& nodeIds)
     : keyPrefixList_(keyPrefix),
       originatorIds_(nodeIds),
+      originatorIdSet_(nodeIds.begin(), nodeIds.end()),
       keyPrefixObjList_(KeyPrefix(keyPrefixList_)) {}
 
 bool
@@ -69,7 +74,8 @@ KvStoreFilters::keyMatchAny(
   if (!keyPrefixList_.empty() && keyPrefixObjList_.keyMatch(key)) {
     return true;
   }
-  if (!originatorIds_.empty() && originatorIds_.count(value.originatorId)) {
+  if (!originatorIdSet_.empty() &&
+      originatorIdSet_.count(value.originatorId)) {
     return true;
   }
   return false;
@@ -100,7 +106,8 @@ KvStoreFilters::keyMatchAll(
     return false;
   }
 
-  if (!originatorIds_.empty() && not originatorIds_.count(value.originatorId)) {
+  if (!originatorIdSet_.empty() &&
+      not originatorIdSet_.count(value.originatorId)) {
     return false;
   }
 
@@ -131,10 +138,52 @@ KvStoreFilters::str() const {
   return result;
 }
 
+KvStoreHashBuckets::KvStoreHashBuckets()
+    : bucketHashes_(Constants::kNumOfKvStoreSyncBuckets, 0) {}
+
+size_t
+KvStoreHashBuckets::getBucket(std::string const& key) {
+  // NOTE: Must be consistent across nodes, std::hash is not
+  return folly::hash::fnv64(key) % Constants::kNumOfKvStoreSyncBuckets;
+}
+
+int64_t
+KvStoreHashBuckets::getDigest(
+    std::string const& key, thrift::Value const& value) {
+  const int64_t valueHash = value.hash_ref().value_or(0);
+  auto digest = folly::hash::fnv64(key);
+  digest = folly::hash::fnv64_buf(
+      &value.version, sizeof(value.version), digest);
+  digest = folly::hash::fnv64(value.originatorId, digest);
+  // NOTE: ttlVersion is left out. TTL refreshes must not make buckets differ
+  // while they propagate
+  digest = folly::hash::fnv64_buf(&valueHash, sizeof(valueHash), digest);
+  return static_cast<int64_t>(digest);
+}
+
+void
+KvStoreHashBuckets::toggle(
+    std::string const& key, thrift::Value const& value) {
+  bucketHashes_.at(getBucket(key)) ^= getDigest(key, value);
+}
+
+std::vector<bool>
+KvStoreHashBuckets::getMismatchedBuckets(
+    std::vector<int64_t> const& bucketHashes) const {
+  if (bucketHashes.size() != bucketHashes_.size()) {
+    return std::vector<bool>(bucketHashes_.size(), true);
+  }
+  std::vector<bool> mismatched(bucketHashes_.size(), false);
+  for (size_t i = 0; i < bucketHashes_.size(); ++i) {
+    mismatched[i] = bucketHashes_[i] != bucketHashes[i];
+  }
+  return mismatched;
+}
+
 KvStore::KvStore(
     // initializers for immutable state
     fbzmq::Context& zmqContext,
-    messaging::ReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue,
+    messaging::SharedReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue,
     messaging::RQueue<thrift::PeerUpdateRequest> peerUpdateQueue,
     KvStoreGlobalCmdUrl globalCmdUrl,
     MonitorSubmitUrl monitorSubmitUrl,
@@ -168,12 +217,19 @@ KvStore::KvStore(
   zmqMonitorClient_ =
       std::make_shared<fbzmq::ZmqMonitorClient>(zmqContext, monitorSubmitUrl);
   kvParams_.zmqMonitorClient = zmqMonitorClient_;
+  kvParams_.enableHashBucketSync =
+      config->getKvStoreConfig().enable_hash_bucket_sync_ref().value_or(false);
 
-  // Schedule periodic timer for counters submission
+  // Schedule periodic timer for counters submission. Counters are collected
+  // from KvStoreDb instances asynchronously as they may run on other threads
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
-    for (auto& counter : getGlobalCounters()) {
-      fb303::fbData->setCounter(counter.first, counter.second);
-    }
+    folly::futures::detachOn(
+        folly::getKeepAliveToken(getEvb()),
+        getCounters().deferValue([](std::map<std::string, int64_t>&& counters) {
+          for (auto& counter : counters) {
+            fb303::fbData->setCounter(counter.first, counter.second);
+          }
+        }));
     counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
   });
   counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
@@ -223,13 +279,23 @@ KvStore::KvStore(
     }
   });
 
-  // create KvStoreDb instances
+  // create KvStoreDb instances. With per area threads every instance gets its
+  // own event base and monitor client as neither can be shared across threads
+  const bool enablePerAreaThreads =
+      config->getKvStoreConfig().enable_per_area_threads_ref().value_or(false);
   for (auto const& area : areas_) {
+    OpenrEventBase* evb = this;
+    std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient{nullptr};
+    if (enablePerAreaThreads) {
+      evb = areaEvbs_.emplace(area, std::make_unique<OpenrEventBase>())
+                .first->second.get();
+      zmqMonitorClient = std::make_shared<fbzmq::ZmqMonitorClient>(
+          zmqContext, monitorSubmitUrl);
+    }
     kvStoreDb_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(area),
-        std::forward_as_tuple(
-            this,
+        area,
+        std::make_unique<KvStoreDb>(
+            evb,
             kvParams_,
             area,
             fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_CLIENT>(
@@ -239,8 +305,25 @@ KvStore::KvStore(
                 folly::none,
                 fbzmq::NonblockingFlag{true}),
             config->getKvStoreConfig().is_flood_root_ref().value_or(false),
-            config->getNodeName()));
+            config->getNodeName(),
+            std::move(zmqMonitorClient)));
+  }
+}
+
+void
+KvStore::run() {
+  // Start per area event bases before serving any request
+  for (auto& [area, evb] : areaEvbs_) {
+    areaThreads_.emplace_back([area = area, evb = evb.get()]() {
+      LOG(INFO) << "Starting KvStoreDb thread for area " << area;
+      evb->run();
+      LOG(INFO) << "KvStoreDb thread for area " << area << " stopped";
+    });
+    evb->waitUntilRunning();
   }
+
+  // Invoke run method of super class
+  OpenrEventBase::run();
 }
 
 void
@@ -248,160 +331,298 @@ KvStore::stop() {
   getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait([this]() {
     // NOTE: destructor of every instance inside `kvStoreDb_` will gracefully
     //       exit and wait for all pending thrift requests to be processed
-    //       before eventbase stops.
-    kvStoreDb_.clear();
+    //       before eventbase stops. Every instance is destroyed within the
+    //       thread of its event base. The map itself is left intact as other
+    //       event bases may still look up their area in it.
+    for (auto& [area, kvStoreDb] : kvStoreDb_) {
+      getAreaEvb(area)->getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait(
+          [&kvStoreDb = kvStoreDb]() { kvStoreDb.reset(); });
+    }
   });
 
+  // Stop per area event bases
+  for (auto& [_, evb] : areaEvbs_) {
+    evb->stop();
+  }
+  for (auto& thread : areaThreads_) {
+    thread.join();
+  }
+  areaThreads_.clear();
+
+  // No other event base is running KvStoreDb code anymore
+  getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait(
+      [this]() { kvStoreDb_.clear(); });
+
   // Invoke stop method of super class
   OpenrEventBase::stop();
 }
 
-// static, public
-std::unordered_map<std::string, thrift::Value>
-KvStore::mergeKeyValues(
-    std::unordered_map<std::string, thrift::Value>& kvStore,
-    std::unordered_map<std::string, thrift::Value> const& keyVals,
-    std::optional<KvStoreFilters> const& filters) {
-  // the publication to build if we update our KV store
-  std::unordered_map<std::string, thrift::Value> kvUpdates;
+OpenrEventBase*
+KvStore::getAreaEvb(std::string const& area) {
+  auto it = areaEvbs_.find(area);
+  return it != areaEvbs_.end() ? it->second.get() : this;
+}
 
-  // Counters for logging
-  uint32_t ttlUpdateCnt{0}, valUpdateCnt{0};
+KvStoreDb*
+KvStore::getAreaDb(std::string const& area) {
+  auto it = kvStoreDb_.find(area);
+  return it != kvStoreDb_.end() ? it->second.get() : nullptr;
+}
 
-  for (const auto& [key, value] : keyVals) {
-    if (filters.has_value() && not filters->keyMatch(key, value)) {
-      VLOG(4) << "key: " << key << " not adding from " << value.originatorId;
-      continue;
-    }
+namespace {
 
-    // versions must start at 1; setting this to zero here means
-    // we would be beaten by any version supplied by the setter
-    int64_t myVersion{0};
-    int64_t newVersion = value.version;
+/**
+ * Serialize request into a single buffer sized upfront. ZMQ message needs
+ * contiguous data and this avoids coalescing (copying) a chain of buffers
+ */
+std::unique_ptr<folly::IOBuf>
+serializeToSingleBuffer(thrift::KvStoreRequest const& request) {
+  apache::thrift::CompactProtocolWriter writer;
+  folly::IOBufQueue queue(folly::IOBufQueue::cacheChainLength());
+  writer.setOutput(&queue, request.serializedSize(&writer));
+  request.write(&writer);
+  auto buf = queue.move();
+  DCHECK(not buf->isChained());
+  return buf;
+}
 
-    // Check if TTL is valid. It must be infinite or positive number
-    // Skip if invalid!
-    if (value.ttl != Constants::kTtlInfinity && value.ttl <= 0) {
-      continue;
-    }
+/**
+ * Wrap serialized request into a request carrying it compressed. Command and
+ * area are retained for dispatching and logging
+ */
+thrift::KvStoreRequest
+createCompressedRequest(
+    thrift::KvStoreRequest const& request, folly::ByteRange serializedRequest) {
+  thrift::KvStoreRequest compressedRequest;
+  compressedRequest.cmd = request.cmd;
+  compressedRequest.area = request.area;
+  compressedRequest.compressedRequest_ref() =
+      KvStore::compressPayload(serializedRequest);
+  return compressedRequest;
+}
 
-    // if key exist, compare values first
-    // if they are the same, no need to propagate changes
-    auto kvStoreIt = kvStore.find(key);
-    if (kvStoreIt != kvStore.end()) {
-      myVersion = kvStoreIt->second.version;
-    } else {
-      VLOG(4) << "(mergeKeyValues) key: '" << key << "' not found, adding";
-    }
+/**
+ * Merge a single key-value into kvStore. Incoming value is copied into the
+ * store only if it's accepted. Returns true if value needs to be announced
+ */
+bool
+mergeKeyValue(
+    std::unordered_map<std::string, thrift::Value>& kvStore,
+    std::string const& key,
+    thrift::Value const& value,
+    std::optional<KvStoreFilters> const& filters,
+    KvStoreHashBuckets* hashBuckets,
+    uint32_t& ttlUpdateCnt,
+    uint32_t& valUpdateCnt) {
+  if (filters.has_value() && not filters->keyMatch(key, value)) {
+    VLOG(4) << "key: " << key << " not adding from " << value.originatorId;
+    return false;
+  }
 
-    // If we get an old value just skip it
-    if (newVersion < myVersion) {
-      continue;
-    }
+  // versions must start at 1; setting this to zero here means
+  // we would be beaten by any version supplied by the setter
+  int64_t myVersion{0};
+  int64_t newVersion = value.version;
 
-    bool updateAllNeeded{false};
-    bool updateTtlNeeded{false};
+  // Check if TTL is valid. It must be infinite or positive number
+  // Skip if invalid!
+  if (value.ttl != Constants::kTtlInfinity && value.ttl <= 0) {
+    return false;
+  }
 
-    //
-    // Check updateAll and updateTtl
-    //
-    if (value.value_ref().has_value()) {
-      if (newVersion > myVersion) {
-        // Version is newer or
-        // kvStoreIt is NULL(myVersion is set to 0)
-        updateAllNeeded = true;
-      } else if (value.originatorId > kvStoreIt->second.originatorId) {
-        // versions are the same but originatorId is higher
+  // if key exist, compare values first
+  // if they are the same, no need to propagate changes
+  auto kvStoreIt = kvStore.find(key);
+  if (kvStoreIt != kvStore.end()) {
+    myVersion = kvStoreIt->second.version;
+  } else {
+    VLOG(4) << "(mergeKeyValues) key: '" << key << "' not found, adding";
+  }
+
+  // If we get an old value just skip it
+  if (newVersion < myVersion) {
+    return false;
+  }
+
+  bool updateAllNeeded{false};
+  bool updateTtlNeeded{false};
+
+  //
+  // Check updateAll and updateTtl
+  //
+  if (value.value_ref().has_value()) {
+    if (newVersion > myVersion) {
+      // Version is newer or
+      // kvStoreIt is NULL(myVersion is set to 0)
+      updateAllNeeded = true;
+    } else if (value.originatorId > kvStoreIt->second.originatorId) {
+      // versions are the same but originatorId is higher
+      updateAllNeeded = true;
+    } else if (value.originatorId == kvStoreIt->second.originatorId) {
+      // This can occur after kvstore restarts or simply reconnects after
+      // disconnection. We let one of the two values win if they
+      // differ(higher in this case but can be lower as long as it's
+      // deterministic). Otherwise, local store can have new value while
+      // other stores have old value and they never sync.
+      //
+      // Hash is generated once when value enters KvStore. Like in
+      // compareValues, equal hash (and size) of same version and originator
+      // means equal value. Skip byte-wise compare of potentially large values
+      auto const& myValue = kvStoreIt->second;
+      const bool sameHash = value.hash_ref().has_value() and
+          myValue.hash_ref().has_value() and
+          *value.hash_ref() == *myValue.hash_ref() and
+          value.value_ref()->size() == myValue.value_ref()->size();
+      int rc{0};
+      if (not sameHash) {
+        rc = (*value.value_ref()).compare(*myValue.value_ref());
+      }
+      if (rc > 0) {
+        // versions and orginatorIds are same but value is higher
+        VLOG(3) << "Previous incarnation reflected back for key " << key;
         updateAllNeeded = true;
-      } else if (value.originatorId == kvStoreIt->second.originatorId) {
-        // This can occur after kvstore restarts or simply reconnects after
-        // disconnection. We let one of the two values win if they
-        // differ(higher in this case but can be lower as long as it's
-        // deterministic). Otherwise, local store can have new value while
-        // other stores have old value and they never sync.
-        int rc = (*value.value_ref()).compare(*kvStoreIt->second.value_ref());
-        if (rc > 0) {
-          // versions and orginatorIds are same but value is higher
-          VLOG(3) << "Previous incarnation reflected back for key " << key;
-          updateAllNeeded = true;
-        } else if (rc == 0) {
-          // versions, orginatorIds, value are all same
-          // retain higher ttlVersion
-          if (value.ttlVersion > kvStoreIt->second.ttlVersion) {
-            updateTtlNeeded = true;
-          }
+      } else if (rc == 0) {
+        // versions, orginatorIds, value are all same
+        // retain higher ttlVersion
+        if (value.ttlVersion > kvStoreIt->second.ttlVersion) {
+          updateTtlNeeded = true;
         }
       }
     }
+  }
+
+  //
+  // Check updateTtl
+  //
+  if (not value.value_ref().has_value() and kvStoreIt != kvStore.end() and
+      value.version == kvStoreIt->second.version and
+      value.originatorId == kvStoreIt->second.originatorId and
+      value.ttlVersion > kvStoreIt->second.ttlVersion) {
+    updateTtlNeeded = true;
+  }
+
+  if (!updateAllNeeded and !updateTtlNeeded) {
+    VLOG(3) << "(mergeKeyValues) no need to update anything for key: '" << key
+            << "'";
+    return false;
+  }
 
+  VLOG(3) << "Updating key: " << key << "\n  Version: " << myVersion << " -> "
+          << newVersion << "\n  Originator: "
+          << (kvStoreIt != kvStore.end() ? kvStoreIt->second.originatorId
+                                         : "null")
+          << " -> " << value.originatorId << "\n  TtlVersion: "
+          << (kvStoreIt != kvStore.end() ? kvStoreIt->second.ttlVersion : 0)
+          << " -> " << value.ttlVersion << "\n  Ttl: "
+          << (kvStoreIt != kvStore.end() ? kvStoreIt->second.ttl : 0)
+          << " -> " << value.ttl;
+
+  // remove old key-value from hash summary, updated one is added below
+  if (hashBuckets and kvStoreIt != kvStore.end()) {
+    hashBuckets->toggle(key, kvStoreIt->second);
+  }
+
+  if (updateAllNeeded) {
+    ++valUpdateCnt;
+    FB_LOG_EVERY_MS(INFO, 500)
+        << "Updating key: " << key << ", Originator: " << value.originatorId
+        << ", Version: " << newVersion << ", TtlVersion: " << value.ttlVersion
+        << ", Ttl: " << value.ttl;
     //
-    // Check updateTtl
+    // update everything for such key
     //
-    if (not value.value_ref().has_value() and kvStoreIt != kvStore.end() and
-        value.version == kvStoreIt->second.version and
-        value.originatorId == kvStoreIt->second.originatorId and
-        value.ttlVersion > kvStoreIt->second.ttlVersion) {
-      updateTtlNeeded = true;
+    CHECK(value.value_ref().has_value());
+    if (kvStoreIt == kvStore.end()) {
+      // create new entry (this will copy, intended)
+      std::tie(kvStoreIt, std::ignore) = kvStore.emplace(key, value);
+    } else {
+      // update the entry in place, the old value will be destructed
+      kvStoreIt->second = value;
     }
-
-    if (!updateAllNeeded and !updateTtlNeeded) {
-      VLOG(3) << "(mergeKeyValues) no need to update anything for key: '" << key
-              << "'";
-      continue;
+    // update hash if it's not there
+    if (not kvStoreIt->second.hash_ref().has_value()) {
+      kvStoreIt->second.hash_ref() =
+          generateHash(value.version, value.originatorId, value.value_ref());
     }
+  } else if (updateTtlNeeded) {
+    ++ttlUpdateCnt;
+    //
+    // update ttl,ttlVersion only
+    //
+    CHECK(kvStoreIt != kvStore.end());
 
-    VLOG(3) << "Updating key: " << key << "\n  Version: " << myVersion << " -> "
-            << newVersion << "\n  Originator: "
-            << (kvStoreIt != kvStore.end() ? kvStoreIt->second.originatorId
-                                           : "null")
-            << " -> " << value.originatorId << "\n  TtlVersion: "
-            << (kvStoreIt != kvStore.end() ? kvStoreIt->second.ttlVersion : 0)
-            << " -> " << value.ttlVersion << "\n  Ttl: "
-            << (kvStoreIt != kvStore.end() ? kvStoreIt->second.ttl : 0)
-            << " -> " << value.ttl;
-
-    // grab the new value (this will copy, intended)
-    thrift::Value newValue = value;
-
-    if (updateAllNeeded) {
-      ++valUpdateCnt;
-      FB_LOG_EVERY_MS(INFO, 500)
-          << "Updating key: " << key << ", Originator: " << value.originatorId
-          << ", Version: " << newVersion << ", TtlVersion: " << value.ttlVersion
-          << ", Ttl: " << value.ttl;
-      //
-      // update everything for such key
-      //
-      CHECK(value.value_ref().has_value());
-      if (kvStoreIt == kvStore.end()) {
-        // create new entry
-        std::tie(kvStoreIt, std::ignore) = kvStore.emplace(
-            std::piecewise_construct,
-            std::forward_as_tuple(key),
-            std::forward_as_tuple(std::move(newValue)));
-      } else {
-        // update the entry in place, the old value will be destructed
-        kvStoreIt->second = std::move(newValue);
-      }
-      // update hash if it's not there
-      if (not kvStoreIt->second.hash_ref().has_value()) {
-        kvStoreIt->second.hash_ref() =
-            generateHash(value.version, value.originatorId, value.value_ref());
-      }
-    } else if (updateTtlNeeded) {
-      ++ttlUpdateCnt;
-      //
-      // update ttl,ttlVersion only
-      //
-      CHECK(kvStoreIt != kvStore.end());
+    // update TTL only, nothing else
+    kvStoreIt->second.ttl = value.ttl;
+    kvStoreIt->second.ttlVersion = value.ttlVersion;
+  }
+
+  if (hashBuckets) {
+    hashBuckets->toggle(key, kvStoreIt->second);
+  }
+  return true;
+}
+
+} // namespace
+
+// static, public
+std::unordered_map<std::string, thrift::Value>
+KvStore::mergeKeyValues(
+    std::unordered_map<std::string, thrift::Value>& kvStore,
+    std::unordered_map<std::string, thrift::Value> const& keyVals,
+    std::optional<KvStoreFilters> const& filters,
+    KvStoreHashBuckets* hashBuckets) {
+  // the publication to build if we update our KV store
+  std::unordered_map<std::string, thrift::Value> kvUpdates;
 
-      // update TTL only, nothing else
-      kvStoreIt->second.ttl = value.ttl;
-      kvStoreIt->second.ttlVersion = value.ttlVersion;
+  // Counters for logging
+  uint32_t ttlUpdateCnt{0}, valUpdateCnt{0};
+
+  for (const auto& [key, value] : keyVals) {
+    if (mergeKeyValue(
+            kvStore,
+            key,
+            value,
+            filters,
+            hashBuckets,
+            ttlUpdateCnt,
+            valUpdateCnt)) {
+      // announce the update
+      kvUpdates.emplace(key, value);
     }
+  }
+
+  VLOG(4) << "(mergeKeyValues) updating " << kvUpdates.size()
+          << " keyvals. ValueUpdates: " << valUpdateCnt
+          << ", TtlUpdates: " << ttlUpdateCnt;
+  return kvUpdates;
+}
 
-    // announce the update
-    kvUpdates.emplace(key, value);
+// static, public
+std::unordered_map<std::string, thrift::Value>
+KvStore::mergeKeyValues(
+    std::unordered_map<std::string, thrift::Value>& kvStore,
+    std::unordered_map<std::string, thrift::Value>&& keyVals,
+    std::optional<KvStoreFilters> const& filters,
+    KvStoreHashBuckets* hashBuckets) {
+  // the publication to build if we update our KV store
+  std::unordered_map<std::string, thrift::Value> kvUpdates;
+
+  // Counters for logging
+  uint32_t ttlUpdateCnt{0}, valUpdateCnt{0};
+
+  for (auto it = keyVals.begin(); it != keyVals.end();) {
+    auto kvIt = it++;
+    if (mergeKeyValue(
+            kvStore,
+            kvIt->first,
+            kvIt->second,
+            filters,
+            hashBuckets,
+            ttlUpdateCnt,
+            valUpdateCnt)) {
+      // announce the update. Hand over key and value without copying
+      kvUpdates.insert(keyVals.extract(kvIt));
+    }
   }
 
   VLOG(4) << "(mergeKeyValues) updating " << kvUpdates.size()
@@ -449,6 +670,36 @@ KvStore::compareValues(const thrift::Value& v1, const thrift::Value& v2) {
   }
 }
 
+std::string
+KvStore::compressPayload(folly::ByteRange payload) {
+  // codec is stateful, hence one per thread
+  thread_local auto const codec =
+      folly::io::getCodec(folly::io::CodecType::ZSTD);
+  return codec->compress(folly::StringPiece(payload));
+}
+
+std::string
+KvStore::decompressPayload(
+    std::string const& payload, size_t maxUncompressedSize) {
+  thread_local auto const codec =
+      folly::io::getCodec(folly::io::CodecType::ZSTD);
+  // size is recorded in the frame by compressPayload. Check it before
+  // inflating anything, uncompress then enforces the frame matches it
+  auto const buf =
+      folly::IOBuf::wrapBufferAsValue(payload.data(), payload.size());
+  auto const uncompressedSize = codec->getUncompressedLength(&buf);
+  if (not uncompressedSize.has_value()) {
+    throw std::runtime_error("Compressed payload misses uncompressed size");
+  }
+  if (*uncompressedSize > maxUncompressedSize) {
+    throw std::runtime_error(folly::sformat(
+        "Uncompressed size {} exceeds limit {}",
+        *uncompressedSize,
+        maxUncompressedSize));
+  }
+  return codec->uncompress(payload, *uncompressedSize);
+}
+
 void
 KvStore::prepareSocket(
     fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_SERVER>& socket,
@@ -488,31 +739,43 @@ KvStore::processCmdSocketRequest(std::vector<fbzmq::Message>&& req) noexcept {
     LOG(ERROR) << "Empty request received";
     return;
   }
-  auto maybeReply = processRequestMsg(
+  auto replySf = processRequestMsg(
       req.front().read<std::string>().value(), std::move(req.back()));
   req.pop_back();
 
-  // All messages of the multipart request except the last are sent back as they
-  // are ids or empty delims. Add the response at the end of that list.
-  if (maybeReply.hasValue()) {
-    req.emplace_back(std::move(maybeReply.value()));
-  } else {
-    req.emplace_back(
-        fbzmq::Message::from(Constants::kErrorResponse.toString()).value());
-  }
-
-  if (not req.back().empty()) {
-    auto sndRet = kvParams_.globalCmdSock.sendMultiple(req);
-    if (sndRet.hasError()) {
-      LOG(ERROR) << "Error sending response. " << sndRet.error();
-    }
-  }
-  return;
-}
-
-folly::Expected<fbzmq::Message, fbzmq::Error>
+  // Request is processed asynchronously in the event base of its area. Reply
+  // is sent back from KvStore's event base, the only user of command socket
+  folly::futures::detachOn(
+      folly::getKeepAliveToken(getEvb()),
+      std::move(replySf).deferValue(
+          [this, req = std::move(req)](
+              folly::Expected<fbzmq::Message, fbzmq::Error>&&
+                  maybeReply) mutable {
+            // All messages of the multipart request except the last are sent
+            // back as they are ids or empty delims. Add the response at the
+            // end of that list.
+            if (maybeReply.hasValue()) {
+              req.emplace_back(std::move(maybeReply.value()));
+            } else {
+              req.emplace_back(
+                  fbzmq::Message::from(Constants::kErrorResponse.toString())
+                      .value());
+            }
+
+            if (not req.back().empty()) {
+              auto sndRet = kvParams_.globalCmdSock.sendMultiple(req);
+              if (sndRet.hasError()) {
+                LOG(ERROR) << "Error sending response. " << sndRet.error();
+              }
+            }
+          }));
+}
+
+folly::SemiFuture<folly::Expected<fbzmq::Message, fbzmq::Error>>
 KvStore::processRequestMsg(
     const std::string& requestId, fbzmq::Message&& request) {
+  using Reply = folly::Expected<fbzmq::Message, fbzmq::Error>;
+
   fb303::fbData->addStatValue(
       "kvstore.peers.bytes_received", request.size(), fb303::SUM);
   auto maybeThriftReq =
@@ -521,10 +784,25 @@ KvStore::processRequestMsg(
   if (maybeThriftReq.hasError()) {
     LOG(ERROR) << "processRequest: failed reading thrift::processRequestMsg"
                << maybeThriftReq.error();
-    return {folly::makeUnexpected(fbzmq::Error())};
+    return folly::makeSemiFuture<Reply>(folly::makeUnexpected(fbzmq::Error()));
   }
 
   auto& thriftRequest = maybeThriftReq.value();
+  if (thriftRequest.compressedRequest_ref().has_value()) {
+    // request is carried compressed by the received one
+    try {
+      thriftRequest = fbzmq::util::readThriftObjStr<thrift::KvStoreRequest>(
+          decompressPayload(
+              *thriftRequest.compressedRequest_ref(),
+              Constants::kKvStoreMaxUncompressedSize),
+          serializer_);
+    } catch (std::exception const& e) {
+      LOG(ERROR) << "processRequest: failed decompressing request. "
+                 << folly::exceptionStr(e);
+      return folly::makeSemiFuture<Reply>(
+          folly::makeUnexpected(fbzmq::Error()));
+    }
+  }
   CHECK(not thriftRequest.area.empty());
   std::string area = thriftRequest.area; // NOTE: Non constness is intended
   // TODO: migration workaround => if me/peer does is using default area,
@@ -536,35 +814,57 @@ KvStore::processRequestMsg(
   }
 
   VLOG(2) << "Request received for area " << area;
-  try {
-    auto& kvStoreDb = kvStoreDb_.at(area);
-    auto response = kvStoreDb.processRequestMsgHelper(requestId, thriftRequest);
-    if (response.hasValue()) {
-      fb303::fbData->addStatValue(
-          "kvstore.peers.bytes_sent", response->size(), fb303::SUM);
-    }
-    return response;
-  } catch (std::out_of_range const& e) {
-    LOG(ERROR) << "std::out_of_range for area " << area;
-    return folly::makeUnexpected(
-        fbzmq::Error(0, folly::sformat("Invalid area {}", area)));
-  }
-  return {folly::makeUnexpected(fbzmq::Error())};
+  if (not areas_.count(area)) {
+    LOG(ERROR) << "Request received for unknown area " << area;
+    return folly::makeSemiFuture<Reply>(folly::makeUnexpected(
+        fbzmq::Error(0, folly::sformat("Invalid area {}", area))));
+  }
+
+  // hand request over to KvStoreDb of the area without blocking
+  auto pf = folly::makePromiseContract<Reply>();
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(pf.first),
+       requestId,
+       area,
+       thriftRequest = std::move(thriftRequest)]() mutable {
+        auto* kvStoreDb = getAreaDb(area);
+        if (not kvStoreDb) {
+          p.setValue(folly::makeUnexpected(
+              fbzmq::Error(0, folly::sformat("Invalid area {}", area))));
+          return;
+        }
+        auto response =
+            kvStoreDb->processRequestMsgHelper(requestId, thriftRequest);
+        if (response.hasValue()) {
+          fb303::fbData->addStatValue(
+              "kvstore.peers.bytes_sent", response->size(), fb303::SUM);
+        }
+        p.setValue(std::move(response));
+      });
+  return std::move(pf.second);
 }
 
-messaging::RQueue<thrift::Publication>
+messaging::SharedRQueue<thrift::Publication>
 KvStore::getKvStoreUpdatesReader() {
   return kvParams_.kvStoreUpdatesQueue.getReader();
 }
 
 void
 KvStore::processPeerUpdates(thrift::PeerUpdateRequest&& req) {
-  // Req can contain peerAdd/peerDel simultaneously
+  // Req can contain peerAdd/peerDel simultaneously. Both are queued in order
+  // on area's event base before waiting for them
+  std::vector<folly::SemiFuture<folly::Unit>> sfs;
   if (req.peerAddParams_ref().has_value()) {
-    addUpdateKvStorePeers(req.peerAddParams_ref().value(), req.area).get();
+    sfs.emplace_back(
+        addUpdateKvStorePeers(req.peerAddParams_ref().value(), req.area));
   }
   if (req.peerDelParams_ref().has_value()) {
-    deleteKvStorePeers(req.peerDelParams_ref().value(), req.area).get();
+    sfs.emplace_back(
+        deleteKvStorePeers(req.peerDelParams_ref().value(), req.area));
+  }
+  for (auto& result : folly::collectAll(std::move(sfs)).get()) {
+    result.throwIfFailed();
   }
 }
 
@@ -573,21 +873,22 @@ KvStore::getKvStoreKeyVals(
     thrift::KeyGetParams keyGetParams, std::string area) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyGetParams = std::move(keyGetParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keyGetParams = std::move(keyGetParams),
+                             area]() mutable {
     VLOG(3) << "Get key requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
       fb303::fbData->addStatValue("kvstore.cmd_key_get", 1, fb303::COUNT);
 
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      auto thriftPub = kvStoreDb.getKeyVals(keyGetParams.keys);
-      kvStoreDb.updatePublicationTtl(thriftPub);
+      auto thriftPub = kvStoreDb->getKeyVals(keyGetParams.keys);
+      kvStoreDb->updatePublicationTtl(thriftPub);
 
       p.setValue(std::make_unique<thrift::Publication>(std::move(thriftPub)));
     }
@@ -600,19 +901,20 @@ KvStore::dumpKvStoreKeys(
     thrift::KeyDumpParams keyDumpParams, std::string area) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyDumpParams = std::move(keyDumpParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keyDumpParams = std::move(keyDumpParams),
+                             area]() mutable {
     VLOG(3) << "Dump all keys requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
       fb303::fbData->addStatValue("kvstore.cmd_key_dump", 1, fb303::COUNT);
 
-      auto& kvStoreDb = kvStoreDb_.at(area);
       std::vector<std::string> keyPrefixList;
       if (keyDumpParams.keys_ref().has_value()) {
         keyPrefixList = *keyDumpParams.keys_ref();
@@ -627,14 +929,19 @@ KvStore::dumpKvStoreKeys(
         oper = *keyDumpParams.oper_ref();
       }
 
-      auto thriftPub = kvStoreDb.dumpAllWithFilters(keyPrefixMatch, oper);
-      if (keyDumpParams.keyValHashes_ref().has_value()) {
-        thriftPub = kvStoreDb.dumpDifference(
-            thriftPub.keyVals, keyDumpParams.keyValHashes_ref().value());
+      thrift::Publication thriftPub;
+      if (auto bucketHashes = keyDumpParams.keyValHashBuckets_ref()) {
+        thriftPub = kvStoreDb->dumpHashBucketDifference(*bucketHashes);
+      } else {
+        thriftPub = kvStoreDb->dumpAllWithFilters(keyPrefixMatch, oper);
+        if (keyDumpParams.keyValHashes_ref().has_value()) {
+          thriftPub = kvStoreDb->dumpDifference(
+              thriftPub.keyVals, keyDumpParams.keyValHashes_ref().value());
+        }
       }
-      kvStoreDb.updatePublicationTtl(thriftPub);
+      kvStoreDb->updatePublicationTtl(thriftPub);
       // I'm the initiator, set flood-root-id
-      fromStdOptional(thriftPub.floodRootId_ref(), kvStoreDb.getSptRootId());
+      fromStdOptional(thriftPub.floodRootId_ref(), kvStoreDb->getSptRootId());
 
       if (keyDumpParams.keyValHashes_ref().has_value() and
           (*keyDumpParams.prefix_ref()).empty() and
@@ -662,19 +969,20 @@ KvStore::dumpKvStoreHashes(
     thrift::KeyDumpParams keyDumpParams, std::string area) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyDumpParams = std::move(keyDumpParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keyDumpParams = std::move(keyDumpParams),
+                             area]() mutable {
     VLOG(3) << "Dump all hashes requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
       fb303::fbData->addStatValue("kvstore.cmd_hash_dump", 1, fb303::COUNT);
 
-      auto& kvStoreDb = kvStoreDb_.at(area);
       std::set<std::string> originator{};
       std::vector<std::string> keyPrefixList{};
       if (keyDumpParams.keys_ref().has_value()) {
@@ -683,8 +991,8 @@ KvStore::dumpKvStoreHashes(
         folly::split(",", *keyDumpParams.prefix_ref(), keyPrefixList, true);
       }
       KvStoreFilters kvFilters{keyPrefixList, originator};
-      auto thriftPub = kvStoreDb.dumpHashWithFilters(kvFilters);
-      kvStoreDb.updatePublicationTtl(thriftPub);
+      auto thriftPub = kvStoreDb->dumpHashWithFilters(kvFilters);
+      kvStoreDb->updatePublicationTtl(thriftPub);
       p.setValue(std::make_unique<thrift::Publication>(std::move(thriftPub)));
     }
   });
@@ -696,13 +1004,15 @@ KvStore::setKvStoreKeyVals(
     thrift::KeySetParams keySetParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keySetParams = std::move(keySetParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keySetParams = std::move(keySetParams),
+                             area]() mutable {
     VLOG(3) << "Set key requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
@@ -718,7 +1028,6 @@ KvStore::setKvStoreKeyVals(
       }
 
       // Update hash for key-values
-      auto& kvStoreDb = kvStoreDb_.at(area);
       for (auto& kv : keySetParams.keyVals) {
         auto& value = kv.second;
         if (value.value_ref().has_value()) {
@@ -733,7 +1042,7 @@ KvStore::setKvStoreKeyVals(
       rcvdPublication.nodeIds_ref().move_from(keySetParams.nodeIds_ref());
       rcvdPublication.floodRootId_ref().move_from(
           keySetParams.floodRootId_ref());
-      kvStoreDb.mergePublication(rcvdPublication);
+      kvStoreDb->mergePublication(std::move(rcvdPublication));
 
       // ready to return
       p.setValue();
@@ -744,14 +1053,11 @@ KvStore::setKvStoreKeyVals(
 
 folly::SemiFuture<std::unique_ptr<thrift::AreasConfig>>
 KvStore::getAreasConfig() {
-  folly::Promise<std::unique_ptr<thrift::AreasConfig>> p;
-  auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p)]() mutable {
-    auto areasConfig = thrift::AreasConfig{};
-    areasConfig.areas = areas_;
-    p.setValue(std::make_unique<thrift::AreasConfig>(std::move(areasConfig)));
-  });
-  return sf;
+  // areas are immutable, no need to go through any event base
+  auto areasConfig = thrift::AreasConfig{};
+  areasConfig.areas = areas_;
+  return folly::makeSemiFuture(
+      std::make_unique<thrift::AreasConfig>(std::move(areasConfig)));
 }
 
 folly::SemiFuture<std::optional<KvStorePeerState>>
@@ -759,13 +1065,13 @@ KvStore::getKvStorePeerState(
     std::string const& peerName, std::string const& area) {
   folly::Promise<std::optional<KvStorePeerState>> promise;
   auto sf = promise.getSemiFuture();
-  runInEventBaseThread(
+  getAreaEvb(area)->runInEventBaseThread(
       [this, p = std::move(promise), peerName, area]() mutable {
-        if (!kvStoreDb_.count(area)) {
+        auto* kvStoreDb = getAreaDb(area);
+        if (not kvStoreDb) {
           p.setValue(std::nullopt);
         } else {
-          auto& kvStoreDb = kvStoreDb_.at(area);
-          auto state = kvStoreDb.getCurrentState(peerName);
+          auto state = kvStoreDb->getCurrentState(peerName);
           p.setValue(state);
         }
       });
@@ -776,16 +1082,17 @@ folly::SemiFuture<std::unique_ptr<thrift::PeersMap>>
 KvStore::getKvStorePeers(std::string area) {
   folly::Promise<std::unique_ptr<thrift::PeersMap>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this, p = std::move(p), area]() mutable {
     VLOG(2) << "Peer dump requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
       fb303::fbData->addStatValue("kvstore.cmd_peer_dump", 1, fb303::COUNT);
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      auto peers = kvStoreDb.dumpPeers();
+      auto peers = kvStoreDb->dumpPeers();
       p.setValue(std::make_unique<thrift::PeersMap>(std::move(peers)));
     }
   });
@@ -797,13 +1104,15 @@ KvStore::addUpdateKvStorePeers(
     thrift::PeerAddParams peerAddParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peerAddParams = std::move(peerAddParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             peerAddParams = std::move(peerAddParams),
+                             area]() mutable {
     VLOG(2) << "Peer addition requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else if (peerAddParams.peers.empty()) {
@@ -811,8 +1120,7 @@ KvStore::addUpdateKvStorePeers(
           "Empty peerNames from peer-add request, ignoring"));
     } else {
       fb303::fbData->addStatValue("kvstore.cmd_peer_add", 1, fb303::COUNT);
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.addPeers(peerAddParams.peers);
+      kvStoreDb->addPeers(peerAddParams.peers);
       p.setValue();
     }
   });
@@ -824,13 +1132,15 @@ KvStore::deleteKvStorePeers(
     thrift::PeerDelParams peerDelParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peerDelParams = std::move(peerDelParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             peerDelParams = std::move(peerDelParams),
+                             area]() mutable {
     VLOG(2) << "Peer deletion requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else if (peerDelParams.peerNames.empty()) {
@@ -838,8 +1148,7 @@ KvStore::deleteKvStorePeers(
           "Empty peerNames from peer-del request, ignoring"));
     } else {
       fb303::fbData->addStatValue("kvstore.cmd_per_del", 1, fb303::COUNT);
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.delPeers(peerDelParams.peerNames);
+      kvStoreDb->delPeers(peerDelParams.peerNames);
       p.setValue();
     }
   });
@@ -850,15 +1159,16 @@ folly::SemiFuture<std::unique_ptr<thrift::SptInfos>>
 KvStore::getSpanningTreeInfos(std::string area) {
   folly::Promise<std::unique_ptr<thrift::SptInfos>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this, p = std::move(p), area]() mutable {
     VLOG(3) << "FLOOD_TOPO_GET command requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      auto sptInfos = kvStoreDb.processFloodTopoGet();
+      auto sptInfos = kvStoreDb->processFloodTopoGet();
       p.setValue(std::make_unique<thrift::SptInfos>(std::move(sptInfos)));
     }
   });
@@ -870,18 +1180,19 @@ KvStore::updateFloodTopologyChild(
     thrift::FloodTopoSetParams floodTopoSetParams, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        floodTopoSetParams = std::move(floodTopoSetParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             floodTopoSetParams = std::move(floodTopoSetParams),
+                             area]() mutable {
     VLOG(2) << "FLOOD_TOPO_SET command requested for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else {
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.processFloodTopoSet(std::move(floodTopoSetParams));
+      kvStoreDb->processFloodTopoSet(std::move(floodTopoSetParams));
       p.setValue();
     }
   });
@@ -893,13 +1204,15 @@ KvStore::processKvStoreDualMessage(
     thrift::DualMessages dualMessages, std::string area) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        dualMessages = std::move(dualMessages),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             dualMessages = std::move(dualMessages),
+                             area]() mutable {
     VLOG(2) << "DUAL messages received for AREA: " << area;
 
-    if (!kvStoreDb_.count(area)) {
+    auto* kvStoreDb = getAreaDb(area);
+    if (not kvStoreDb) {
       p.setException(
           thrift::OpenrError(folly::sformat("Invalid area: {}", area)));
     } else if (dualMessages.messages.empty()) {
@@ -909,8 +1222,7 @@ KvStore::processKvStoreDualMessage(
       fb303::fbData->addStatValue(
           "kvstore.received_dual_messages", 1, fb303::COUNT);
 
-      auto& kvStoreDb = kvStoreDb_.at(area);
-      kvStoreDb.processDualMessages(std::move(dualMessages));
+      kvStoreDb->processDualMessages(std::move(dualMessages));
       p.setValue();
     }
   });
@@ -919,30 +1231,30 @@ KvStore::processKvStoreDualMessage(
 
 folly::SemiFuture<std::map<std::string, int64_t>>
 KvStore::getCounters() {
-  auto pf = folly::makePromiseContract<std::map<std::string, int64_t>>();
-  runInEventBaseThread([this, p = std::move(pf.first)]() mutable {
-    p.setValue(getGlobalCounters());
-  });
-  return std::move(pf.second);
-}
-
-std::map<std::string, int64_t>
-KvStore::getGlobalCounters() const {
-  std::map<std::string, int64_t> flatCounters;
-  for (auto& kvDb : kvStoreDb_) {
-    auto kvDbCounters = kvDb.second.getCounters();
-    // add up counters for same key from all kvStoreDb instances
-    flatCounters = std::accumulate(
-        kvDbCounters.begin(),
-        kvDbCounters.end(),
-        flatCounters,
-        [](std::map<std::string, int64_t>& flatCounters,
-           const std::pair<const std::string, int64_t>& kvDbcounter) {
-          flatCounters[kvDbcounter.first] += kvDbcounter.second;
-          return flatCounters;
+  // collect counters of every KvStoreDb in its event base and add up counters
+  // for same key from all instances
+  std::vector<folly::SemiFuture<std::map<std::string, int64_t>>> sfs;
+  for (auto const& area : areas_) {
+    auto pf = folly::makePromiseContract<std::map<std::string, int64_t>>();
+    getAreaEvb(area)->runInEventBaseThread(
+        [this, area, p = std::move(pf.first)]() mutable {
+          auto* kvStoreDb = getAreaDb(area);
+          p.setValue(
+              kvStoreDb ? kvStoreDb->getCounters()
+                        : std::map<std::string, int64_t>{});
         });
-  }
-  return flatCounters;
+    sfs.emplace_back(std::move(pf.second));
+  }
+  return folly::collect(std::move(sfs))
+      .deferValue([](std::vector<std::map<std::string, int64_t>>&& counters) {
+        std::map<std::string, int64_t> flatCounters;
+        for (auto const& kvDbCounters : counters) {
+          for (auto const& [key, value] : kvDbCounters) {
+            flatCounters[key] += value;
+          }
+        }
+        return flatCounters;
+      });
 }
 
 //
@@ -1104,11 +1416,15 @@ KvStoreDb::KvStoreDb(
     const std::string& area,
     fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_CLIENT> peersyncSock,
     bool isFloodRoot,
-    const std::string& nodeId)
+    const std::string& nodeId,
+    std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient)
     : DualNode(nodeId, isFloodRoot),
       kvParams_(kvParams),
       area_(area),
       peerSyncSock_(std::move(peersyncSock)),
+      zmqMonitorClient_(
+          zmqMonitorClient ? std::move(zmqMonitorClient)
+                           : kvParams.zmqMonitorClient),
       evb_(evb) {
   if (kvParams_.floodRate) {
     floodLimiter_ = std::make_unique<folly::BasicTokenBucket<>>(
@@ -1234,24 +1550,37 @@ KvStoreDb::updateTtlCountdownQueue(const thrift::Publication& publication) {
     const auto& key = kv.first;
     const auto& value = kv.second;
 
-    if (value.ttl != Constants::kTtlInfinity) {
-      TtlCountdownQueueEntry queueEntry;
-      queueEntry.expiryTime = std::chrono::steady_clock::now() +
-          std::chrono::milliseconds(value.ttl);
-      queueEntry.key = key;
-      queueEntry.version = value.version;
-      queueEntry.ttlVersion = value.ttlVersion;
-      queueEntry.originatorId = value.originatorId;
-
-      if ((ttlCountdownQueue_.empty() or
-           (queueEntry.expiryTime <= ttlCountdownQueue_.top().expiryTime)) and
-          ttlCountdownTimer_) {
-        // Reschedule the shorter timeout
-        ttlCountdownTimer_->scheduleTimeout(
-            std::chrono::milliseconds(value.ttl));
+    auto handleIt = ttlCountdownHandles_.find(key);
+    if (value.ttl == Constants::kTtlInfinity) {
+      // key no longer expires, drop its previous entry if any
+      if (handleIt != ttlCountdownHandles_.end()) {
+        ttlCountdownQueue_.erase(handleIt->second);
+        ttlCountdownHandles_.erase(handleIt);
       }
+      continue;
+    }
 
-      ttlCountdownQueue_.push(std::move(queueEntry));
+    TtlCountdownQueueEntry queueEntry;
+    queueEntry.expiryTime = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(value.ttl);
+    queueEntry.key = key;
+    queueEntry.version = value.version;
+    queueEntry.ttlVersion = value.ttlVersion;
+    queueEntry.originatorId = value.originatorId;
+
+    if ((ttlCountdownQueue_.empty() or
+         (queueEntry.expiryTime <= ttlCountdownQueue_.top().expiryTime)) and
+        ttlCountdownTimer_) {
+      // Reschedule the shorter timeout
+      ttlCountdownTimer_->scheduleTimeout(std::chrono::milliseconds(value.ttl));
+    }
+
+    if (handleIt != ttlCountdownHandles_.end()) {
+      // supersede previous entry of the key
+      ttlCountdownQueue_.update(handleIt->second, std::move(queueEntry));
+    } else {
+      ttlCountdownHandles_.emplace(
+          key, ttlCountdownQueue_.push(std::move(queueEntry)));
     }
   }
 }
@@ -1374,6 +1703,80 @@ KvStoreDb::dumpDifference(
   return thriftPub;
 }
 
+// dump the keys in buckets on which hash summary differs from given one
+// thriftPub.keyVals: all keys in mismatched buckets
+// thriftPub.syncBuckets: mismatched buckets
+// full-sync initiator compares it with own keys in these buckets to find
+// what keys need to be sent back to finish 3-way full-sync
+thrift::Publication
+KvStoreDb::dumpHashBucketDifference(
+    std::vector<int64_t> const& bucketHashes) const {
+  thrift::Publication thriftPub;
+  thriftPub.area = area_;
+
+  const auto mismatched = hashBuckets_.getMismatchedBuckets(bucketHashes);
+  thriftPub.syncBuckets_ref() = std::vector<int32_t>{};
+  for (size_t bucket = 0; bucket < mismatched.size(); ++bucket) {
+    if (mismatched[bucket]) {
+      thriftPub.syncBuckets_ref()->emplace_back(bucket);
+    }
+  }
+  if (thriftPub.syncBuckets_ref()->empty()) {
+    return thriftPub;
+  }
+
+  for (auto const& [key, value] : kvStore_) {
+    if (mismatched[KvStoreHashBuckets::getBucket(key)]) {
+      thriftPub.keyVals.emplace(key, value);
+    }
+  }
+  return thriftPub;
+}
+
+void
+KvStoreDb::fillHashBucketSyncResponse(thrift::Publication& syncPub) const {
+  auto const syncBuckets = syncPub.syncBuckets_ref();
+  if (not syncBuckets.has_value() or syncBuckets->empty()) {
+    return;
+  }
+
+  std::vector<bool> mismatched(Constants::kNumOfKvStoreSyncBuckets, false);
+  for (auto const bucket : *syncBuckets) {
+    if (bucket >= 0 and static_cast<size_t>(bucket) < mismatched.size()) {
+      mismatched[bucket] = true;
+    }
+  }
+
+  // my keys in mismatched buckets, which peer should have sent to us
+  std::unordered_map<std::string, thrift::Value> myKeyVals;
+  for (auto const& [key, value] : kvStore_) {
+    if (mismatched[KvStoreHashBuckets::getBucket(key)]) {
+      myKeyVals.emplace(key, value);
+    }
+  }
+
+  // keys on which we are better or peer doesn't have
+  auto const myDiff = dumpDifference(myKeyVals, syncPub.keyVals);
+  syncPub.tobeUpdatedKeys_ref() = std::vector<std::string>{};
+  for (auto const& kv : myDiff.keyVals) {
+    syncPub.tobeUpdatedKeys_ref()->emplace_back(kv.first);
+  }
+}
+
+void
+KvStoreDb::fillFullSyncHashes(thrift::KeyDumpParams& params) const {
+  // NOTE: Hash summary covers whole store, hence it is not used with filters
+  if (kvParams_.enableHashBucketSync and not kvParams_.filters.has_value()) {
+    params.keyValHashBuckets_ref() = hashBuckets_.getBucketHashes();
+    return;
+  }
+  KvStoreFilters kvFilters(
+      std::vector<std::string>{}, /* keyPrefixList */
+      std::set<std::string>{} /* originator */);
+  params.keyValHashes_ref() =
+      std::move(dumpHashWithFilters(kvFilters).keyVals);
+}
+
 // This function serves the purpose of periodically scanning peers in
 // IDLE state and promote them to SYNCING state. The initial dump will
 // happen in async nature to unblock KvStore to process other requests.
@@ -1464,11 +1867,7 @@ KvStoreDb::requestThriftPeerSync() {
       params.originatorIds_ref() =
           kvParams_.filters.value().getOriginatorIdList();
     }
-    KvStoreFilters kvFilters(
-        std::vector<std::string>{}, /* keyPrefixList */
-        std::set<std::string>{} /* originator */);
-    params.keyValHashes_ref() =
-        std::move(dumpHashWithFilters(kvFilters).keyVals);
+    fillFullSyncHashes(params);
 
     // record telemetry for initial full-sync
     fb303::fbData->addStatValue(
@@ -1548,11 +1947,13 @@ KvStoreDb::processThriftSuccess(
     std::chrono::milliseconds timeDelta) {
   // ATTN: `peerName` is MANDATORY to fulfill the finialized
   //       full-sync with peers.
-  const auto kvUpdateCnt = mergePublication(pub, peerName);
+  fillHashBucketSyncResponse(pub);
+  const auto numKeyVals = pub.keyVals.size();
   auto numMissingKeys = 0;
   if (pub.tobeUpdatedKeys_ref().has_value()) {
     numMissingKeys = pub.tobeUpdatedKeys_ref()->size();
   }
+  const auto kvUpdateCnt = mergePublication(std::move(pub), peerName);
 
   // record telemetry for thrift calls
   fb303::fbData->addStatValue(
@@ -1565,7 +1966,7 @@ KvStoreDb::processThriftSuccess(
       "kvstore.thrift.num_keyvals_update", kvUpdateCnt, fb303::SUM);
 
   LOG(INFO) << "[Thrift Sync] Full-sync response received from: " << peerName
-            << " with " << pub.keyVals.size() << " key-vals and "
+            << " with " << numKeyVals << " key-vals and "
             << numMissingKeys << " missing keys. Incured " << kvUpdateCnt
             << " key-value updates."
             << " Processing time: " << timeDelta.count() << "ms.";
@@ -1835,8 +2236,26 @@ KvStoreDb::addPeers(
 // Send message via socket
 folly::Expected<size_t, fbzmq::Error>
 KvStoreDb::sendMessageToPeer(
-    const std::string& peerSocketId, const thrift::KvStoreRequest& request) {
+    const std::string& peerSocketId,
+    const thrift::KvStoreRequest& request,
+    bool compress) {
   auto msg = fbzmq::Message::fromThriftObj(request, serializer_).value();
+  if (compress and msg.size() >= Constants::kKvStoreMinCompressionSize) {
+    msg = fbzmq::Message::fromThriftObj(
+              createCompressedRequest(request, msg.data()), serializer_)
+              .value();
+    ++numCompressedMsgsSent_;
+  }
+  fb303::fbData->addStatValue(
+      "kvstore.peers.bytes_sent", msg.size(), fb303::SUM);
+  return peerSyncSock_.sendMultiple(
+      fbzmq::Message::from(peerSocketId).value(), fbzmq::Message(), msg);
+}
+
+folly::Expected<size_t, fbzmq::Error>
+KvStoreDb::sendMessageToPeer(
+    const std::string& peerSocketId, const folly::IOBuf& payload) {
+  auto msg = fbzmq::Message::wrapBuffer(payload.clone()).value();
   fb303::fbData->addStatValue(
       "kvstore.peers.bytes_sent", msg.size(), fb303::SUM);
   return peerSyncSock_.sendMultiple(
@@ -1855,6 +2274,7 @@ KvStoreDb::getCounters() const {
       peersToSyncWith_.size() + latestSentPeerSync_.size();
   // Record pending unfulfilled thrift request
   counters["kvstore.pending_thrift_request"] = thriftFs_.size();
+  counters["kvstore.compressed_msgs_sent"] = numCompressedMsgsSent_;
   return counters;
 }
 
@@ -1960,19 +2380,19 @@ KvStoreDb::requestFullSyncFromPeers() {
       params.originatorIds_ref() =
           kvParams_.filters.value().getOriginatorIdList();
     }
-    std::set<std::string> originator{};
-    std::vector<std::string> keyPrefixList{};
-    KvStoreFilters kvFilters{keyPrefixList, originator};
-    params.keyValHashes_ref() =
-        std::move(dumpHashWithFilters(kvFilters).keyVals);
+    fillFullSyncHashes(params);
 
+    const bool supportCompression =
+        peers_.at(peerName).first.supportCompression;
     dumpRequest.cmd = thrift::Command::KEY_DUMP;
     dumpRequest.keyDumpParams_ref() = params;
     dumpRequest.area = area_;
+    dumpRequest.compressResponse = supportCompression;
 
     VLOG(1) << "Sending full-sync request to peer " << peerName << " using id "
             << peerCmdSocketId;
-    auto const ret = sendMessageToPeer(peerCmdSocketId, dumpRequest);
+    auto const ret =
+        sendMessageToPeer(peerCmdSocketId, dumpRequest, supportCompression);
 
     if (ret.hasError()) {
       // this could be pretty common on initial connection setup
@@ -2038,25 +2458,31 @@ void
 KvStoreDb::updatePublicationTtl(
     thrift::Publication& thriftPub, bool removeAboutToExpire) {
   auto timeNow = std::chrono::steady_clock::now();
-  for (const auto& qE : ttlCountdownQueue_) {
+  for (auto kv = thriftPub.keyVals.begin(); kv != thriftPub.keyVals.end();) {
     // Find key and ensure we are taking time from right entry from queue
-    auto kv = thriftPub.keyVals.find(qE.key);
-    if (kv == thriftPub.keyVals.end() or kv->second.version != qE.version or
+    auto handleIt = ttlCountdownHandles_.find(kv->first);
+    if (handleIt == ttlCountdownHandles_.end()) {
+      ++kv;
+      continue;
+    }
+    const auto& qE = *handleIt->second;
+    if (kv->second.version != qE.version or
         kv->second.originatorId != qE.originatorId or
         kv->second.ttlVersion != qE.ttlVersion) {
+      ++kv;
       continue;
     }
 
     // Compute timeLeft and do sanity check on it
     auto timeLeft = duration_cast<milliseconds>(qE.expiryTime - timeNow);
     if (timeLeft <= kvParams_.ttlDecr) {
-      thriftPub.keyVals.erase(kv);
+      kv = thriftPub.keyVals.erase(kv);
       continue;
     }
 
     // filter key from publication if time left is below ttl threshold
     if (removeAboutToExpire and timeLeft < Constants::kTtlThreshold) {
-      thriftPub.keyVals.erase(kv);
+      kv = thriftPub.keyVals.erase(kv);
       continue;
     }
 
@@ -2064,6 +2490,7 @@ KvStoreDb::updatePublicationTtl(
     // deterministically whenever it is exchanged between KvStores. This will
     // avoid looping of updates between stores.
     kv->second.ttl = timeLeft.count() - kvParams_.ttlDecr.count();
+    ++kv;
   }
 }
 
@@ -2116,7 +2543,7 @@ KvStoreDb::processRequestMsgHelper(
     rcvdPublication.nodeIds_ref().move_from(ketSetParamsVal.nodeIds_ref());
     rcvdPublication.floodRootId_ref().move_from(
         ketSetParamsVal.floodRootId_ref());
-    mergePublication(rcvdPublication);
+    mergePublication(std::move(rcvdPublication));
 
     // respond to the client
     if (ketSetParamsVal.solicitResponse) {
@@ -2143,9 +2570,14 @@ KvStoreDb::processRequestMsgHelper(
 
     const auto keyPrefixMatch =
         KvStoreFilters(keyPrefixList, keyDumpParamsVal.originatorIds);
-    auto thriftPub = dumpAllWithFilters(keyPrefixMatch);
-    if (auto keyValHashes = keyDumpParamsVal.keyValHashes_ref()) {
-      thriftPub = dumpDifference(thriftPub.keyVals, *keyValHashes);
+    thrift::Publication thriftPub;
+    if (auto bucketHashes = keyDumpParamsVal.keyValHashBuckets_ref()) {
+      thriftPub = dumpHashBucketDifference(*bucketHashes);
+    } else {
+      thriftPub = dumpAllWithFilters(keyPrefixMatch);
+      if (auto keyValHashes = keyDumpParamsVal.keyValHashes_ref()) {
+        thriftPub = dumpDifference(thriftPub.keyVals, *keyValHashes);
+      }
     }
     updatePublicationTtl(thriftPub);
     // I'm the initiator, set flood-root-id
@@ -2166,7 +2598,17 @@ KvStoreDb::processRequestMsgHelper(
                 << " keyValHashes item(s). Sending " << thriftPub.keyVals.size()
                 << " key-vals and " << numMissingKeys << " missing keys";
     }
-    return fbzmq::Message::fromThriftObj(thriftPub, serializer_);
+    auto response = fbzmq::Message::fromThriftObj(thriftPub, serializer_);
+    if (thriftReq.compressResponse and response.hasValue() and
+        response->size() >= Constants::kKvStoreMinCompressionSize) {
+      thrift::Publication compressedPub;
+      compressedPub.area = area_;
+      compressedPub.compressedPublication_ref() =
+          KvStore::compressPayload(response->data());
+      ++numCompressedMsgsSent_;
+      return fbzmq::Message::fromThriftObj(compressedPub, serializer_);
+    }
+    return response;
   }
   case thrift::Command::DUAL: {
     VLOG(2) << "DUAL messages received";
@@ -2395,15 +2837,31 @@ KvStoreDb::processSyncResponse(
     return;
   }
 
-  const auto& syncPub = maybeSyncPub.value();
-  const size_t kvUpdateCnt = mergePublication(syncPub, requestId);
+  auto& syncPub = maybeSyncPub.value();
+  if (syncPub.compressedPublication_ref().has_value()) {
+    // publication is carried compressed by the received one
+    try {
+      syncPub = fbzmq::util::readThriftObjStr<thrift::Publication>(
+          KvStore::decompressPayload(
+              *syncPub.compressedPublication_ref(),
+              Constants::kKvStoreMaxUncompressedSize),
+          serializer_);
+    } catch (std::exception const& e) {
+      LOG(ERROR) << "Received bad compressed response on peerSyncSock. "
+                 << folly::exceptionStr(e);
+      return;
+    }
+  }
+  fillHashBucketSyncResponse(syncPub);
+  const size_t numKeyVals = syncPub.keyVals.size();
   size_t numMissingKeys = 0;
   if (syncPub.tobeUpdatedKeys_ref().has_value()) {
     numMissingKeys = syncPub.tobeUpdatedKeys_ref()->size();
   }
+  const size_t kvUpdateCnt = mergePublication(std::move(syncPub), requestId);
 
   LOG(INFO) << "full-sync response received from " << requestId << " with "
-            << syncPub.keyVals.size() << " key-vals and " << numMissingKeys
+            << numKeyVals << " key-vals and " << numMissingKeys
             << " missing keys. Incured " << kvUpdateCnt << " key-value updates";
 
   fb303::fbData->addStatValue(
@@ -2621,8 +3079,10 @@ KvStoreDb::cleanupTtlCountdownQueue() {
                  kvParams_.nodeId,
                  area_);
       logKvEvent("KEY_EXPIRE", top.key);
+      hashBuckets_.toggle(it->first, it->second);
       kvStore_.erase(it);
     }
+    ttlCountdownHandles_.erase(top.key);
     ttlCountdownQueue_.pop();
   }
 
@@ -2805,7 +3265,14 @@ KvStoreDb::finalizeFullSync(
     VLOG(1) << "finalizeFullSync back to: " << senderId
             << " with keys: " << folly::join(",", keys);
 
-    auto const ret = sendMessageToPeer(senderId, updateRequest);
+    // senderId is socket-id of the peer
+    const bool supportCompression = std::any_of(
+        peers_.begin(), peers_.end(), [&senderId](auto const& peer) {
+          return peer.second.second == senderId and
+              peer.second.first.supportCompression;
+        });
+    auto const ret =
+        sendMessageToPeer(senderId, updateRequest, supportCompression);
     if (ret.hasError()) {
       // this could fail when senderId goes offline
       LOG(ERROR) << "Failed to send finalizeFullSync to " << senderId
@@ -2897,21 +3364,17 @@ KvStoreDb::floodPublication(
     fromStdOptional(publication.floodRootId_ref(), DualNode::getSptRootId());
   }
 
-  // prepare thrift structure for flooding purpose
-  thrift::KvStoreRequest floodRequest;
+  // prepare thrift structure for flooding purpose. Publication is not used
+  // beyond this point, move key-vals instead of copying
   thrift::KeySetParams params;
 
-  params.keyVals = publication.keyVals;
+  params.keyVals = std::move(publication.keyVals);
   // TODO: remove solicit response when all KEY_SET request is over thrift
   params.solicitResponse = false;
   params.nodeIds_ref().copy_from(publication.nodeIds_ref());
   params.floodRootId_ref().copy_from(publication.floodRootId_ref());
   params.timestamp_ms_ref() = getUnixTimeStampMs();
 
-  floodRequest.cmd = thrift::Command::KEY_SET;
-  floodRequest.keySetParams_ref() = params;
-  floodRequest.area = area_;
-
   std::optional<std::string> floodRootId{std::nullopt};
   if (params.floodRootId_ref().has_value()) {
     floodRootId = params.floodRootId_ref().value();
@@ -2947,7 +3410,7 @@ KvStoreDb::floodPublication(
           "kvstore.thrift.num_flood_pub", 1, fb303::COUNT);
       fb303::fbData->addStatValue(
           "kvstore.thrift.num_flood_key_vals",
-          publication.keyVals.size(),
+          params.keyVals.size(),
           fb303::SUM);
 
       auto startTime = std::chrono::steady_clock::now();
@@ -2995,22 +3458,49 @@ KvStoreDb::floodPublication(
               }));
     }
   } else {
+    // Serialize flood request once. Every peer gets a clone of the same
+    // buffer instead of re-serializing the request
+    thrift::KvStoreRequest floodRequest;
+    floodRequest.cmd = thrift::Command::KEY_SET;
+    floodRequest.area = area_;
+    const auto numKeyVals = params.keyVals.size();
+    floodRequest.keySetParams_ref() = std::move(params);
+
+    // Compressed flavor is built once as well if any peer supports it
+    std::unique_ptr<folly::IOBuf> floodPayload{nullptr};
+    std::unique_ptr<folly::IOBuf> compressedFloodPayload{nullptr};
     for (const auto& peer : floodPeers) {
       if (senderId.has_value() && senderId.value() == peer) {
         // Do not flood towards senderId from whom we received this publication
         continue;
       }
+      if (not floodPayload) {
+        floodPayload = serializeToSingleBuffer(floodRequest);
+      }
+      auto const& [peerSpec, peerCmdSocketId] = peers_.at(peer);
+      auto* payload = floodPayload.get();
+      if (peerSpec.supportCompression and
+          floodPayload->length() >= Constants::kKvStoreMinCompressionSize) {
+        if (not compressedFloodPayload) {
+          compressedFloodPayload = serializeToSingleBuffer(
+              createCompressedRequest(
+                  floodRequest,
+                  folly::ByteRange(
+                      floodPayload->data(), floodPayload->length())));
+        }
+        payload = compressedFloodPayload.get();
+        ++numCompressedMsgsSent_;
+      }
       VLOG(4) << "Forwarding publication, received from: "
               << (senderId.has_value() ? senderId.value() : "N/A")
               << ", to: " << peer << ", via: " << kvParams_.nodeId;
 
       fb303::fbData->addStatValue("kvstore.sent_publications", 1, fb303::COUNT);
       fb303::fbData->addStatValue(
-          "kvstore.sent_key_vals", publication.keyVals.size(), fb303::SUM);
+          "kvstore.sent_key_vals", numKeyVals, fb303::SUM);
 
       // Send flood request
-      auto const& peerCmdSocketId = peers_.at(peer).second;
-      auto const ret = sendMessageToPeer(peerCmdSocketId, floodRequest);
+      auto const ret = sendMessageToPeer(peerCmdSocketId, *payload);
       if (ret.hasError()) {
         // this could be pretty common on initial connection setup
         LOG(ERROR) << "Failed to flood publication to peer " << peer
@@ -3024,7 +3514,7 @@ KvStoreDb::floodPublication(
 
 size_t
 KvStoreDb::mergePublication(
-    const thrift::Publication& rcvdPublication,
+    thrift::Publication&& rcvdPublication,
     std::optional<std::string> senderId) {
   // Add counters
   fb303::fbData->addStatValue("kvstore.received_publications", 1, fb303::COUNT);
@@ -3052,7 +3542,10 @@ KvStoreDb::mergePublication(
   // Generate delta with local KvStore
   thrift::Publication deltaPublication;
   deltaPublication.keyVals = KvStore::mergeKeyValues(
-      kvStore_, rcvdPublication.keyVals, kvParams_.filters);
+      kvStore_,
+      std::move(rcvdPublication.keyVals),
+      kvParams_.filters,
+      &hashBuckets_);
   deltaPublication.floodRootId_ref().copy_from(
       rcvdPublication.floodRootId_ref());
   deltaPublication.area = area_;
@@ -3100,7 +3593,7 @@ KvStoreDb::logSyncEvent(
   fbzmq::thrift::EventLog eventLog;
   eventLog.category = Constants::kEventLogCategory.toString();
   eventLog.samples = {sample.toJson()};
-  kvParams_.zmqMonitorClient->addEventLog(std::move(eventLog));
+  zmqMonitorClient_->addEventLog(std::move(eventLog));
 }
 
 void
@@ -3114,7 +3607,7 @@ KvStoreDb::logKvEvent(const std::string& event, const std::string& key) {
   fbzmq::thrift::EventLog eventLog;
   eventLog.category = Constants::kEventLogCategory.toString();
   eventLog.samples = {sample.toJson()};
-  kvParams_.zmqMonitorClient->addEventLog(std::move(eventLog));
+  zmqMonitorClient_->addEventLog(std::move(eventLog));
 }
 
 bool
@@ -11,8 +11,9 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 
-#include <boost/heap/priority_queue.hpp>
+#include <boost/heap/d_ary_heap.hpp>
 #include <boost/serialization/strong_typedef.hpp>
 #include <fbzmq/service/monitor/ZmqMonitorClient.h>
 #include <fbzmq/zmq/Zmq.h>
@@ -73,11 +74,14 @@ struct TtlCountdownQueueEntry {
   }
 };
 
-using TtlCountdownQueue = boost::heap::priority_queue<
+// Holds at most one entry per key, indexed by key via mutable handles so that
+// entries can be updated or removed in place when key is updated
+using TtlCountdownQueue = boost::heap::d_ary_heap<
     TtlCountdownQueueEntry,
+    boost::heap::arity<4>,
+    boost::heap::mutable_<true>,
     // Always returns smallest first
-    boost::heap::compare<std::greater<TtlCountdownQueueEntry>>,
-    boost::heap::stable<true>>;
+    boost::heap::compare<std::greater<TtlCountdownQueueEntry>>>;
 
 class KvStoreFilters {
  public:
@@ -114,7 +118,10 @@ class KvStoreFilters {
   // set of node IDs to match, empty set matches all nodes
   std::set<std::string> originatorIds_{};
 
-  // keyPrefix class to create RE2 set and to match keys
+  // hashed copy of originatorIds_ for matching values against
+  std::unordered_set<std::string> originatorIdSet_{};
+
+  // keyPrefix class to match keys against literal prefixes and RE2 set
   KeyPrefix keyPrefixObjList_;
 };
 
@@ -124,7 +131,7 @@ struct KvStoreParams {
   std::string nodeId;
 
   // Queue for publishing KvStore updates to other modules within a process
-  messaging::ReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue;
+  messaging::SharedReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue;
 
   // socket for remote & local commands
   fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_SERVER> globalCmdSock;
@@ -147,11 +154,13 @@ struct KvStoreParams {
   std::chrono::milliseconds ttlDecr{Constants::kTtlDecrement};
   bool enableFloodOptimization{false};
   bool isFloodRoot{false};
+  // exchange key bucket hashes instead of per key hashes on full-sync
+  bool enableHashBucketSync{false};
   std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient{nullptr};
 
   KvStoreParams(
       std::string nodeid,
-      messaging::ReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue,
+      messaging::SharedReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue,
       fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_SERVER> globalCmdSock,
       // ZMQ high water mark
       int zmqhwm,
@@ -185,6 +194,44 @@ struct KvStoreParams {
         isFloodRoot(isfloodRoot) {}
 };
 
+//
+// Hash summary of KV store content over fixed number of key buckets. Bucket
+// hash is XOR of digests of (key, version, originatorId, hash) of all keys in
+// the bucket, hence it can be updated incrementally as keys change. Peers
+// compare bucket hashes during full-sync and exchange only keys in mismatched
+// buckets.
+// ttlVersion is not part of the digest. TTL refreshes are periodic and flood
+// independently, so including it would make buckets of in-sync peers differ
+// while a refresh propagates and trigger needless key exchange. TTL-only
+// updates therefore leave bucket hashes unchanged.
+//
+class KvStoreHashBuckets {
+ public:
+  KvStoreHashBuckets();
+
+  // bucket of the key, stable across nodes
+  static size_t getBucket(std::string const& key);
+
+  // digest of key-value used in bucket hash
+  static int64_t getDigest(std::string const& key, thrift::Value const& value);
+
+  // add key-value to bucket hash if not present, remove it otherwise
+  void toggle(std::string const& key, thrift::Value const& value);
+
+  std::vector<int64_t> const&
+  getBucketHashes() const {
+    return bucketHashes_;
+  }
+
+  // indicates per bucket if hash differs from given ones. All buckets differ
+  // if number of buckets doesn't match
+  std::vector<bool> getMismatchedBuckets(
+      std::vector<int64_t> const& bucketHashes) const;
+
+ private:
+  std::vector<int64_t> bucketHashes_;
+};
+
 // The class represents a KV Store DB and stores KV pairs in internal map.
 // KV store DB instance is created for each area.
 // This class processes messages received from KvStore server. The configuration
@@ -198,7 +245,10 @@ class KvStoreDb : public DualNode {
       const std::string& area,
       fbzmq::Socket<ZMQ_ROUTER, fbzmq::ZMQ_CLIENT> peersyncSock,
       bool isFloodRoot,
-      const std::string& nodeId);
+      const std::string& nodeId,
+      // monitor client of this instance, defaults to the one in kvParams.
+      // Required if instance runs on its own thread
+      std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient = nullptr);
 
   ~KvStoreDb() override;
 
@@ -227,12 +277,24 @@ class KvStoreDb : public DualNode {
       std::unordered_map<std::string, thrift::Value> const& myKeyVal,
       std::unordered_map<std::string, thrift::Value> const& reqKeyVal) const;
 
+  // dump the keys in buckets on which hash summary differs from given one
+  thrift::Publication dumpHashBucketDifference(
+      std::vector<int64_t> const& bucketHashes) const;
+
+  // Populate tobeUpdatedKeys of response to hash bucket full-sync request
+  // with the keys in mismatched buckets on which we are better
+  void fillHashBucketSyncResponse(thrift::Publication& syncPub) const;
+
+  // Build KeyDumpParams hash information for full-sync request
+  void fillFullSyncHashes(thrift::KeyDumpParams& params) const;
+
   // Merge received publication with local store and publish out the delta.
   // If senderId is set, will build <key:value> map from kvStore_ and
-  // rcvdPublication.tobeUpdatedKeys and send back to senderId to update it
+  // rcvdPublication.tobeUpdatedKeys and send back to senderId to update it.
+  // Updated key-values are moved out of rcvdPublication into the delta
   // @return: Number of KV updates applied
   size_t mergePublication(
-      thrift::Publication const& rcvdPublication,
+      thrift::Publication&& rcvdPublication,
       std::optional<std::string> senderId = std::nullopt);
 
   // update Time to expire filed in Publication
@@ -403,9 +465,16 @@ class KvStoreDb : public DualNode {
   // flood pending update blocked by rate limiter
   void floodBufferedUpdates(void);
 
-  // Send message via socket
+  // Send message via socket. Large requests are sent compressed if compress
+  // is set, i.e. peer supports compression
+  folly::Expected<size_t, fbzmq::Error> sendMessageToPeer(
+      const std::string& peerSocketId,
+      const thrift::KvStoreRequest& request,
+      bool compress = false);
+
+  // Send already serialized request via socket. Payload is shared, not copied
   folly::Expected<size_t, fbzmq::Error> sendMessageToPeer(
-      const std::string& peerSocketId, const thrift::KvStoreRequest& request);
+      const std::string& peerSocketId, const folly::IOBuf& payload);
 
   //
   // Private variables
@@ -493,9 +562,17 @@ class KvStoreDb : public DualNode {
   // store keys mapped to (version, originatoId, value)
   std::unordered_map<std::string, thrift::Value> kvStore_;
 
+  // hash summary of kvStore_, must be updated along with it
+  KvStoreHashBuckets hashBuckets_;
+
   // TTL count down queue
   TtlCountdownQueue ttlCountdownQueue_;
 
+  // key to its entry in TTL count down queue. Keys with infinite TTL are not
+  // present
+  std::unordered_map<std::string, TtlCountdownQueue::handle_type>
+      ttlCountdownHandles_;
+
   // TTL count down timer
   std::unique_ptr<folly::AsyncTimeout> ttlCountdownTimer_;
 
@@ -507,6 +584,10 @@ class KvStoreDb : public DualNode {
       std::chrono::time_point<std::chrono::steady_clock>>
       latestSentPeerSync_;
 
+  // Number of messages sent compressed to peers, i.e. flooding and full-sync
+  // requests and responses
+  size_t numCompressedMsgsSent_{0};
+
   // Kvstore rate limiter
   std::unique_ptr<folly::BasicTokenBucket<>> floodLimiter_{nullptr};
 
@@ -539,6 +620,9 @@ class KvStoreDb : public DualNode {
   // thrift version of "parallelSyncLimit_"
   size_t parallelSyncLimitOverThrift_{2};
 
+  // client to interact with monitor
+  std::shared_ptr<fbzmq::ZmqMonitorClient> zmqMonitorClient_{nullptr};
+
   // event loop
   OpenrEventBase* evb_{nullptr};
 };
@@ -556,7 +640,7 @@ class KvStore final : public OpenrEventBase {
       // the zmq context to use for IO
       fbzmq::Context& zmqContext,
       // Queue for publishing kvstore updates
-      messaging::ReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue,
+      messaging::SharedReplicateQueue<thrift::Publication>& kvStoreUpdatesQueue,
       // Queue for receiving peer updates
       messaging::RQueue<thrift::PeerUpdateRequest> peerUpdateQueue,
       // the url to receive command from peer instances
@@ -574,16 +658,29 @@ class KvStore final : public OpenrEventBase {
 
   ~KvStore() override = default;
 
+  // override run() method of OpenrEventBase to start per area threads
+  void run() override;
+
   // override stop() method of OpenrEventBase
   void stop() override;
 
   // process the key-values publication, and attempt to
   // merge it in existing map (first argument)
   // Return a publication made out of the updated values
+  // If hashBuckets is set, it's updated along with kvStore
   static std::unordered_map<std::string, thrift::Value> mergeKeyValues(
       std::unordered_map<std::string, thrift::Value>& kvStore,
       std::unordered_map<std::string, thrift::Value> const& update,
-      std::optional<KvStoreFilters> const& filters = std::nullopt);
+      std::optional<KvStoreFilters> const& filters = std::nullopt,
+      KvStoreHashBuckets* hashBuckets = nullptr);
+
+  // same as above but accepted key-values are moved out of update into the
+  // returned publication instead of being copied
+  static std::unordered_map<std::string, thrift::Value> mergeKeyValues(
+      std::unordered_map<std::string, thrift::Value>& kvStore,
+      std::unordered_map<std::string, thrift::Value>&& update,
+      std::optional<KvStoreFilters> const& filters = std::nullopt,
+      KvStoreHashBuckets* hashBuckets = nullptr);
 
   // compare two thrift::Values to figure out which value is better to
   // use, it will compare following attributes in order
@@ -595,6 +692,13 @@ class KvStore final : public OpenrEventBase {
   // unknown can happen if value is missing (only hash is provided)
   static int compareValues(const thrift::Value& v1, const thrift::Value& v2);
 
+  // zstd compress/decompress payload of messages exchanged with peers
+  // supporting compression. Decompression throws on malformed payload or if
+  // it would expand to more than maxUncompressedSize bytes
+  static std::string compressPayload(folly::ByteRange payload);
+  static std::string decompressPayload(
+      std::string const& payload, size_t maxUncompressedSize);
+
   // Public APIs
   folly::SemiFuture<std::unique_ptr<thrift::AreasConfig>> getAreasConfig();
 
@@ -639,7 +743,7 @@ class KvStore final : public OpenrEventBase {
   folly::SemiFuture<std::map<std::string, int64_t>> getCounters();
 
   // API to get reader for kvStoreUpdatesQueue
-  messaging::RQueue<thrift::Publication> getKvStoreUpdatesReader();
+  messaging::SharedRQueue<thrift::Publication> getKvStoreUpdatesReader();
 
   // API to fetch state of peerNode, used for unit-testing
   folly::SemiFuture<std::optional<KvStorePeerState>> getKvStorePeerState(
@@ -664,13 +768,20 @@ class KvStore final : public OpenrEventBase {
   void processCmdSocketRequest(std::vector<fbzmq::Message>&& req) noexcept;
 
   // This function wraps `processRequestMsgHelper` and updates send/received
-  // bytes counters.
-  folly::Expected<fbzmq::Message, fbzmq::Error> processRequestMsg(
-      const std::string& requestId, fbzmq::Message&& msg);
+  // bytes counters. Request is processed in the event base of its area and
+  // returned future is fulfilled there with the response.
+  folly::SemiFuture<folly::Expected<fbzmq::Message, fbzmq::Error>>
+  processRequestMsg(const std::string& requestId, fbzmq::Message&& msg);
 
   void processPeerUpdates(thrift::PeerUpdateRequest&& req);
 
-  std::map<std::string, int64_t> getGlobalCounters() const;
+  // event base running KvStoreDb of the area. It's KvStore's own event base
+  // unless per area threads are enabled or area is unknown
+  OpenrEventBase* getAreaEvb(std::string const& area);
+
+  // KvStoreDb of the area. nullptr if area is unknown or KvStore is stopped.
+  // Must be called in the event base of the area
+  KvStoreDb* getAreaDb(std::string const& area);
 
   //
   // Private variables
@@ -685,8 +796,17 @@ class KvStore final : public OpenrEventBase {
   // kvstore parameters common to all kvstoreDB
   KvStoreParams kvParams_;
 
-  // map of area IDs and instance of KvStoreDb
-  std::unordered_map<std::string /* area ID */, KvStoreDb> kvStoreDb_{};
+  // map of area IDs and instance of KvStoreDb. Instances are destroyed in the
+  // event base of their area on stop, the map is cleared once all of them
+  // stopped
+  std::unordered_map<std::string /* area ID */, std::unique_ptr<KvStoreDb>>
+      kvStoreDb_{};
+
+  // event bases and their threads of KvStoreDb instances if per area threads
+  // are enabled. Empty otherwise
+  std::unordered_map<std::string /* area ID */, std::unique_ptr<OpenrEventBase>>
+      areaEvbs_{};
+  std::vector<std::thread> areaThreads_{};
 
   // the serializer/deserializer helper we'll be using
   apache::thrift::CompactSerializer serializer_;
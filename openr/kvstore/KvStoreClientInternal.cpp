@@ -19,11 +19,11 @@ KvStoreClientInternal::KvStoreClientInternal(
     OpenrEventBase* eventBase,
     std::string const& nodeId,
     KvStore* kvStore,
-    std::optional<std::chrono::milliseconds> checkPersistKeyPeriod)
+    bool restoreExpiredKeys)
     : nodeId_(nodeId),
       eventBase_(eventBase),
       kvStore_(kvStore),
-      checkPersistKeyPeriod_(checkPersistKeyPeriod) {
+      restoreExpiredKeys_(restoreExpiredKeys) {
   // sanity check
   CHECK_NE(eventBase_, static_cast<void*>(nullptr));
   CHECK(!nodeId.empty());
@@ -42,7 +42,7 @@ KvStoreClientInternal::KvStoreClientInternal(
         LOG(INFO) << "Terminating KvStore updates processing fiber";
         break;
       }
-      processPublication(maybePublication.value());
+      processPublication(*maybePublication.value());
     }
   });
 
@@ -58,7 +58,6 @@ KvStoreClientInternal::~KvStoreClientInternal() {
     LOG(INFO) << "Destroy timers inside KvStoreClientInternal...";
     advertiseKeyValsTimer_.reset();
     ttlTimer_.reset();
-    checkPersistKeyTimer_.reset();
   });
 
   // Stop kvstore internal if not stopped yet
@@ -95,67 +94,6 @@ KvStoreClientInternal::initTimers() {
   // Create ttl timer
   ttlTimer_ = folly::AsyncTimeout::make(
       *eventBase_->getEvb(), [this]() noexcept { advertiseTtlUpdates(); });
-
-  // Create check persistKey timer
-  if (checkPersistKeyPeriod_.has_value()) {
-    checkPersistKeyTimer_ = folly::AsyncTimeout::make(
-        *eventBase_->getEvb(), [this]() noexcept { checkPersistKeyInStore(); });
-    checkPersistKeyTimer_->scheduleTimeout(checkPersistKeyPeriod_.value());
-  }
-}
-
-void
-KvStoreClientInternal::checkPersistKeyInStore() {
-  std::chrono::milliseconds timeout{checkPersistKeyPeriod_.value()};
-
-  // go through persisted keys map for each area
-  for (const auto& persistKeyValsEntry : persistedKeyVals_) {
-    const auto& area = persistKeyValsEntry.first;
-    auto& persistedKeyVals = persistKeyValsEntry.second;
-
-    if (persistedKeyVals.empty()) {
-      continue;
-    }
-
-    thrift::KeyGetParams params;
-    thrift::Publication pub;
-    for (auto const& key : persistedKeyVals) {
-      params.keys.emplace_back(key.first);
-    }
-
-    // Get KvStore response
-    try {
-      pub = *(kvStore_->getKvStoreKeyVals(params, area).get());
-    } catch (const std::exception& ex) {
-      LOG(ERROR) << "Failed to get keyvals from kvstore. Exception: "
-                 << ex.what();
-      // retry in 1 sec
-      timeout = 1000ms;
-      checkPersistKeyTimer_->scheduleTimeout(1000ms);
-      continue;
-    }
-
-    // Find expired keys from latest KvStore
-    std::unordered_map<std::string, thrift::Value> keyVals;
-    for (auto const& key : persistedKeyVals) {
-      auto rxkey = pub.keyVals.find(key.first);
-      if (rxkey == pub.keyVals.end()) {
-        keyVals.emplace(key.first, persistedKeyVals.at(key.first));
-      }
-    }
-
-    // Advertise to KvStore
-    if (not keyVals.empty()) {
-      const auto ret = setKeysHelper(std::move(keyVals), area);
-      if (!ret.has_value()) {
-        LOG(ERROR) << "Error sending SET_KEY request to KvStore.";
-      }
-    }
-    processPublication(pub);
-  }
-
-  timeout = std::min(timeout, checkPersistKeyPeriod_.value());
-  checkPersistKeyTimer_->scheduleTimeout(timeout);
 }
 
 bool
@@ -549,8 +487,21 @@ void
 KvStoreClientInternal::processExpiredKeys(
     thrift::Publication const& publication) {
   auto const& expiredKeys = publication.expiredKeys;
+  auto& persistedKeyVals = persistedKeyVals_[publication.area];
+  auto& keysToAdvertise = keysToAdvertise_[publication.area];
+  bool persistedKeyLost{false};
 
   for (auto const& key : expiredKeys) {
+    // persisted key is lost from KvStore. Advertise it back. Advertisement
+    // applies backoff of the key, so that a key which keeps expiring doesn't
+    // get re-advertised in a loop
+    if (restoreExpiredKeys_ and persistedKeyVals.count(key)) {
+      LOG(INFO) << "Persisted key " << key << " expired in area "
+                << publication.area << ". Re-advertising it";
+      keysToAdvertise.insert(key);
+      persistedKeyLost = true;
+    }
+
     /* callback registered by the thread */
     if (kvCallback_) {
       kvCallback_(key, std::nullopt);
@@ -561,6 +512,10 @@ KvStoreClientInternal::processExpiredKeys(
       (cb->second)(key, std::nullopt);
     }
   }
+
+  if (persistedKeyLost) {
+    advertisePendingKeys();
+  }
 }
 
 void
@@ -46,12 +46,14 @@ class KvStoreClientInternal {
   /**
    * Creates and initializes all necessary sockets for communicating with
    * KvStore.
+   * If restoreExpiredKeys is set, persisted keys reported expired by KvStore
+   * are re-advertised (subject to per key backoff).
    */
   KvStoreClientInternal(
       OpenrEventBase* eventBase,
       std::string const& nodeId,
       KvStore* kvStore,
-      std::optional<std::chrono::milliseconds> checkPersistKeyPeriod = 60000ms);
+      bool restoreExpiredKeys = true);
 
   ~KvStoreClientInternal();
 
@@ -174,7 +176,8 @@ class KvStoreClientInternal {
   void processPublication(thrift::Publication const& publication);
 
   /**
-   * Function to process received expired keys
+   * Function to process received expired keys. Persisted keys among them
+   * are lost from KvStore and get re-advertised
    */
   void processExpiredKeys(thrift::Publication const& publication);
 
@@ -224,8 +227,6 @@ class KvStoreClientInternal {
    */
   void advertiseTtlUpdates();
 
-  void checkPersistKeyInStore();
-
   /*
    * Wrapper function to initialize timer
    */
@@ -245,11 +246,8 @@ class KvStoreClientInternal {
   // Pointers to KvStore module
   KvStore* kvStore_{nullptr};
 
-  // periodic timer to check existence of persist key in kv store
-  std::optional<std::chrono::milliseconds> checkPersistKeyPeriod_{std::nullopt};
-
-  // check persiste key timer event
-  std::unique_ptr<folly::AsyncTimeout> checkPersistKeyTimer_;
+  // re-advertise persisted keys which expired in KvStore
+  const bool restoreExpiredKeys_{true};
 
   //
   // Mutable state
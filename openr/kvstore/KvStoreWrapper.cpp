@@ -32,6 +32,8 @@ KvStoreWrapper::KvStoreWrapper(
       enableFloodOptimization_(
           config->getKvStoreConfig().enable_flood_optimization_ref().value_or(
               false)),
+      enableCompression_(
+          config->getKvStoreConfig().enable_compression_ref().value_or(false)),
       enableKvStoreThrift_(enableKvStoreThrift) {
   VLOG(1) << "KvStoreWrapper: Creating KvStore.";
   kvStore_ = std::make_unique<KvStore>(
@@ -184,8 +186,8 @@ KvStoreWrapper::recvPublication() {
   if (maybePublication.hasError()) {
     throw std::runtime_error(std::string("recvPublication failed"));
   }
-  auto pub = maybePublication.value();
-  return pub;
+  // copy out of the publication shared with other readers
+  return *maybePublication.value();
 }
 
 thrift::SptInfos
@@ -53,7 +53,7 @@ class KvStoreWrapper {
   /**
    * Get reader for KvStore updates queue
    */
-  messaging::RQueue<thrift::Publication>
+  messaging::SharedRQueue<thrift::Publication>
   getReader() {
     return kvStoreUpdatesQueue_.getReader();
   }
@@ -160,7 +160,8 @@ class KvStoreWrapper {
         globalCmdUrl, /* cmdUrl for ZMQ */
         "", /* peerAddr for thrift */
         0, /* port for thrift */
-        enableFloodOptimization_);
+        enableFloodOptimization_,
+        enableCompression_);
   }
 
   /**
@@ -192,8 +193,8 @@ class KvStoreWrapper {
   apache::thrift::CompactSerializer serializer_;
 
   // Queue for streaming KvStore updates
-  messaging::ReplicateQueue<thrift::Publication> kvStoreUpdatesQueue_;
-  messaging::RQueue<thrift::Publication> kvStoreUpdatesQueueReader_{
+  messaging::SharedReplicateQueue<thrift::Publication> kvStoreUpdatesQueue_;
+  messaging::SharedRQueue<thrift::Publication> kvStoreUpdatesQueueReader_{
       kvStoreUpdatesQueue_.getReader()};
 
   // Queue for streaming peer updates from LM
@@ -208,6 +209,9 @@ class KvStoreWrapper {
   // enable flood optimization or not
   const bool enableFloodOptimization_{false};
 
+  // accept compressed messages from peers or not
+  const bool enableCompression_{false};
+
   // enable kvStore over thrift or not
   const bool enableKvStoreThrift_{false};
 };
@@ -13,6 +13,7 @@
 #include <folly/Format.h>
 #include <folly/Random.h>
 #include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
@@ -21,6 +22,28 @@
 #include <openr/kvstore/KvStore.h>
 #include <openr/kvstore/KvStoreWrapper.h>
 
+/**
+ * Defines a benchmark that allows users to record customized counter during
+ * benchmarking and passes a parameter to another one.
+ */
+#define BENCHMARK_COUNTERS_PARAM(name, counters, param) \
+  BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param, param)
+
+/*
+ * Like BENCHMARK_COUNTERS_PARAM(), but allows a custom name to be specified for
+ * each parameter, rather than using the parameter value.
+ */
+#define BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param_name, ...) \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
 namespace {
 
 // interval for periodic syncs
@@ -30,6 +53,18 @@ const std::chrono::seconds kDbSyncInterval(10000);
 const int kSizeOfKey = 32;
 // The byte size of a value
 const int kSizeOfValue = 1024;
+// Number of keys flooded to peers per update
+const uint32_t kNumOfFloodKeys = 100;
+// Number of keys set into store per request while populating it
+const uint32_t kNumOfKeysPerBatch = 10000;
+// Number of keys in store and update for value size benchmarks
+const uint32_t kNumOfMergeKeys = 100;
+// Number of keys matched against filters
+const uint32_t kNumOfFilterKeys = 1000000;
+// Number of adjacencies in adjacency database values
+const int kNumOfAdjacencies = 16;
+// TTL of keys populated in store, long enough to not expire while benchmarking
+const int64_t kKeyTtlMs = 3600 * 1000;
 
 /**
  * Produce a random string of given length - for value generation
@@ -73,9 +108,13 @@ class KvStoreTestFixture {
    * Retured raw pointer of an object will be freed as well.
    */
   KvStoreWrapper*
-  createKvStore(const std::string& nodeId) {
-    auto tConfig = getBasicOpenrConfig(nodeId);
+  createKvStore(
+      const std::string& nodeId,
+      const std::vector<thrift::AreaConfig>& areas = {},
+      bool enablePerAreaThreads = false) {
+    auto tConfig = getBasicOpenrConfig(nodeId, "domain", areas);
     tConfig.kvstore_config.sync_interval_s = kDbSyncInterval.count();
+    tConfig.kvstore_config.enable_per_area_threads_ref() = enablePerAreaThreads;
     config_ = std::make_shared<Config>(tConfig);
     auto ptr = std::make_unique<KvStoreWrapper>(context, config_);
     stores_.emplace_back(std::move(ptr));
@@ -134,7 +173,24 @@ updateKvStore(
   suspender.dismiss(); // Start measuring benchmark time
 
   // Merge update with kvStore
-  KvStore::mergeKeyValues(kvStore, update);
+  KvStore::mergeKeyValues(kvStore, std::move(update));
+}
+
+/**
+ * Generate numOfKeys (key, value) pairs with values of sizeOfValue bytes
+ */
+std::unordered_map<std::string, thrift::Value>
+genKeyVals(uint32_t numOfKeys, size_t sizeOfValue, int64_t version) {
+  std::unordered_map<std::string, thrift::Value> keyVals;
+  for (uint32_t idx = 0; idx < numOfKeys; idx++) {
+    auto value =
+        createThriftValue(version, "kvStore", genRandomStr(sizeOfValue));
+    // values carry hash as they do when flooded between stores
+    value.hash_ref() =
+        generateHash(value.version, value.originatorId, value.value_ref());
+    keyVals.emplace(folly::sformat("key-{}", idx), std::move(value));
+  }
+  return keyVals;
 }
 
 /**
@@ -217,6 +273,53 @@ BM_KvStoreMergeKeyValues(
   }
 }
 
+/**
+ * Benchmark for mergeKeyValues() with large values:
+ * 1. Put kNumOfMergeKeys keys with values of sizeOfValue bytes into kvStore
+ * 2. Merge update with newer version of every key
+ */
+static void
+BM_KvStoreMergeKeyValuesLargeValue(uint32_t iters, size_t sizeOfValue) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStore = genKeyVals(kNumOfMergeKeys, sizeOfValue, 1);
+  auto keyVals = genKeyVals(kNumOfMergeKeys, sizeOfValue, 1);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto update = keyVals;
+    for (auto& [_, value] : update) {
+      value.version = i + 2;
+      value.hash_ref() =
+          generateHash(value.version, value.originatorId, value.value_ref());
+    }
+
+    suspender.dismiss(); // Start measuring benchmark time
+    auto kvUpdates = KvStore::mergeKeyValues(kvStore, std::move(update));
+    CHECK_EQ(kNumOfMergeKeys, kvUpdates.size());
+    suspender.rehire(); // Stop measuring time again
+  }
+}
+
+/**
+ * Benchmark for mergeKeyValues() with duplicates, e.g. publications reflected
+ * back by peers:
+ * 1. Put kNumOfMergeKeys keys with values of sizeOfValue bytes into kvStore
+ * 2. Merge update with exactly the same key-values
+ */
+static void
+BM_KvStoreMergeKeyValuesDuplicates(uint32_t iters, size_t sizeOfValue) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStore = genKeyVals(kNumOfMergeKeys, sizeOfValue, 1);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto update = kvStore;
+
+    suspender.dismiss(); // Start measuring benchmark time
+    auto kvUpdates = KvStore::mergeKeyValues(kvStore, std::move(update));
+    CHECK(kvUpdates.empty());
+    suspender.rehire(); // Stop measuring time again
+  }
+}
+
 /**
  * Benchmark for a full dump:
  * 1. Start kvStore
@@ -284,6 +387,290 @@ BM_KvStoreFloodingUpdate(uint32_t iters, size_t numOfUpdateKeys) {
   }
 }
 
+/**
+ * Benchmark for flooding an update to peers
+ * 1. Start a kvStore with numOfPeers peer kvStores
+ * 2. Set keys into kvStore and wait until every peer receives the update
+ */
+static void
+BM_KvStoreFloodingToPeers(uint32_t iters, size_t numOfPeers) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStoreTestFixture = std::make_unique<KvStoreTestFixture>();
+  auto kvStore = kvStoreTestFixture->createKvStore("kvStore");
+  kvStore->run();
+
+  std::vector<KvStoreWrapper*> peers;
+  for (size_t i = 0; i < numOfPeers; i++) {
+    auto peer = kvStoreTestFixture->createKvStore(folly::sformat("peer{}", i));
+    peer->run();
+    kvStore->addPeer(peer->getNodeId(), peer->getPeerSpec());
+    peers.emplace_back(peer);
+  }
+
+  // Generate random keys beforehand for updating
+  std::vector<std::string> keys;
+  keys.reserve(kNumOfFloodKeys);
+  for (uint32_t idx = 0; idx < kNumOfFloodKeys; idx++) {
+    keys.emplace_back(genRandomStr(kSizeOfKey));
+  }
+
+  // Make sure all peers are reachable before measuring
+  const std::string warmupKey{"warmup"};
+  kvStore->setKey(warmupKey, createThriftValue(1, "kvStore", "warmup"));
+  for (auto& peer : peers) {
+    while (not peer->recvPublication().keyVals.count(warmupKey)) {
+    }
+  }
+
+  // Version starts with 1
+  uint64_t version = 1;
+  for (uint32_t i = 0; i < iters; i++) {
+    std::vector<std::pair<std::string, thrift::Value>> keyVals;
+    keyVals.reserve(kNumOfFloodKeys);
+    for (auto const& key : keys) {
+      auto thriftVal = createThriftValue(
+          version, "kvStore", genRandomStr(kSizeOfValue));
+      thriftVal.hash_ref() = generateHash(
+          thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+      keyVals.emplace_back(key, std::move(thriftVal));
+    }
+    version++;
+
+    suspender.dismiss(); // Start measuring benchmark time
+    kvStore->setKeys(keyVals);
+    // Wait for update to reach every peer
+    for (auto& peer : peers) {
+      auto pub = peer->recvPublication();
+      CHECK_EQ(kNumOfFloodKeys, pub.keyVals.size());
+    }
+    suspender.rehire(); // Stop measuring time again
+  }
+}
+
+/**
+ * Benchmark for flooding a single key update in a store of keys with TTL:
+ * 1. Start kvStore and populate it with numOfKeysInStore keys with finite TTL
+ * 2. Set a single key and wait until its publication with adjusted TTL is
+ *    received
+ */
+static void
+BM_KvStoreFloodingTtlKeys(uint32_t iters, size_t numOfKeysInStore) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStoreTestFixture = std::make_unique<KvStoreTestFixture>();
+  auto kvStore = kvStoreTestFixture->createKvStore("kvStore");
+  kvStore->run();
+
+  // Populate store in batches. Values are kept small to bound memory usage
+  std::vector<std::pair<std::string, thrift::Value>> keyVals;
+  for (size_t idx = 0; idx < numOfKeysInStore; idx++) {
+    auto thriftVal = createThriftValue(
+        1 /* version */, "kvStore", genRandomStr(kSizeOfKey), kKeyTtlMs);
+    thriftVal.hash_ref() = generateHash(
+        thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+    keyVals.emplace_back(folly::sformat("key-{}", idx), std::move(thriftVal));
+    if (keyVals.size() == kNumOfKeysPerBatch or idx + 1 == numOfKeysInStore) {
+      kvStore->setKeys(keyVals);
+      kvStore->recvPublication();
+      keyVals.clear();
+    }
+  }
+
+  const std::string key{"flood-key"};
+  for (uint32_t i = 0; i < iters; i++) {
+    auto thriftVal = createThriftValue(
+        i + 1 /* version */, "kvStore", genRandomStr(kSizeOfValue), kKeyTtlMs);
+    thriftVal.hash_ref() = generateHash(
+        thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+
+    suspender.dismiss(); // Start measuring benchmark time
+    kvStore->setKey(key, thriftVal);
+    auto pub = kvStore->recvPublication();
+    CHECK_EQ(1, pub.keyVals.size());
+    suspender.rehire(); // Stop measuring time again
+  }
+}
+
+/**
+ * Benchmark for flooding updates in multiple areas at once
+ * 1. Start a kvStore and a peer kvStore with numOfAreas areas, peered in every
+ *    area. KvStoreDb of every area runs on its own thread if
+ *    enablePerAreaThreads is set, otherwise all share the KvStore thread
+ * 2. Set keys into every area of kvStore concurrently and wait until peer
+ *    receives the updates of all areas
+ */
+static void
+BM_KvStoreMultiAreaFlooding(
+    uint32_t iters, size_t numOfAreas, bool enablePerAreaThreads) {
+  auto suspender = folly::BenchmarkSuspender();
+  std::vector<thrift::AreaConfig> areas;
+  for (size_t i = 0; i < numOfAreas; i++) {
+    areas.emplace_back(
+        createAreaConfig(folly::sformat("area-{}", i), {".*"}, {".*"}));
+  }
+  auto kvStoreTestFixture = std::make_unique<KvStoreTestFixture>();
+  auto kvStore = kvStoreTestFixture->createKvStore(
+      "kvStore", areas, enablePerAreaThreads);
+  auto peer =
+      kvStoreTestFixture->createKvStore("peer", areas, enablePerAreaThreads);
+  kvStore->run();
+  peer->run();
+  for (auto const& area : areas) {
+    kvStore->addPeer(peer->getNodeId(), peer->getPeerSpec(), area.area_id);
+  }
+
+  // Wait until number of keys are received by peer across all areas
+  auto waitForKeys = [&peer](size_t numOfKeys) {
+    size_t numOfKeysReceived{0};
+    while (numOfKeysReceived < numOfKeys) {
+      numOfKeysReceived += peer->recvPublication().keyVals.size();
+    }
+    CHECK_EQ(numOfKeys, numOfKeysReceived);
+  };
+
+  // Make sure peer is reachable in all areas before measuring
+  for (auto const& area : areas) {
+    kvStore->setKey(
+        "warmup",
+        createThriftValue(1, "kvStore", "warmup"),
+        std::nullopt,
+        area.area_id);
+  }
+  waitForKeys(numOfAreas);
+
+  // Generate random keys beforehand for updating
+  std::vector<std::string> keys;
+  keys.reserve(kNumOfFloodKeys);
+  for (uint32_t idx = 0; idx < kNumOfFloodKeys; idx++) {
+    keys.emplace_back(genRandomStr(kSizeOfKey));
+  }
+
+  // Version starts with 1
+  uint64_t version = 1;
+  for (uint32_t i = 0; i < iters; i++) {
+    std::vector<thrift::KeySetParams> params(numOfAreas);
+    for (auto& param : params) {
+      for (auto const& key : keys) {
+        auto thriftVal = createThriftValue(
+            version, "kvStore", genRandomStr(kSizeOfValue));
+        thriftVal.hash_ref() = generateHash(
+            thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+        param.keyVals.emplace(key, std::move(thriftVal));
+      }
+    }
+    version++;
+
+    suspender.dismiss(); // Start measuring benchmark time
+    std::vector<folly::SemiFuture<folly::Unit>> sfs;
+    for (size_t idx = 0; idx < numOfAreas; idx++) {
+      sfs.emplace_back(kvStore->getKvStore()->setKvStoreKeyVals(
+          std::move(params.at(idx)), areas.at(idx).area_id));
+    }
+    folly::collectAll(std::move(sfs)).get();
+    // Wait for updates of all areas to reach peer
+    waitForKeys(numOfAreas * kNumOfFloodKeys);
+    suspender.rehire(); // Stop measuring time again
+  }
+}
+
+/**
+ * Benchmark for compressing a full-sync publication sent to a peer
+ * 1. Create a publication of numOfKeys adjacency database values, as it would
+ *    be sent in response to a KEY_DUMP request
+ * 2. Compress the serialized publication
+ * Serialized and compressed sizes are reported as counters
+ */
+static void
+BM_KvStoreCompressPublication(
+    folly::UserCounters& counters, uint32_t iters, size_t numOfKeys) {
+  auto suspender = folly::BenchmarkSuspender();
+  apache::thrift::CompactSerializer serializer;
+  std::unordered_map<std::string, thrift::Value> keyVals;
+  for (size_t i = 0; i < numOfKeys; i++) {
+    auto const nodeName = folly::sformat("node-{}", i);
+    std::vector<thrift::Adjacency> adjs;
+    for (int j = 0; j < kNumOfAdjacencies; j++) {
+      adjs.emplace_back(createAdjacency(
+          folly::sformat("node-{}", (i + j + 1) % numOfKeys),
+          folly::sformat("po{}", j),
+          folly::sformat("po{}", j),
+          folly::sformat("fe80::{}:{}", i, j),
+          folly::sformat("10.{}.{}.{}", i % 256, i / 256 % 256, j),
+          10 /* metric */,
+          100000 + j /* adjLabel */));
+    }
+    auto thriftVal = createThriftValue(
+        1 /* version */,
+        nodeName,
+        fbzmq::util::writeThriftObjStr(
+            createAdjDb(nodeName, adjs, i + 1), serializer));
+    thriftVal.hash_ref() = generateHash(
+        thriftVal.version, thriftVal.originatorId, thriftVal.value_ref());
+    keyVals.emplace(
+        folly::sformat("{}{}", Constants::kAdjDbMarker.toString(), nodeName),
+        std::move(thriftVal));
+  }
+  auto const payload = fbzmq::util::writeThriftObjStr(
+      createThriftPublication(keyVals, {}), serializer);
+
+  std::string compressed;
+  suspender.dismiss(); // Start measuring benchmark time
+  for (uint32_t i = 0; i < iters; i++) {
+    compressed = KvStore::compressPayload(folly::StringPiece(payload));
+    folly::doNotOptimizeAway(compressed);
+  }
+  suspender.rehire(); // Stop measuring time again
+
+  counters["raw_bytes"] = payload.size();
+  counters["compressed_bytes"] = compressed.size();
+}
+
+/**
+ * Benchmark for matching keys against KvStore filters
+ * 1. Create kNumOfFilterKeys keys of adjacency, prefix and other types
+ * 2. Match every key against filters of key prefixes and originator IDs.
+ *    Key prefixes are literal prefixes or regexes matching the same keys
+ */
+static void
+BM_KvStoreFiltersKeyMatch(uint32_t iters, bool useRegex) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::vector<std::string> markers{
+      Constants::kAdjDbMarker.toString(),
+      Constants::kPrefixDbMarker.toString(),
+      "allocprefix:",
+      "e2e:"};
+  std::vector<std::pair<std::string, thrift::Value>> keyVals;
+  keyVals.reserve(kNumOfFilterKeys);
+  for (uint32_t idx = 0; idx < kNumOfFilterKeys; idx++) {
+    auto const nodeName = folly::sformat("node-{}", idx % 1000);
+    auto const& marker = markers.at(idx % markers.size());
+    keyVals.emplace_back(
+        folly::sformat("{}{}:{}", marker, nodeName, idx),
+        createThriftValue(1 /* version */, nodeName, std::nullopt));
+  }
+  std::vector<std::string> keyPrefixes;
+  for (size_t i = 0; i + 1 < markers.size(); i++) {
+    keyPrefixes.emplace_back(
+        useRegex ? folly::sformat("{}[a-z]", markers.at(i)) : markers.at(i));
+  }
+  // half of the nodes
+  std::set<std::string> originatorIds;
+  for (uint32_t idx = 0; idx < 500; idx++) {
+    originatorIds.emplace(folly::sformat("node-{}", idx));
+  }
+  const KvStoreFilters filters(keyPrefixes, originatorIds);
+
+  size_t numOfMatches{0};
+  suspender.dismiss(); // Start measuring benchmark time
+  for (uint32_t i = 0; i < iters; i++) {
+    for (auto const& [key, value] : keyVals) {
+      numOfMatches +=
+          filters.keyMatch(key, value, thrift::FilterOperator::AND) ? 1 : 0;
+    }
+  }
+  suspender.rehire(); // Stop measuring time again
+  CHECK_EQ(iters * kNumOfFilterKeys * 3 / 8, numOfMatches);
+}
+
 // The first integer parameter is number of keyVals already in store
 // The second integer parameter is the number of keyVals for update
 BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10_10, 10, 10);
@@ -294,6 +681,14 @@ BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_100, 10000, 100);
 BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_1000, 10000, 1000);
 BENCHMARK_NAMED_PARAM(BM_KvStoreMergeKeyValues, 10000_10000, 10000, 10000);
 
+// The parameter is the byte size of values
+BENCHMARK_PARAM(BM_KvStoreMergeKeyValuesLargeValue, 1024);
+BENCHMARK_PARAM(BM_KvStoreMergeKeyValuesLargeValue, 65536);
+BENCHMARK_PARAM(BM_KvStoreMergeKeyValuesLargeValue, 1048576);
+BENCHMARK_PARAM(BM_KvStoreMergeKeyValuesDuplicates, 1024);
+BENCHMARK_PARAM(BM_KvStoreMergeKeyValuesDuplicates, 65536);
+BENCHMARK_PARAM(BM_KvStoreMergeKeyValuesDuplicates, 1048576);
+
 // The parameter is number of keyVals already in store
 BENCHMARK_PARAM(BM_KvStoreDumpAll, 10);
 BENCHMARK_PARAM(BM_KvStoreDumpAll, 100);
@@ -306,6 +701,33 @@ BENCHMARK_PARAM(BM_KvStoreFloodingUpdate, 100);
 BENCHMARK_PARAM(BM_KvStoreFloodingUpdate, 1000);
 BENCHMARK_PARAM(BM_KvStoreFloodingUpdate, 10000);
 
+// The parameter is number of keyVals with TTL already in store
+BENCHMARK_PARAM(BM_KvStoreFloodingTtlKeys, 100000);
+BENCHMARK_PARAM(BM_KvStoreFloodingTtlKeys, 1000000);
+
+// The parameter is number of peers to flood to
+BENCHMARK_PARAM(BM_KvStoreFloodingToPeers, 1);
+BENCHMARK_PARAM(BM_KvStoreFloodingToPeers, 16);
+BENCHMARK_PARAM(BM_KvStoreFloodingToPeers, 64);
+
+// The first integer parameter is number of areas
+// The second parameter enables per area threads
+BENCHMARK_NAMED_PARAM(BM_KvStoreMultiAreaFlooding, 1_shared, 1, false);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMultiAreaFlooding, 1_per_area, 1, true);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMultiAreaFlooding, 4_shared, 4, false);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMultiAreaFlooding, 4_per_area, 4, true);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMultiAreaFlooding, 16_shared, 16, false);
+BENCHMARK_NAMED_PARAM(BM_KvStoreMultiAreaFlooding, 16_per_area, 16, true);
+
+// The parameter is number of keys in the publication
+BENCHMARK_COUNTERS_PARAM(BM_KvStoreCompressPublication, counters, 100);
+BENCHMARK_COUNTERS_PARAM(BM_KvStoreCompressPublication, counters, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_KvStoreCompressPublication, counters, 10000);
+
+// The parameter is whether key prefixes are regexes instead of literals
+BENCHMARK_NAMED_PARAM(BM_KvStoreFiltersKeyMatch, literal, false);
+BENCHMARK_NAMED_PARAM(BM_KvStoreFiltersKeyMatch, regex, true);
+
 } // namespace openr
 
 int
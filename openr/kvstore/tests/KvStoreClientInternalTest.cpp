@@ -163,7 +163,7 @@ class MultipleStoreFixture : public ::testing::Test {
         &evb,
         node2,
         store2->getKvStore(),
-        persistKeyTimer /* checkPersistKeyPeriod */);
+        true /* restoreExpiredKeys */);
 
     client3 = std::make_shared<KvStoreClientInternal>(
         &evb, node3, store3->getKvStore());
@@ -471,7 +471,7 @@ TEST(KvStoreClientInternal, EmptyValueKey) {
 
   // create kvstore client for store 1
   auto client1 = std::make_shared<KvStoreClientInternal>(
-      &evb, store1->getNodeId(), store1->getKvStore(), 1000ms);
+      &evb, store1->getNodeId(), store1->getKvStore());
 
   // Schedule callback to set keys from client1 (this will be executed first)
   evb.scheduleTimeout(
@@ -602,9 +602,9 @@ TEST(KvStoreClientInternal, PersistKeyTest) {
   // Create another OpenrEventBase instance for looping clients
   OpenrEventBase evb;
 
-  // Create and initialize kvstore-client, with persist key timer
+  // Create and initialize kvstore-client
   auto client1 = std::make_shared<KvStoreClientInternal>(
-      &evb, nodeId, store->getKvStore(), 1000ms);
+      &evb, nodeId, store->getKvStore());
 
   // Schedule callback to set keys from client1 (this will be executed first)
   evb.scheduleTimeout(std::chrono::milliseconds(0), [&]() noexcept {
@@ -642,7 +642,7 @@ TEST(KvStoreClientInternal, PersistKeyTest) {
   });
 
   // Schedule after a second, key will be erased and set back in kvstore
-  // with persist key check callback
+  // when client learns about its expiry
   evb.scheduleTimeout(std::chrono::milliseconds(3000), [&]() noexcept {
     auto maybeVal3 = client1->getKey("test_key3");
     ASSERT_TRUE(maybeVal3.has_value());
@@ -672,6 +672,71 @@ TEST(KvStoreClientInternal, PersistKeyTest) {
   evbThread.join();
 }
 
+/**
+ * Test persisted key is restored promptly by the client every time it expires
+ * from KvStore. Key is expired by updating its TTL to 1ms with a higher TTL
+ * version, as if client's TTL refreshes were lost.
+ */
+TEST(KvStoreClientInternal, PersistKeyExpiryTest) {
+  fbzmq::Context context;
+  const std::string nodeId{"test_store"};
+
+  auto config = std::make_shared<Config>(getBasicOpenrConfig(nodeId));
+  auto store = std::make_shared<KvStoreWrapper>(context, config);
+  store->run();
+
+  OpenrEventBase evb;
+  auto client1 = std::make_shared<KvStoreClientInternal>(
+      &evb, nodeId, store->getKvStore());
+  evb.scheduleTimeout(std::chrono::milliseconds(0), [&]() noexcept {
+    client1->persistKey("test_key", "test_value");
+  });
+
+  std::thread evbThread([&]() { evb.run(); });
+  evb.waitUntilRunning();
+
+  // Wait for key advertised by client with infinite TTL. Returns false if it
+  // doesn't show up within a second
+  auto waitForPersistedKey = [&]() {
+    for (int i = 0; i < 100; ++i) {
+      auto maybeVal = store->getKey("test_key");
+      if (maybeVal.has_value() and maybeVal->ttl == Constants::kTtlInfinity) {
+        EXPECT_EQ(1, maybeVal->version);
+        EXPECT_EQ("test_value", maybeVal->value_ref());
+        return true;
+      }
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  };
+  ASSERT_TRUE(waitForPersistedKey());
+
+  // Expire key in quick succession. Every loss must be restored right away
+  // and not be delayed by compounding backoff
+  for (int i = 1; i <= 3; ++i) {
+    EXPECT_TRUE(store->setKey(
+        "test_key",
+        createThriftValue(
+            1,
+            nodeId,
+            std::string("test_value"),
+            1 /* ttl in msec */,
+            100 * i /* ttl version */,
+            0 /* hash */)));
+    ASSERT_TRUE(waitForPersistedKey()) << "Key not restored after loss " << i;
+  }
+
+  store->closeQueue();
+  client1.reset();
+  store->stop();
+  store.reset();
+
+  evb.stop();
+  evb.waitUntilStopped();
+  evbThread.join();
+}
+
 /**
  * Test ttl change with persist key while keeping value and version same
  * - Set key with ttl 1s
@@ -699,9 +764,9 @@ TEST(KvStoreClientInternal, PersistKeyChangeTtlTest) {
   // Create another OpenrEventBase instance for looping clients
   OpenrEventBase evb;
 
-  // Create and initialize kvstore-client, with persist key timer
+  // Create and initialize kvstore-client
   auto client1 = std::make_unique<KvStoreClientInternal>(
-      &evb, nodeId, store->getKvStore(), 1000ms);
+      &evb, nodeId, store->getKvStore());
 
   // Schedule callback to set keys from client1 (this will be executed first)
   evb.scheduleTimeout(std::chrono::seconds(0), [&]() noexcept {
@@ -1480,14 +1545,14 @@ TEST_F(MultipleAreaFixture, MultipleAreaKeyExpiry) {
 }
 
 /*
- * this test checks if the checkPersistKeyInStore() works when multiple
+ * this test checks if expired persisted keys are restored when multiple
  * areas are instantiated in the KvStore, with one area having emtpy
  * persistKeyDB.
  *
  * 1. add key in node2 by calling persistKey()
  * 2. use the kvstore API to delete the key in node2 be setting a short TTL
  * 3. verify key is deleted from node2 kvstore
- * 4. wait until checkPersistKeyInStore() kicks in to repopulate the key
+ * 4. wait until client learns about expiry and repopulates the key
  * 5. verify kvstore in node2 has the key
  */
 TEST_F(MultipleAreaFixture, PersistKeyArea) {
@@ -1534,7 +1599,7 @@ TEST_F(MultipleAreaFixture, PersistKeyArea) {
             client2->getKey("test_ttl_key_plane", planeArea).has_value());
       });
 
-  // checkPersistKey should kick in and repopulate the key node1 kvstore,
+  // expired persisted key should be re-advertised into node2 kvstore,
   evb.scheduleTimeout(
       std::chrono::milliseconds(scheduleAt += persistKeyTimer.count() + 500),
       [&]() noexcept {
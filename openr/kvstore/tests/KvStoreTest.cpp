@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <set>
 #include <thread>
 #include <tuple>
 #include <unordered_set>
@@ -2572,6 +2573,312 @@ TEST_F(KvStoreTestFixture, FullSync) {
   EXPECT_EQ(v4->value_ref().value(), "b");
 }
 
+/**
+ * Verify bucket hash summary is order independent and reflects key-value
+ * updates only in the bucket of the key
+ */
+TEST(KvStoreHashBuckets, BucketHashes) {
+  KvStoreHashBuckets bucketsA;
+  KvStoreHashBuckets bucketsB;
+  EXPECT_EQ(bucketsA.getBucketHashes(), bucketsB.getBucketHashes());
+
+  std::vector<std::pair<std::string, thrift::Value>> keyVals;
+  for (int i = 0; i < 100; ++i) {
+    keyVals.emplace_back(
+        folly::sformat("key{}", i),
+        createThriftValue(1, "storeA", folly::sformat("value{}", i)));
+  }
+  for (auto const& [key, value] : keyVals) {
+    bucketsA.toggle(key, value);
+  }
+  for (auto it = keyVals.rbegin(); it != keyVals.rend(); ++it) {
+    bucketsB.toggle(it->first, it->second);
+  }
+  EXPECT_EQ(bucketsA.getBucketHashes(), bucketsB.getBucketHashes());
+  auto mismatched = bucketsA.getMismatchedBuckets(bucketsB.getBucketHashes());
+  EXPECT_EQ(0, std::count(mismatched.begin(), mismatched.end(), true));
+
+  // ttl version bump of one key in B doesn't change its bucket
+  auto const& [key, value] = keyVals.front();
+  auto newValue = value;
+  newValue.ttlVersion += 1;
+  bucketsB.toggle(key, value);
+  bucketsB.toggle(key, newValue);
+  EXPECT_EQ(bucketsA.getBucketHashes(), bucketsB.getBucketHashes());
+
+  // version bump of the key in B changes its bucket only
+  bucketsB.toggle(key, newValue);
+  newValue.version += 1;
+  bucketsB.toggle(key, newValue);
+  mismatched = bucketsA.getMismatchedBuckets(bucketsB.getBucketHashes());
+  EXPECT_EQ(1, std::count(mismatched.begin(), mismatched.end(), true));
+  EXPECT_TRUE(mismatched.at(KvStoreHashBuckets::getBucket(key)));
+
+  // removing the key from both makes them consistent again
+  bucketsA.toggle(key, value);
+  bucketsB.toggle(key, newValue);
+  EXPECT_EQ(bucketsA.getBucketHashes(), bucketsB.getBucketHashes());
+
+  // different number of buckets
+  mismatched = bucketsA.getMismatchedBuckets({});
+  EXPECT_EQ(Constants::kNumOfKvStoreSyncBuckets, mismatched.size());
+  EXPECT_TRUE(std::all_of(
+      mismatched.begin(), mismatched.end(), [](bool b) { return b; }));
+}
+
+/**
+ * Same as FullSync but peers exchange bucket hash summary instead of per key
+ * hashes. Only keys in mismatched buckets are sent over
+ */
+TEST_F(KvStoreTestFixture, FullSyncHashBuckets) {
+  auto kvConf = getTestKvConf();
+  kvConf.enable_hash_bucket_sync_ref() = true;
+  auto storeA = createKvStore("storeA", kvConf);
+  auto storeB = createKvStore("storeB", kvConf);
+  storeA->run();
+  storeB->run();
+
+  // common keys in both stores
+  for (int i = 0; i < 100; ++i) {
+    auto const val = createThriftValue(
+        1, "storeA", "common", 30000, 1, generateHash(1, "storeA", "common"));
+    EXPECT_TRUE(storeA->setKey(folly::sformat("common{}", i), val));
+    EXPECT_TRUE(storeB->setKey(folly::sformat("common{}", i), val));
+  }
+
+  // storeA has (k0, 5, a), (k1, 1, a), (k2, 9, a)
+  // storeB has             (k1, 1, a), (k2, 1, b), (k3, 6, b)
+  std::vector<std::tuple<std::string, int, std::string>> keyValAs = {
+      {"key0", 5, "a"}, {"key1", 1, "a"}, {"key2", 9, "a"}};
+  std::vector<std::tuple<std::string, int, std::string>> keyValBs = {
+      {"key1", 1, "a"}, {"key2", 1, "b"}, {"key3", 6, "b"}};
+  for (auto const& [key, version, value] : keyValAs) {
+    EXPECT_TRUE(storeA->setKey(
+        key,
+        createThriftValue(
+            version,
+            "storeA",
+            value,
+            30000,
+            1,
+            generateHash(version, "storeA", value))));
+  }
+  for (auto const& [key, version, value] : keyValBs) {
+    EXPECT_TRUE(storeB->setKey(
+        key,
+        createThriftValue(
+            version,
+            "storeA",
+            value,
+            30000,
+            1,
+            generateHash(version, "storeA", value))));
+  }
+
+  // B responds to hash summary of A with its keys in mismatched buckets only,
+  // i.e. buckets of key0, key2 and key3
+  {
+    KvStoreHashBuckets hashBucketsA;
+    for (auto const& [key, val] : storeA->dumpAll()) {
+      hashBucketsA.toggle(key, val);
+    }
+    std::set<int32_t> expectedBuckets;
+    for (auto const& key : {"key0", "key2", "key3"}) {
+      expectedBuckets.emplace(KvStoreHashBuckets::getBucket(key));
+    }
+    std::set<std::string> expectedKeys;
+    for (auto const& [key, _] : storeB->dumpAll()) {
+      if (expectedBuckets.count(KvStoreHashBuckets::getBucket(key))) {
+        expectedKeys.emplace(key);
+      }
+    }
+
+    thrift::KeyDumpParams params;
+    params.keyValHashBuckets_ref() = hashBucketsA.getBucketHashes();
+    auto const pub =
+        *(storeB->getKvStore()->dumpKvStoreKeys(std::move(params)).get());
+    ASSERT_TRUE(pub.syncBuckets_ref().has_value());
+    EXPECT_EQ(
+        expectedBuckets,
+        std::set<int32_t>(
+            pub.syncBuckets_ref()->begin(), pub.syncBuckets_ref()->end()));
+    std::set<std::string> keys;
+    for (auto const& [key, _] : pub.keyVals) {
+      keys.emplace(key);
+    }
+    EXPECT_EQ(expectedKeys, keys);
+    EXPECT_GT(10, keys.size());
+  }
+
+  // let A sends a full sync request to B and wait for completion
+  storeA->addPeer("storeB", storeB->getPeerSpec());
+  while (storeA->dumpAll().size() != 104 or storeB->dumpAll().size() != 104 or
+         storeB->getKey("key2")->version != 9) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // after full-sync, we expect both A and B have:
+  // (k0, 5, a), (k1, 1, a), (k2, 9, a), (k3, 6, b) along with common keys
+  auto const dumpA = storeA->dumpAll();
+  auto const dumpB = storeB->dumpAll();
+  EXPECT_EQ(104, dumpA.size());
+  EXPECT_EQ(dumpA.size(), dumpB.size());
+  for (auto const& [key, valA] : dumpA) {
+    ASSERT_EQ(1, dumpB.count(key));
+    EXPECT_EQ(valA.version, dumpB.at(key).version);
+    EXPECT_EQ(valA.value_ref(), dumpB.at(key).value_ref());
+  }
+  EXPECT_EQ(9, dumpA.at("key2").version);
+  EXPECT_EQ("a", dumpA.at("key2").value_ref().value());
+  EXPECT_EQ(6, dumpA.at("key3").version);
+  EXPECT_EQ("b", dumpA.at("key3").value_ref().value());
+}
+
+/**
+ * Same as FullSync but with compression enabled on both stores. Values are
+ * large enough for full-sync and flooding messages to be sent compressed
+ */
+TEST_F(KvStoreTestFixture, FullSyncCompression) {
+  auto kvConf = getTestKvConf();
+  kvConf.enable_compression_ref() = true;
+  auto storeA = createKvStore("storeA", kvConf);
+  auto storeB = createKvStore("storeB", kvConf);
+  storeA->run();
+  storeB->run();
+
+  auto createValue = [](std::string const& originatorId, int version) {
+    const std::string value(2048, originatorId.back());
+    return createThriftValue(
+        version,
+        originatorId,
+        value,
+        Constants::kTtlInfinity,
+        0,
+        generateHash(version, originatorId, value));
+  };
+
+  // distinct keys in both stores
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(
+        storeA->setKey(folly::sformat("keyA{}", i), createValue("storeA", 1)));
+    EXPECT_TRUE(
+        storeB->setKey(folly::sformat("keyB{}", i), createValue("storeB", 1)));
+  }
+
+  // let A and B full-sync with each other and wait for completion
+  EXPECT_TRUE(storeA->getPeerSpec().supportCompression);
+  storeA->addPeer("storeB", storeB->getPeerSpec());
+  storeB->addPeer("storeA", storeA->getPeerSpec());
+  auto const isSyncing = [](auto& store) {
+    return store->dumpAll().size() != 20 or
+        store->getCounters().at("kvstore.pending_full_sync") != 0;
+  };
+  while (isSyncing(storeA) or isSyncing(storeB)) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(storeA->dumpAll(), storeB->dumpAll());
+
+  // full-sync responses went compressed in both directions
+  auto const syncCompressedA =
+      storeA->getCounters().at("kvstore.compressed_msgs_sent");
+  auto const syncCompressedB =
+      storeB->getCounters().at("kvstore.compressed_msgs_sent");
+  EXPECT_LT(0, syncCompressedA);
+  EXPECT_LT(0, syncCompressedB);
+
+  // flood a key from A to B
+  auto const value = createValue("storeA", 2);
+  EXPECT_TRUE(storeA->setKey("keyA0", value));
+  while (true) {
+    auto pub = storeB->recvPublication();
+    if (pub.keyVals.count("keyA0") and pub.keyVals.at("keyA0").version == 2) {
+      break;
+    }
+  }
+  EXPECT_EQ(value.value_ref(), storeB->getKey("keyA0")->value_ref());
+  EXPECT_LT(
+      syncCompressedA,
+      storeA->getCounters().at("kvstore.compressed_msgs_sent"));
+}
+
+/**
+ * Compression enabled on storeA only. storeA compresses towards storeB, which
+ * decompresses it. storeB compresses only full-sync responses storeA asked
+ * for and floods uncompressed
+ */
+TEST_F(KvStoreTestFixture, FullSyncCompressionMixed) {
+  auto kvConf = getTestKvConf();
+  kvConf.enable_compression_ref() = true;
+  auto storeA = createKvStore("storeA", kvConf);
+  auto storeB = createKvStore("storeB", getTestKvConf());
+  storeA->run();
+  storeB->run();
+
+  auto createValue = [](std::string const& originatorId, int version) {
+    const std::string value(2048, originatorId.back());
+    return createThriftValue(
+        version,
+        originatorId,
+        value,
+        Constants::kTtlInfinity,
+        0,
+        generateHash(version, originatorId, value));
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(
+        storeA->setKey(folly::sformat("keyA{}", i), createValue("storeA", 1)));
+    EXPECT_TRUE(
+        storeB->setKey(folly::sformat("keyB{}", i), createValue("storeB", 1)));
+  }
+
+  // peer specs as LinkMonitor creates them: both stores advertise support,
+  // only storeA has compression enabled
+  auto peerSpecA = storeA->getPeerSpec();
+  peerSpecA.supportCompression = false;
+  auto peerSpecB = storeB->getPeerSpec();
+  peerSpecB.supportCompression = true;
+  storeA->addPeer("storeB", peerSpecB);
+  storeB->addPeer("storeA", peerSpecA);
+  auto const isSyncing = [](auto& store) {
+    return store->dumpAll().size() != 20 or
+        store->getCounters().at("kvstore.pending_full_sync") != 0;
+  };
+  while (isSyncing(storeA) or isSyncing(storeB)) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(storeA->dumpAll(), storeB->dumpAll());
+  auto const syncCompressedA =
+      storeA->getCounters().at("kvstore.compressed_msgs_sent");
+  auto const syncCompressedB =
+      storeB->getCounters().at("kvstore.compressed_msgs_sent");
+  EXPECT_LT(0, syncCompressedA);
+  EXPECT_LT(0, syncCompressedB);
+
+  // flood a key in both directions
+  auto const valueA = createValue("storeA", 2);
+  auto const valueB = createValue("storeB", 2);
+  EXPECT_TRUE(storeA->setKey("keyA0", valueA));
+  EXPECT_TRUE(storeB->setKey("keyB0", valueB));
+  while (storeB->getKey("keyA0")->version != 2 or
+         storeA->getKey("keyB0")->version != 2) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(valueA.value_ref(), storeB->getKey("keyA0")->value_ref());
+  EXPECT_EQ(valueB.value_ref(), storeA->getKey("keyB0")->value_ref());
+
+  EXPECT_LT(
+      syncCompressedA,
+      storeA->getCounters().at("kvstore.compressed_msgs_sent"));
+  EXPECT_EQ(
+      syncCompressedB,
+      storeB->getCounters().at("kvstore.compressed_msgs_sent"));
+}
+
 /* Kvstore tests related to area */
 
 /* Verify flooding is containted within an area. Add a key in one area and
@@ -2742,6 +3049,73 @@ TEST_F(KvStoreTestFixture, KeySyncMultipleArea) {
   evb.loop();
 }
 
+/**
+ * Same as KeySyncMultipleArea but KvStoreDb of every area runs on its own
+ * thread. Keys must stay within their area and counters of all areas must be
+ * added up
+ */
+TEST_F(KvStoreTestFixture, KeySyncMultipleAreaPerAreaThreads) {
+  auto kvConf = getTestKvConf();
+  kvConf.enable_per_area_threads_ref() = true;
+
+  thrift::AreaConfig pod, plane;
+  pod.area_id = "pod-area";
+  pod.neighbor_regexes.emplace_back(".*");
+  plane.area_id = "plane-area";
+  plane.neighbor_regexes.emplace_back(".*");
+
+  auto storeA = createKvStore("storeA", kvConf, {pod, plane});
+  auto storeB = createKvStore("storeB", kvConf, {pod, plane});
+  storeA->run();
+  storeB->run();
+
+  for (auto const& area : {pod.area_id, plane.area_id}) {
+    EXPECT_TRUE(storeA->addPeer("storeB", storeB->getPeerSpec(), area));
+    EXPECT_TRUE(storeB->addPeer("storeA", storeA->getPeerSpec(), area));
+  }
+
+  // set a key in each area of storeA
+  const auto podVal = createThriftValue(
+      1,
+      "storeA",
+      "pod",
+      Constants::kTtlInfinity,
+      0,
+      generateHash(1, "storeA", "pod"));
+  const auto planeVal = createThriftValue(
+      1,
+      "storeA",
+      "plane",
+      Constants::kTtlInfinity,
+      0,
+      generateHash(1, "storeA", "plane"));
+  EXPECT_TRUE(storeA->setKey("pod-key", podVal, std::nullopt, pod.area_id));
+  EXPECT_TRUE(
+      storeA->setKey("plane-key", planeVal, std::nullopt, plane.area_id));
+
+  // wait for both keys to be flooded to storeB
+  std::unordered_set<std::string> receivedKeys;
+  while (receivedKeys.size() < 2) {
+    auto pub = storeB->recvPublication();
+    for (auto const& [key, _] : pub.keyVals) {
+      receivedKeys.emplace(key);
+    }
+  }
+
+  // keys are only present in their own area
+  EXPECT_EQ(podVal, storeB->getKey("pod-key", pod.area_id));
+  EXPECT_FALSE(storeB->getKey("pod-key", plane.area_id).has_value());
+  EXPECT_EQ(planeVal, storeB->getKey("plane-key", plane.area_id));
+  EXPECT_FALSE(storeB->getKey("plane-key", pod.area_id).has_value());
+  EXPECT_EQ(1, storeB->dumpAll(std::nullopt, pod.area_id).size());
+  EXPECT_EQ(1, storeB->dumpAll(std::nullopt, plane.area_id).size());
+
+  // counters are added up across areas
+  auto counters = storeB->getCounters();
+  EXPECT_EQ(2, counters.at("kvstore.num_keys"));
+  EXPECT_EQ(2, counters.at("kvstore.num_peers"));
+}
+
 /**
  * Verify correctness of initial full sync rate limiting.
  *
@@ -265,6 +265,55 @@ TEST(KvStore, mergeKeyValuesTest) {
   }
 }
 
+//
+// validate mergeKeyValues of rvalue update
+//
+TEST(KvStore, mergeKeyValuesMoveTest) {
+  // values with hash, as they are when flooded between stores
+  auto createValue = [](int64_t version,
+                        std::string const& originatorId,
+                        std::string const& value) {
+    return createThriftValue(
+        version,
+        originatorId,
+        value,
+        Constants::kTtlInfinity /* ttl */,
+        0 /* ttl version */,
+        generateHash(version, originatorId, value));
+  };
+
+  std::unordered_map<std::string, thrift::Value> myStore;
+  myStore.emplace("key1", createValue(5, "node5", "value1"));
+  myStore.emplace("key2", createValue(5, "node5", "value2"));
+
+  std::unordered_map<std::string, thrift::Value> update;
+  // newer version
+  update.emplace("key1", createValue(6, "node5", "value1-new"));
+  // older version
+  update.emplace("key2", createValue(4, "node5", "value2-old"));
+  // new key
+  update.emplace("key3", createValue(1, "node1", "value3"));
+  const auto expStore = std::unordered_map<std::string, thrift::Value>{
+      {"key1", update.at("key1")},
+      {"key2", myStore.at("key2")},
+      {"key3", update.at("key3")}};
+  const auto expKeyVals = std::unordered_map<std::string, thrift::Value>{
+      {"key1", update.at("key1")}, {"key3", update.at("key3")}};
+
+  auto keyVals = KvStore::mergeKeyValues(myStore, std::move(update));
+  EXPECT_EQ(expStore, myStore);
+  EXPECT_EQ(expKeyVals, keyVals);
+  // accepted key-values are moved out, rejected ones are left behind
+  EXPECT_EQ(1, update.size());
+  EXPECT_EQ(1, update.count("key2"));
+
+  // same value again (equal hash) is not announced
+  update = expKeyVals;
+  keyVals = KvStore::mergeKeyValues(myStore, std::move(update));
+  EXPECT_EQ(expStore, myStore);
+  EXPECT_EQ(0, keyVals.size());
+}
+
 //
 // Test compareValues method
 //
@@ -345,6 +394,34 @@ TEST(KvStore, compareValuesTest) {
   }
 }
 
+//
+// Test compressPayload/decompressPayload methods
+//
+TEST(KvStore, compressPayloadTest) {
+  const std::string payload(4096, 'x');
+  auto compressed = KvStore::compressPayload(folly::StringPiece(payload));
+  EXPECT_LT(compressed.size(), payload.size());
+  EXPECT_EQ(
+      payload,
+      KvStore::decompressPayload(
+          compressed, Constants::kKvStoreMaxUncompressedSize));
+
+  // exactly at and beyond the uncompressed size limit
+  EXPECT_EQ(payload, KvStore::decompressPayload(compressed, payload.size()));
+  EXPECT_ANY_THROW(KvStore::decompressPayload(compressed, payload.size() - 1));
+
+  // empty payload
+  EXPECT_EQ(
+      "",
+      KvStore::decompressPayload(
+          KvStore::compressPayload({}),
+          Constants::kKvStoreMaxUncompressedSize));
+
+  // malformed payload
+  EXPECT_ANY_THROW(KvStore::decompressPayload(
+      payload, Constants::kKvStoreMaxUncompressedSize));
+}
+
 //
 // Test dumpAllWithThriftClient API
 //
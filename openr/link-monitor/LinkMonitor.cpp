@@ -95,6 +95,10 @@ LinkMonitor::LinkMonitor(
       prefixForwardingAlgorithm_(
           config->getConfig().prefix_forwarding_algorithm),
       useRttMetric_(config->getLinkMonitorConfig().use_rtt_metric),
+      enablePerAdjacencyKeys_(
+          config->getLinkMonitorConfig().enable_per_adjacency_keys),
+      enableKvStoreCompression_(
+          config->getKvStoreConfig().enable_compression_ref().value_or(false)),
       linkflapInitBackoff_(std::chrono::milliseconds(
           config->getLinkMonitorConfig().linkflap_initial_backoff_ms)),
       linkflapMaxBackoff_(std::chrono::milliseconds(
@@ -152,6 +156,7 @@ LinkMonitor::LinkMonitor(
   if (state.hasValue()) {
     LOG(INFO) << "Loaded link-monitor state from disk.";
     state_ = state.value();
+    storedState_ = state_;
     printLinkMonitorState(state_);
   } else {
     // no persistent store found, use assumeDrained
@@ -170,7 +175,7 @@ LinkMonitor::LinkMonitor(
 
   //  Create KvStore client
   kvStoreClient_ = std::make_unique<KvStoreClientInternal>(
-      this, nodeId_, kvStore, std::nullopt /* persist key timer */);
+      this, nodeId_, kvStore, false /* restoreExpiredKeys */);
 
   if (enableSegmentRouting_) {
     // create range allocator to get unique node labels
@@ -439,6 +444,9 @@ LinkMonitor::neighborUpEvent(const thrift::SparkNeighborEvent& event) {
   peerSpec.peerAddr = peerAddr;
   peerSpec.ctrlPort = openrCtrlThriftPort;
   peerSpec.supportFloodOptimization = event.supportFloodOptimization;
+  // compress only if enabled locally and neighbor advertised support
+  peerSpec.supportCompression =
+      enableKvStoreCompression_ and event.supportCompression;
   adjacencies_[adjId] =
       AdjacencyValue(peerSpec, std::move(newAdj), false, area);
 
@@ -674,14 +682,24 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
 
   LOG(INFO) << "Updating adjacency database in KvStore with "
             << adjDb.adjacencies.size() << " entries in area: " << area;
+  if (enablePerAdjacencyKeys_) {
+    // Adjacencies go out under their own keys before the node key so that
+    // receivers never see the node without its adjacencies. Node key carries
+    // node attributes only
+    advertisePerAdjacencyKeys(area, std::move(adjDb.adjacencies));
+    adjDb.adjacencies.clear();
+  }
   const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
   std::string adjDbStr = fbzmq::util::writeThriftObjStr(adjDb, serializer_);
   kvStoreClient_->persistKey(keyName, adjDbStr, ttlKeyInKvStore_, area);
   fb303::fbData->addStatValue(
       "link_monitor.advertise_adjacencies", 1, fb303::SUM);
 
-  // Config is most likely to have changed. Update it in `ConfigStore`
-  configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
+  // Config may have changed. Update it in `ConfigStore` if it did
+  if (not storedState_.has_value() or not(*storedState_ == state_)) {
+    configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
+    storedState_ = state_;
+  }
 
   // Update some flat counters
   fb303::fbData->setCounter("link_monitor.adjacencies", adjacencies_.size());
@@ -691,6 +709,45 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
         "link_monitor.metric." + adj.otherNodeName, adj.metric);
   }
 }
+
+void
+LinkMonitor::advertisePerAdjacencyKeys(
+    const std::string& area, std::vector<thrift::Adjacency>&& adjacencies) {
+  auto& advertisedKeys = perAdjacencyKeys_[area];
+  std::unordered_set<std::string> keysToClear;
+  std::swap(keysToClear, advertisedKeys);
+
+  for (auto& adj : adjacencies) {
+    auto key = getPerAdjacencyKey(nodeId_, adj.otherNodeName, adj.ifName);
+    thrift::AdjacencyDatabase adjDb;
+    adjDb.thisNodeName = nodeId_;
+    adjDb.area = area;
+    adjDb.adjacencies.emplace_back(std::move(adj));
+    // persistKey doesn't flood the key if value is unchanged
+    kvStoreClient_->persistKey(
+        key,
+        fbzmq::util::writeThriftObjStr(adjDb, serializer_),
+        ttlKeyInKvStore_,
+        area);
+    keysToClear.erase(key);
+    advertisedKeys.emplace(std::move(key));
+  }
+
+  for (auto const& key : keysToClear) {
+    LOG(INFO) << "Withdrawing key: " << key << " from KvStore area: " << area;
+    // one last key set with no adjacencies signifies withdraw then the key
+    // should ttl out
+    thrift::AdjacencyDatabase adjDb;
+    adjDb.thisNodeName = nodeId_;
+    adjDb.area = area;
+    kvStoreClient_->clearKey(
+        key,
+        fbzmq::util::writeThriftObjStr(adjDb, serializer_),
+        ttlKeyInKvStore_,
+        area);
+  }
+}
+
 void
 LinkMonitor::advertiseAdjacencies() {
   // advertise to all areas. Once area configuration per link is implemented
@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -249,6 +250,13 @@ class LinkMonitor final : public OpenrEventBase {
   void advertiseAdjacencies(const std::string& area);
   void advertiseAdjacencies(); // Advertise my adjacencies_ in to all areas
 
+  /*
+   * [Kvstore] Advertise every adjacency under its own key and withdraw keys of
+   * adjacencies which are gone. Only keys whose value changed get flooded.
+   */
+  void advertisePerAdjacencyKeys(
+      const std::string& area, std::vector<thrift::Adjacency>&& adjacencies);
+
   /*
    * [Spark/Fib] Advertise interfaces_ over interfaceUpdatesQueue_ to Spark/Fib
    *
@@ -293,6 +301,10 @@ class LinkMonitor final : public OpenrEventBase {
   thrift::PrefixForwardingAlgorithm prefixForwardingAlgorithm_;
   // Use spark measured RTT to neighbor as link metric
   bool useRttMetric_{false};
+  // advertise each adjacency under its own key
+  bool enablePerAdjacencyKeys_{false};
+  // KvStore peers accept compressed messages
+  bool enableKvStoreCompression_{false};
   // link flap back offs
   std::chrono::milliseconds linkflapInitBackoff_;
   std::chrono::milliseconds linkflapMaxBackoff_;
@@ -316,6 +328,14 @@ class LinkMonitor final : public OpenrEventBase {
   // LinkMonitor config attributes (defined in LinkMonitor.thrift)
   thrift::LinkMonitorState state_;
 
+  // Last state_ written to ConfigStore. Used to skip redundant writes
+  std::optional<thrift::LinkMonitorState> storedState_;
+
+  // Per adjacency keys advertised in each area. Used to withdraw keys of
+  // adjacencies which went away
+  std::unordered_map<std::string /* area */, std::unordered_set<std::string>>
+      perAdjacencyKeys_;
+
   // Queue to publish interface updates to fib/spark
   messaging::ReplicateQueue<thrift::InterfaceDatabase>& interfaceUpdatesQueue_;
 
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -1116,6 +1117,146 @@ TEST_F(LinkMonitorTestFixture, ParallelAdj) {
   checkPeerDump(adj_2_2.otherNodeName, peerSpec_2_2);
 }
 
+// adjacencies advertised with per adjacency keys. Node key carries node
+// attributes only and keys of adjacencies which went down are withdrawn
+TEST_F(LinkMonitorTestFixture, PerAdjacencyKeys) {
+  SetUp({openr::thrift::KvStore_constants::kDefaultArea()});
+
+  {
+    // restart linkMonitor with per adjacency keys enabled
+    neighborUpdatesQueue.close();
+    kvStoreWrapper->closeQueue();
+    stopLinkMonitor();
+
+    // Create new neighbor update queue. Previous one is closed
+    neighborUpdatesQueue.open();
+    kvStoreWrapper->openQueue();
+
+    auto tConfigCopy = getTestOpenrConfig();
+    tConfigCopy.link_monitor_config.enable_per_adjacency_keys = true;
+    createLinkMonitor(std::make_shared<Config>(tConfigCopy));
+  }
+
+  // wait till adjacency database under the key has given adjacencies
+  auto waitForAdjacencies = [&](std::string const& key,
+                                std::vector<thrift::Adjacency> const& adjs) {
+    while (true) {
+      auto value = kvStoreWrapper->getKey(key);
+      if (value.has_value() and value->value_ref().has_value()) {
+        auto adjDb = fbzmq::util::readThriftObjStr<thrift::AdjacencyDatabase>(
+            value->value_ref().value(), serializer);
+        EXPECT_EQ("node-1", adjDb.thisNodeName);
+        if (adjDb.adjacencies.size() == adjs.size() and
+            std::equal(
+                adjs.begin(),
+                adjs.end(),
+                adjDb.adjacencies.begin(),
+                [](auto const& lhs, auto const& rhs) {
+                  return lhs.otherNodeName == rhs.otherNodeName and
+                      lhs.ifName == rhs.ifName;
+                })) {
+          return;
+        }
+      }
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  };
+
+  const auto key_2_1 = getPerAdjacencyKey("node-1", "node-2", if_2_1);
+  const auto key_2_2 = getPerAdjacencyKey("node-1", "node-2", if_2_2);
+
+  // neighbor up on two interfaces
+  neighborUpdatesQueue.push(createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_UP,
+      if_2_1,
+      nb2,
+      100 /* rtt-us */,
+      1 /* label */));
+  neighborUpdatesQueue.push(createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_UP,
+      if_2_2,
+      nb2,
+      100 /* rtt-us */,
+      2 /* label */));
+
+  waitForAdjacencies(key_2_1, {adj_2_1});
+  waitForAdjacencies(key_2_2, {adj_2_2});
+  waitForAdjacencies("adj:node-1", {});
+
+  // neighbor down on one interface. Its key is withdrawn with empty database
+  // while the other one stays
+  neighborUpdatesQueue.push(createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_DOWN,
+      if_2_1,
+      nb2,
+      100 /* rtt-us */,
+      1 /* label */));
+
+  waitForAdjacencies(key_2_1, {});
+  waitForAdjacencies(key_2_2, {adj_2_2});
+  waitForAdjacencies("adj:node-1", {});
+}
+
+// LinkMonitor writes its state to ConfigStore only when the state changes,
+// not on every advertisement of adjacencies
+TEST_F(LinkMonitorTestFixture, StoreStateOnChange) {
+  SetUp({openr::thrift::KvStore_constants::kDefaultArea()});
+
+  auto loadState = [&]() {
+    return configStore->loadThriftObj<thrift::LinkMonitorState>(kConfigKey)
+        .get();
+  };
+
+  {
+    // restart linkMonitor without any stored state. Disable segment routing
+    // so that node label allocation doesn't change the state
+    neighborUpdatesQueue.close();
+    kvStoreWrapper->closeQueue();
+    stopLinkMonitor();
+    configStore->erase(kConfigKey).get();
+
+    // Create new neighbor update queue. Previous one is closed
+    neighborUpdatesQueue.open();
+    kvStoreWrapper->openQueue();
+
+    auto tConfigCopy = getTestOpenrConfig();
+    tConfigCopy.enable_segment_routing_ref() = false;
+    createLinkMonitor(std::make_shared<Config>(tConfigCopy));
+  }
+
+  // initial advertisement stores the state
+  expectedAdjDbs.push(createAdjDatabase("node-1", {}, kNodeLabel));
+  checkNextAdjPub("adj:node-1");
+  while (loadState().hasError()) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // advertisement without change of state doesn't store it again
+  EXPECT_TRUE(configStore->erase(kConfigKey).get());
+  expectedAdjDbs.push(createAdjDatabase("node-1", {adj_2_1}, kNodeLabel));
+  neighborUpdatesQueue.push(createNeighborEvent(
+      thrift::SparkNeighborEventType::NEIGHBOR_UP,
+      if_2_1,
+      nb2,
+      100 /* rtt-us */,
+      1 /* label */));
+  checkNextAdjPub("adj:node-1");
+  EXPECT_TRUE(loadState().hasError());
+
+  // change of state is stored
+  linkMonitor->setNodeOverload(true).get();
+  while (true) {
+    auto state = loadState();
+    if (state.hasValue() and state->isOverloaded) {
+      break;
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
 // Verify neighbor-restarting event (including parallel case)
 TEST_F(LinkMonitorTestFixture, NeighborRestart) {
   SetUp({openr::thrift::KvStore_constants::kDefaultArea()});
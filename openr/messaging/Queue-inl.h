@@ -31,6 +31,18 @@ RQueue<ValueType>::getCoro() {
 }
 #endif
 
+template <typename ValueType>
+folly::Expected<std::vector<ValueType>, QueueError>
+RQueue<ValueType>::getBatch(size_t maxItems, QueueReadStats* stats) {
+  return queue_->getBatch(maxItems, stats);
+}
+
+template <typename ValueType>
+folly::Expected<std::vector<ValueType>, QueueError>
+RQueue<ValueType>::getAll(QueueReadStats* stats) {
+  return queue_->getAll(stats);
+}
+
 template <typename ValueType>
 size_t
 RQueue<ValueType>::size() {
@@ -60,11 +72,13 @@ RWQueue<ValueType>::push(ValueTypeT&& val) {
     // Unblock a pending read
     auto& pendingRead = pendingReads_.front().get();
     pendingRead.data = std::forward<ValueTypeT>(val);
+    pendingRead.pushTime = Clock::now();
     pendingRead.baton.post();
     pendingReads_.pop_front();
   } else {
     // Add data into the queue
-    queue_.emplace_back(std::forward<ValueTypeT>(val));
+    queue_.push_back(
+        QueuedData{ValueType(std::forward<ValueTypeT>(val)), Clock::now()});
   }
 
   return true;
@@ -95,6 +109,57 @@ RWQueue<ValueType>::get() {
   return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
 }
 
+template <typename ValueType>
+folly::Expected<std::vector<ValueType>, QueueError>
+RWQueue<ValueType>::getBatch(size_t maxItems, QueueReadStats* stats) {
+  PendingRead pendingRead;
+
+  // Queue is closed
+  if (not getAnyImpl(pendingRead)) {
+    return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
+  }
+
+  // Post our own baton if read is immediate. See get()
+  if (pendingRead.data) {
+    pendingRead.baton.post();
+  }
+
+  // Wait for the first element
+  pendingRead.baton.wait();
+  if (not pendingRead.data) {
+    return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
+  }
+
+  std::vector<ValueType> values;
+  values.emplace_back(std::move(pendingRead.data).value());
+  auto oldestPushTime = pendingRead.pushTime;
+
+  // Drain rest of the pending data in one go
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    if (stats) {
+      stats->depth = queue_.size() + 1;
+    }
+    while (values.size() < maxItems and queue_.size()) {
+      oldestPushTime = std::min(oldestPushTime, queue_.front().pushTime);
+      values.emplace_back(std::move(queue_.front().data));
+      queue_.pop_front();
+    }
+  }
+
+  if (stats) {
+    stats->maxWaitTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - oldestPushTime);
+  }
+  return values;
+}
+
+template <typename ValueType>
+folly::Expected<std::vector<ValueType>, QueueError>
+RWQueue<ValueType>::getAll(QueueReadStats* stats) {
+  return getBatch(std::numeric_limits<size_t>::max(), stats);
+}
+
 #if FOLLY_HAS_COROUTINES
 template <typename ValueType>
 folly::coro::Task<folly::Expected<ValueType, QueueError>>
@@ -132,7 +197,8 @@ RWQueue<ValueType>::getAnyImpl(PendingRead& pendingRead) {
 
   // Perform immediate read if data is available
   if (queue_.size()) {
-    pendingRead.data = std::move(queue_.front());
+    pendingRead.data = std::move(queue_.front().data);
+    pendingRead.pushTime = queue_.front().pushTime;
     queue_.pop_front();
     return true;
   }
@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <any>
+#include <chrono>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include <folly/Expected.h>
 #include <folly/fibers/Baton.h>
@@ -26,6 +30,19 @@ enum class QueueError {
   QUEUE_CLOSED,
 };
 
+/**
+ * Stats of a single read, filled by batched reads if requested. Lets readers
+ * export queue depth and queueing delay.
+ */
+struct QueueReadStats {
+  // Number of elements pending in queue at the time of read (including the
+  // ones returned)
+  size_t depth{0};
+
+  // Longest time a returned element has spent in the queue
+  std::chrono::microseconds maxWaitTime{0};
+};
+
 template <typename ValueType>
 class RWQueue;
 
@@ -44,6 +61,19 @@ class RQueue {
    */
   folly::Expected<ValueType, QueueError> get();
 
+  /**
+   * Blocking batched read. Waits for at least one element and then drains up
+   * to `maxItems` pending elements in a single wakeup.
+   */
+  folly::Expected<std::vector<ValueType>, QueueError> getBatch(
+      size_t maxItems, QueueReadStats* stats = nullptr);
+
+  /**
+   * Blocking batched read of all pending elements
+   */
+  folly::Expected<std::vector<ValueType>, QueueError> getAll(
+      QueueReadStats* stats = nullptr);
+
 #if FOLLY_HAS_COROUTINES
   /**
    * Read methods for co-routines
@@ -89,6 +119,20 @@ class RWQueue {
    */
   folly::Expected<ValueType, QueueError> get();
 
+  /**
+   * Blocking batched read. Waits for at least one element and then drains up
+   * to `maxItems` pending elements with a single lock acquisition, so a burst
+   * of pushes costs the reader one wakeup. Optionally fills read stats.
+   */
+  folly::Expected<std::vector<ValueType>, QueueError> getBatch(
+      size_t maxItems, QueueReadStats* stats = nullptr);
+
+  /**
+   * Blocking batched read of all pending elements
+   */
+  folly::Expected<std::vector<ValueType>, QueueError> getAll(
+      QueueReadStats* stats = nullptr);
+
 #if FOLLY_HAS_COROUTINES
   /**
    * Read methods for co-routines
@@ -113,9 +157,18 @@ class RWQueue {
   size_t numPendingReads();
 
  private:
+  using Clock = std::chrono::steady_clock;
+
   struct PendingRead {
     folly::fibers::Baton baton;
     std::optional<ValueType> data;
+    // Time at which data was pushed
+    Clock::time_point pushTime;
+  };
+
+  struct QueuedData {
+    ValueType data;
+    Clock::time_point pushTime;
   };
 
   /**
@@ -133,7 +186,7 @@ class RWQueue {
   std::deque<std::reference_wrapper<PendingRead>> pendingReads_;
 
   // Pending data
-  std::deque<ValueType> queue_;
+  std::deque<QueuedData> queue_;
 };
 
 } // namespace messaging
@@ -22,6 +22,21 @@ template <typename ValueType>
 template <typename ValueTypeT>
 bool
 ReplicateQueue<ValueType>::push(ValueTypeT&& value) {
+  if constexpr (detail::isSharedConstElement<ValueType, ValueTypeT>()) {
+    // Wrap once, readers get copies of shared_ptr
+    using ElementType =
+        typename detail::SharedConstValue<ValueType>::ElementType;
+    return replicate(ValueType(
+        std::make_shared<const ElementType>(std::forward<ValueTypeT>(value))));
+  } else {
+    return replicate(std::forward<ValueTypeT>(value));
+  }
+}
+
+template <typename ValueType>
+template <typename ValueTypeT>
+bool
+ReplicateQueue<ValueType>::replicate(ValueTypeT&& value) {
   std::vector<std::shared_ptr<RWQueue<ValueType>>> readers;
 
   // Copy reader information - and cleans up stale reader
@@ -7,17 +7,49 @@
 
 #pragma once
 
+#include <memory>
+#include <type_traits>
+
 #include <openr/messaging/Queue.h>
 
 namespace openr {
 namespace messaging {
 
+namespace detail {
+
+template <typename ValueType>
+struct SharedConstValue : std::false_type {};
+
+template <typename T>
+struct SharedConstValue<std::shared_ptr<const T>> : std::true_type {
+  using ElementType = T;
+};
+
+// True if ValueTypeT is the element type of shared immutable ValueType
+template <typename ValueType, typename ValueTypeT>
+constexpr bool
+isSharedConstElement() {
+  if constexpr (SharedConstValue<ValueType>::value) {
+    return std::is_same_v<
+        std::decay_t<ValueTypeT>,
+        typename SharedConstValue<ValueType>::ElementType>;
+  } else {
+    return false;
+  }
+}
+
+} // namespace detail
+
 /**
  * Multiple writers and readers. Each reader gets every written element push by
  * every writer. Writer pays the cost of replicating data to all readers. If no
  * reader exists then all the messages are silently dropped.
  *
  * Pushed object must be copy constructible.
+ *
+ * If ValueType is `std::shared_ptr<const T>` (see SharedReplicateQueue) then
+ * pushed `T` is wrapped only once and all readers share the same immutable
+ * object. Readers wanting to modify it must make a copy.
  */
 template <typename ValueType>
 class ReplicateQueue {
@@ -40,7 +72,8 @@ class ReplicateQueue {
 
   /**
    * Push any value into the queue. Will get replicated to all the readers.
-   * This also cleans up any lingering queue which has no active reader
+   * This also cleans up any lingering queue which has no active reader.
+   * For shared immutable values, `T` is accepted and wrapped before replication
    */
   template <typename ValueTypeT>
   bool push(ValueTypeT&& value);
@@ -70,10 +103,29 @@ class ReplicateQueue {
   void close();
 
  private:
+  /**
+   * Replicate value to all the readers
+   */
+  template <typename ValueTypeT>
+  bool replicate(ValueTypeT&& value);
+
   folly::Synchronized<std::list<std::shared_ptr<RWQueue<ValueType>>>> readers_;
   bool closed_{false}; // Protected by above Synchronized lock
 };
 
+/**
+ * Replicate queue handing out the same immutable value to all readers instead
+ * of a copy per reader. Useful for large values with many readers.
+ */
+template <typename T>
+using SharedReplicateQueue = ReplicateQueue<std::shared_ptr<const T>>;
+
+/**
+ * Reader of SharedReplicateQueue
+ */
+template <typename T>
+using SharedRQueue = RQueue<std::shared_ptr<const T>>;
+
 } // namespace messaging
 } // namespace openr
 
@@ -67,6 +67,47 @@ TEST(RWQueueTest, OrderedPushGet) {
   EXPECT_EQ(0, q.size());
 }
 
+TEST(RWQueueTest, BatchGet) {
+  RWQueue<int> q;
+  for (int i = 0; i < 5; ++i) {
+    q.push(i);
+  }
+
+  QueueReadStats stats;
+  auto batch = q.getBatch(3, &stats);
+  ASSERT_TRUE(batch.hasValue());
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), batch.value());
+  EXPECT_EQ(5, stats.depth);
+  EXPECT_LE(0, stats.maxWaitTime.count());
+  EXPECT_EQ(2, q.size());
+
+  batch = q.getAll(&stats);
+  ASSERT_TRUE(batch.hasValue());
+  EXPECT_EQ(std::vector<int>({3, 4}), batch.value());
+  EXPECT_EQ(2, stats.depth);
+  EXPECT_EQ(0, q.size());
+
+  // Blocked batch read gets woken up by first push
+  folly::EventBase evb;
+  auto& manager = folly::fibers::getFiberManager(evb);
+  manager.addTask([&q]() mutable {
+    auto values = q.getAll();
+    ASSERT_TRUE(values.hasValue());
+    EXPECT_EQ(std::vector<int>({5}), values.value());
+    EXPECT_EQ(QueueError::QUEUE_CLOSED, q.getAll().error());
+  });
+
+  evb.loopOnce(); // Fiber should get stuck at the read
+  EXPECT_EQ(1, q.numPendingReads());
+  q.push(5);
+  evb.loopOnce();
+  EXPECT_EQ(1, q.numPendingReads());
+  q.close();
+  evb.loopOnce();
+  EXPECT_EQ(0, q.numPendingReads());
+  EXPECT_EQ(QueueError::QUEUE_CLOSED, q.getBatch(1).error());
+}
+
 TEST(RWQueueTest, ClosedPendingReads) {
   RWQueue<int> q;
 
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+
+#include <openr/common/Util.h>
+#include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/messaging/ReplicateQueue.h>
+
+/**
+ * Defines a benchmark that allows users to record customized counter during
+ * benchmarking and passes a parameter to another one. This is common for
+ * benchmarks that need a "problem size" in addition to "number of iterations".
+ */
+#define BENCHMARK_COUNTERS_PARAM(name, counters, param) \
+  BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param, param)
+
+/*
+ * Like BENCHMARK_COUNTERS_PARAM(), but allows a custom name to be specified for
+ * each parameter, rather than using the parameter value.
+ */
+#define BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param_name, ...) \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
+namespace {
+
+// Number of keys in the publication
+const uint32_t kNumOfKeys = 1000;
+// The byte size of a value
+const uint32_t kSizeOfValue = 1024;
+
+} // namespace
+
+namespace openr {
+
+/**
+ * Publication resembling a KvStore full sync
+ */
+static thrift::Publication
+createPublication() {
+  std::unordered_map<std::string, thrift::Value> keyVals;
+  for (uint32_t i = 0; i < kNumOfKeys; ++i) {
+    keyVals.emplace(
+        folly::sformat("key-{}", i),
+        createThriftValue(1, "node-1", std::string(kSizeOfValue, 'x')));
+  }
+  return createThriftPublication(keyVals, {});
+}
+
+/**
+ * Publication counting the copies made of it, including the one made from
+ * the original publication when pushing
+ */
+struct CountedPublication {
+  explicit CountedPublication(thrift::Publication const& pub)
+      : publication(pub) {
+    ++numOfCopies;
+  }
+
+  CountedPublication(CountedPublication const& other)
+      : publication(other.publication) {
+    ++numOfCopies;
+  }
+
+  CountedPublication(CountedPublication&&) = default;
+
+  thrift::Publication publication;
+  static size_t numOfCopies;
+};
+
+size_t CountedPublication::numOfCopies{0};
+
+/**
+ * Benchmark for replicating values to readers
+ * 1. Create a queue with numOfReaders readers
+ * 2. Push a publication and read it from every reader
+ * Copies of the publication made per push are reported as counters
+ */
+template <typename QueueT>
+static void
+benchmarkReplicate(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfReaders) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto publication = createPublication();
+  QueueT q;
+  std::vector<decltype(q.getReader())> readers;
+  for (unsigned i = 0; i < numOfReaders; ++i) {
+    readers.emplace_back(q.getReader());
+  }
+  CountedPublication::numOfCopies = 0;
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    q.push(CountedPublication(publication));
+    for (auto& reader : readers) {
+      auto maybeValue = reader.get();
+      folly::doNotOptimizeAway(maybeValue);
+    }
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  const size_t numOfCopies = CountedPublication::numOfCopies / iters;
+  counters["num_readers"] = numOfReaders;
+  counters["value_copies"] = numOfCopies;
+  counters["bytes_per_push"] = numOfCopies * kNumOfKeys * kSizeOfValue;
+  q.close();
+}
+
+static void
+BM_ReplicateQueueCopy(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfReaders) {
+  benchmarkReplicate<messaging::ReplicateQueue<CountedPublication>>(
+      counters, iters, numOfReaders);
+}
+
+static void
+BM_ReplicateQueueShared(
+    folly::UserCounters& counters, uint32_t iters, unsigned numOfReaders) {
+  benchmarkReplicate<messaging::SharedReplicateQueue<CountedPublication>>(
+      counters, iters, numOfReaders);
+}
+
+// The parameter is the number of readers of the queue
+BENCHMARK_COUNTERS_PARAM(BM_ReplicateQueueCopy, counters, 1);
+BENCHMARK_COUNTERS_PARAM(BM_ReplicateQueueCopy, counters, 4);
+BENCHMARK_COUNTERS_PARAM(BM_ReplicateQueueCopy, counters, 16);
+BENCHMARK_COUNTERS_PARAM(BM_ReplicateQueueShared, counters, 1);
+BENCHMARK_COUNTERS_PARAM(BM_ReplicateQueueShared, counters, 4);
+BENCHMARK_COUNTERS_PARAM(BM_ReplicateQueueShared, counters, 16);
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -84,3 +84,45 @@ TEST(ReplicateQueueTest, OpenQueueTest) {
 
   q.close();
 }
+
+TEST(ReplicateQueueTest, SharedValueTest) {
+  const size_t kNumReaders{4};
+
+  SharedReplicateQueue<std::string> q;
+  std::vector<RQueue<std::shared_ptr<const std::string>>> readers;
+  for (size_t i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back(q.getReader());
+  }
+
+  // value gets wrapped once and shared by all readers
+  EXPECT_TRUE(q.push(std::string("hello")));
+  std::vector<std::shared_ptr<const std::string>> values;
+  for (auto& reader : readers) {
+    auto maybeValue = reader.get();
+    ASSERT_TRUE(maybeValue.hasValue());
+    EXPECT_EQ("hello", *maybeValue.value());
+    values.emplace_back(std::move(maybeValue).value());
+  }
+  for (auto const& value : values) {
+    EXPECT_EQ(values.front().get(), value.get());
+  }
+  EXPECT_EQ(kNumReaders, values.front().use_count());
+
+  // shared_ptr can be pushed as is
+  auto const value = std::make_shared<const std::string>("world");
+  EXPECT_TRUE(q.push(value));
+  for (auto& reader : readers) {
+    auto maybeValue = reader.get();
+    ASSERT_TRUE(maybeValue.hasValue());
+    EXPECT_EQ(value.get(), maybeValue.value().get());
+
+    // readers wanting to modify value make their own copy
+    auto copy = *maybeValue.value();
+    copy.append("!");
+    EXPECT_EQ("world!", copy);
+  }
+  EXPECT_EQ("world", *value);
+
+  q.close();
+  EXPECT_TRUE(readers.front().get().hasError());
+}
@@ -7,20 +7,113 @@
 
 #include <openr/nl/NetlinkMessage.h>
 
+#include <cstring>
+#include <limits>
+
+#include <folly/Bits.h>
+
 namespace openr::fbnl {
 
-NetlinkMessage::NetlinkMessage()
-    : msghdr(reinterpret_cast<struct nlmsghdr*>(msg.data())) {}
+NetlinkMessageBufferPool::NetlinkMessageBufferPool(size_t maxFreeBuffersPerSize)
+    : maxFreeBuffersPerSize_(maxFreeBuffersPerSize) {}
+
+size_t
+NetlinkMessageBufferPool::getBufferSize(size_t size) {
+  return folly::nextPowTwo(
+      std::min(std::max(size, kMinNlMessageSize), kMaxNlMessageSize));
+}
+
+size_t
+NetlinkMessageBufferPool::getSizeClass(size_t capacity) {
+  return folly::findLastSet(capacity) - folly::findLastSet(kMinNlMessageSize);
+}
+
+std::pair<std::unique_ptr<char[]>, size_t>
+NetlinkMessageBufferPool::allocate(size_t size) {
+  const size_t capacity = getBufferSize(size);
+  std::unique_ptr<char[]> buf;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& freeBuffers = freeBuffers_.at(getSizeClass(capacity));
+    if (not freeBuffers.empty()) {
+      buf = std::move(freeBuffers.back());
+      freeBuffers.pop_back();
+      bytesFree_ -= capacity;
+    }
+    bytesInUse_ += capacity;
+    bytesInUseHighWaterMark_ = std::max(bytesInUseHighWaterMark_, bytesInUse_);
+  }
+
+  if (buf) {
+    ::memset(buf.get(), 0, capacity);
+  } else {
+    buf = std::make_unique<char[]>(capacity);
+  }
+  return {std::move(buf), capacity};
+}
+
+void
+NetlinkMessageBufferPool::release(std::unique_ptr<char[]> buf, size_t capacity) {
+  CHECK_EQ(capacity, getBufferSize(capacity));
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_GE(bytesInUse_, capacity);
+  bytesInUse_ -= capacity;
+  auto& freeBuffers = freeBuffers_.at(getSizeClass(capacity));
+  if (freeBuffers.size() < maxFreeBuffersPerSize_) {
+    freeBuffers.emplace_back(std::move(buf));
+    bytesFree_ += capacity;
+  }
+}
+
+void
+NetlinkMessageBufferPool::acquireExternal(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bytesInUse_ += bytes;
+  bytesInUseHighWaterMark_ = std::max(bytesInUseHighWaterMark_, bytesInUse_);
+}
+
+void
+NetlinkMessageBufferPool::releaseExternal(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_GE(bytesInUse_, bytes);
+  bytesInUse_ -= bytes;
+}
+
+size_t
+NetlinkMessageBufferPool::getBytesInUse() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytesInUse_;
+}
+
+size_t
+NetlinkMessageBufferPool::getBytesInUseHighWaterMark() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytesInUseHighWaterMark_;
+}
+
+size_t
+NetlinkMessageBufferPool::getBytesFree() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytesFree_;
+}
 
-NetlinkMessage::NetlinkMessage(int type)
-    : msghdr(reinterpret_cast<struct nlmsghdr*>(msg.data())) {
-  // initialize netlink header
-  msghdr->nlmsg_len = NLMSG_LENGTH(0);
-  msghdr->nlmsg_type = type;
+NetlinkMessage::NetlinkMessage(
+    size_t capacity, std::shared_ptr<NetlinkMessageBufferPool> pool)
+    : pool_(std::move(pool)) {
+  if (pool_) {
+    std::tie(buf_, capacity_) = pool_->allocate(capacity);
+  } else {
+    capacity_ = NetlinkMessageBufferPool::getBufferSize(capacity);
+    buf_ = std::make_unique<char[]>(capacity_);
+  }
+  msghdr = reinterpret_cast<struct nlmsghdr*>(buf_.get());
 }
 
 NetlinkMessage::~NetlinkMessage() {
   CHECK(promise_.isFulfilled());
+  if (pool_) {
+    pool_->release(std::move(buf_), capacity_);
+  }
 }
 
 struct nlmsghdr*
@@ -42,8 +135,11 @@ struct rtattr*
 NetlinkMessage::addSubAttributes(
     struct rtattr* rta, int type, const void* data, uint32_t len) const {
   uint32_t subRtaLen = RTA_LENGTH(len);
+  const uint32_t rtaLen = RTA_ALIGN(rta->rta_len) + RTA_ALIGN(subRtaLen);
 
-  if (RTA_ALIGN(rta->rta_len) + RTA_ALIGN(subRtaLen) > kMaxNlPayloadSize) {
+  // Parent RTA length must fit in `rta_len` field
+  if (rtaLen > std::numeric_limits<decltype(rta->rta_len)>::max() or
+      not hasSpace(rta, rtaLen)) {
     LOG(ERROR) << "No buffer for adding attr: " << type << " length: " << len;
     return nullptr;
   }
@@ -73,7 +169,7 @@ NetlinkMessage::addAttributes(
   uint32_t rtaLen = (RTA_LENGTH(len));
   uint32_t nlmsgAlen = NLMSG_ALIGN((msghdr)->nlmsg_len);
 
-  if (nlmsgAlen + RTA_ALIGN(rtaLen) > kMaxNlPayloadSize) {
+  if (not hasSpace(msghdr, nlmsgAlen + RTA_ALIGN(rtaLen))) {
     LOG(ERROR) << "Space not available to add attribute type " << type;
     return ENOBUFS;
   }
@@ -93,6 +189,15 @@ NetlinkMessage::addAttributes(
   return 0;
 }
 
+bool
+NetlinkMessage::hasSpace(const void* ptr, size_t len) const {
+  const char* const start = reinterpret_cast<const char*>(ptr);
+  if (start < buf_.get() or start > buf_.get() + capacity_) {
+    return false;
+  }
+  return len <= capacity_ - static_cast<size_t>(start - buf_.get());
+}
+
 folly::SemiFuture<int>
 NetlinkMessage::getSemiFuture() {
   return promise_.getSemiFuture();
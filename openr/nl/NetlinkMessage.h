@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 #include <limits.h>
 #include <linux/lwtunnel.h>
@@ -17,13 +20,76 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 
+#include <folly/ConstexprMath.h>
 #include <folly/futures/Future.h>
 
 #include <openr/nl/NetlinkTypes.h>
 
 namespace openr::fbnl {
 
-constexpr uint16_t kMaxNlPayloadSize{4096};
+// Size range of buffers for outgoing netlink messages. Buffer sizes are
+// rounded up to power of two between these limits
+constexpr size_t kMinNlMessageSize{256};
+constexpr size_t kMaxNlMessageSize{128 * 1024};
+
+// Maximum number of free buffers retained per size class
+constexpr size_t kMaxFreeNlBuffersPerSize{1024};
+
+/**
+ * Pool of buffers for outgoing netlink messages. Buffers are bucketed in power
+ * of two size classes and released buffers are retained for reuse, instead of
+ * hitting the allocator for every message. It also keeps track of memory held
+ * by live messages so that it can be reported.
+ *
+ * Messages are created in caller's thread and destroyed in socket's event
+ * base thread, hence pool is thread safe.
+ */
+class NetlinkMessageBufferPool {
+ public:
+  explicit NetlinkMessageBufferPool(
+      size_t maxFreeBuffersPerSize = kMaxFreeNlBuffersPerSize);
+
+  // Get zero initialized buffer for message of given size. Size is rounded up
+  // to the size class and capped at `kMaxNlMessageSize`
+  // @returns buffer and its capacity
+  std::pair<std::unique_ptr<char[]>, size_t> allocate(size_t size);
+
+  // Give back buffer acquired with `allocate`
+  void release(std::unique_ptr<char[]> buf, size_t capacity);
+
+  // Account bytes of buffers held by messages which are not allocated from
+  // the pool, e.g. payload of route batches exceeding `kMaxNlMessageSize`.
+  // Bytes are given back with `releaseExternal`
+  void acquireExternal(size_t bytes);
+  void releaseExternal(size_t bytes);
+
+  // Bytes of buffers held by messages, including external ones
+  size_t getBytesInUse() const;
+
+  // Maximum of bytes in use since creation of pool
+  size_t getBytesInUseHighWaterMark() const;
+
+  // Bytes of free buffers retained for reuse
+  size_t getBytesFree() const;
+
+  // Round up size to its size class
+  static size_t getBufferSize(size_t size);
+
+ private:
+  static size_t getSizeClass(size_t capacity);
+
+  static constexpr size_t kNumSizeClasses{
+      folly::constexpr_log2(kMaxNlMessageSize / kMinNlMessageSize) + 1};
+
+  const size_t maxFreeBuffersPerSize_{0};
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<std::unique_ptr<char[]>>, kNumSizeClasses>
+      freeBuffers_;
+  size_t bytesInUse_{0};
+  size_t bytesInUseHighWaterMark_{0};
+  size_t bytesFree_{0};
+};
 
 /**
  * Data structure representing a netlink message, either to be sent or received.
@@ -34,17 +100,18 @@ constexpr uint16_t kMaxNlPayloadSize{4096};
  * Aim of the message is to faciliate serialization and deserialization of
  * C++ object (application) to/from bytes (kernel).
  *
- * Maximum size of message is limited by `kMaxNlPayloadSize` parameter.
+ * Message is built into a buffer of fixed capacity, specified at construction.
+ * Buffer is taken from the pool if one is provided, and returned to it on
+ * destruction. Attributes exceeding the capacity are rejected with ENOBUFS.
  */
 class NetlinkMessage {
  public:
-  NetlinkMessage();
+  explicit NetlinkMessage(
+      size_t capacity = kMinNlMessageSize,
+      std::shared_ptr<NetlinkMessageBufferPool> pool = nullptr);
 
   virtual ~NetlinkMessage();
 
-  // construct message with type
-  NetlinkMessage(int type);
-
   // get pointer to NLMSG Header
   struct nlmsghdr* getMessagePtr();
 
@@ -54,8 +121,11 @@ class NetlinkMessage {
   // get current length
   uint32_t getDataLength() const;
 
-  // Buffer to create message
-  std::array<char, kMaxNlPayloadSize> msg = {};
+  // get size of buffer allocated for the message
+  size_t
+  getCapacity() const {
+    return capacity_;
+  }
 
   /**
    * APIs for accumulating objects of `GET_<>` request. These APIs are invoked
@@ -65,10 +135,13 @@ class NetlinkMessage {
    *
    * e.g. GET_ROUTE request will invoke `rcvdRoute(..)` for each route received
    *      from kernel. At the end `setReturnStatus(..)` will be invoked.
+   *
+   * Routes are passed unparsed so that requests can filter them out before
+   * parsing, dumps can be big.
    */
 
   virtual void
-  rcvdRoute(Route&& /* route */) {
+  rcvdRoute(const struct nlmsghdr* /* nlh */) {
     CHECK(false) << "Must be implemented by subclass";
   }
 
@@ -124,13 +197,23 @@ class NetlinkMessage {
   struct rtattr* addSubAttributes(
       struct rtattr* rta, int type, const void* data, uint32_t len) const;
 
+  // Check if `len` bytes starting at `ptr` fit in the message buffer
+  bool hasSpace(const void* ptr, size_t len) const;
+
  private:
   // disable copy, assign constructores
   NetlinkMessage(NetlinkMessage const&) = delete;
   NetlinkMessage& operator=(NetlinkMessage const&) = delete;
 
+  // Pool owning the buffer, if any
+  const std::shared_ptr<NetlinkMessageBufferPool> pool_;
+
+  // Buffer to create message
+  std::unique_ptr<char[]> buf_;
+  size_t capacity_{0};
+
   // pointer to the netlink message header
-  struct nlmsghdr* const msghdr{nullptr};
+  struct nlmsghdr* msghdr{nullptr};
 
   // Promise to relay the status code received from kernel
   folly::Promise<int> promise_;
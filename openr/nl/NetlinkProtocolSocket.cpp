@@ -5,9 +5,13 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <array>
+#include <limits>
 #include <thread>
+#include <unordered_set>
 
 #include <fb303/ServiceData.h>
+#include <folly/Bits.h>
 
 #include <openr/common/Util.h>
 #include <openr/nl/NetlinkProtocolSocket.h>
@@ -32,7 +36,8 @@ NetlinkProtocolSocket::NetlinkProtocolSocket(
         "netlink.requests.timeout", nlSeqNumMap_.size(), fb303::SUM);
 
     LOG(ERROR) << "Timed-out receiving ack for " << nlSeqNumMap_.size()
-               << " message(s).";
+               << " message(s) and " << batchChunkMap_.size()
+               << " batch chunk(s).";
     fbData->addStatValue("netlink.errors", 1, fb303::SUM);
     for (auto& kv : nlSeqNumMap_) {
       LOG(ERROR) << "  Pending seq=" << kv.first << ", message-type="
@@ -43,6 +48,20 @@ NetlinkProtocolSocket::NetlinkProtocolSocket(
     }
     nlSeqNumMap_.clear(); // Clear all timed out requests
 
+    for (auto& [lastSeq, chunk] : batchChunkMap_) {
+      LOG(ERROR) << "  Pending batch chunk seq=" << chunk.firstSeq << "-"
+                 << lastSeq;
+      // Set timeout to messages without a response
+      chunk.batch->failMessages(
+          chunk.firstMsg, chunk.firstMsg + chunk.numMsgs, -ETIMEDOUT);
+      if (chunk.batch->chunkDone()) {
+        chunk.batch->setReturnStatus(0);
+      }
+    }
+    fbData->addStatValue(
+        "netlink.requests.timeout", batchChunkMap_.size(), fb303::SUM);
+    batchChunkMap_.clear(); // Clear all timed out chunks
+
     LOG(INFO) << "Closing netlink socket. fd=" << nlSock_
               << ", port=" << portId_;
     unregisterHandler();
@@ -85,6 +104,23 @@ NetlinkProtocolSocket::~NetlinkProtocolSocket() {
   }
   nlSeqNumMap_.clear(); // Clear all timed out requests
 
+  // Clear all route batches in-flight or partially sent
+  std::unordered_set<std::shared_ptr<NetlinkRouteBatchMessage>> batches;
+  for (auto& [_, chunk] : batchChunkMap_) {
+    chunk.batch->failMessages(
+        chunk.firstMsg, chunk.firstMsg + chunk.numMsgs, -ESHUTDOWN);
+    batches.emplace(std::move(chunk.batch));
+  }
+  batchChunkMap_.clear();
+  if (sendingBatch_) {
+    batches.emplace(std::move(sendingBatch_));
+  }
+  for (auto& batch : batches) {
+    LOG(WARNING) << "Clearing netlink route batch of "
+                 << batch->getNumMessages() << " messages";
+    batch->setReturnStatus(-ESHUTDOWN);
+  }
+
   // Clear all requests that yet needs to be sent
   std::unique_ptr<NetlinkMessage> msg;
   while (notifQueue_.tryConsume(msg)) {
@@ -126,6 +162,11 @@ NetlinkProtocolSocket::init() {
     LOG(FATAL) << "Failed to bind netlink socket: " << folly::errnoStr(errno);
   }
 
+  // Route events are subscribed only if requested
+  if (routeEventCB_) {
+    subscribeRouteEvents();
+  }
+
   // Retrieve and set pid that we will use for all subsequent messages
   portId_ = saddr.nl_pid;
   LOG(INFO) << "Created netlink socket. fd=" << nlSock_ << ", port=" << portId_;
@@ -174,6 +215,52 @@ NetlinkProtocolSocket::setNeighborEventCB(
   neighborEventCB_ = neighborEventCB;
 }
 
+void
+NetlinkProtocolSocket::setRouteEventCB(
+    std::function<void(fbnl::Route, bool)> routeEventCB,
+    std::function<bool(uint8_t, uint8_t)> routeEventFilter) {
+  CHECK(!routeEventCB_) << "Callback can be registered only once";
+  routeEventCB_ = routeEventCB;
+  routeEventFilter_ = routeEventFilter;
+  // Subscribe on initialized socket. Otherwise `init()` does it
+  routeSubscribeTimer_ = folly::AsyncTimeout::schedule(
+      std::chrono::milliseconds(0), *evb_, [this]() noexcept {
+        if (nlSock_ >= 0) {
+          subscribeRouteEvents();
+        }
+      });
+}
+
+void
+NetlinkProtocolSocket::setRoutesFlushedCB(
+    std::function<void(int)> routesFlushedCB) {
+  CHECK(!routesFlushedCB_) << "Callback can be registered only once";
+  routesFlushedCB_ = routesFlushedCB;
+}
+
+void
+NetlinkProtocolSocket::setEventsLostCB(std::function<void()> eventsLostCB) {
+  eventsLostCB_ = eventsLostCB;
+}
+
+void
+NetlinkProtocolSocket::subscribeRouteEvents() {
+  const std::array<int, 3> groups{
+      RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE, RTNLGRP_MPLS_ROUTE};
+  for (int group : groups) {
+    if (setsockopt(
+            nlSock_,
+            SOL_NETLINK,
+            NETLINK_ADD_MEMBERSHIP,
+            &group,
+            sizeof(group)) != 0) {
+      LOG(ERROR) << "Failed to subscribe route events of group " << group
+                 << ". Error: " << folly::errnoStr(errno);
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+    }
+  }
+}
+
 void
 NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
   VLOG(2) << "Completed netlink request. seq=" << ack << ", retval=" << status;
@@ -194,13 +281,13 @@ NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
     // Set return status on promise
     it->second->setReturnStatus(status);
     nlSeqNumMap_.erase(it);
-  } else {
+  } else if (not processBatchAck(ack, status)) {
     LOG(ERROR) << "Broken promise for netlink request. seq=" << ack;
     fbData->addStatValue("netlink.errors", 1, fb303::SUM);
   }
 
   // Cancel timer if there are no more expected responses
-  if (nlSeqNumMap_.empty()) {
+  if (nlSeqNumMap_.empty() and batchChunkMap_.empty()) {
     nlMessageTimer_->cancelTimeout();
   } else {
     // Extend timer and wait for next ack
@@ -209,15 +296,156 @@ NetlinkProtocolSocket::processAck(uint32_t ack, int status) {
 
   // We've successfully completed at-least one message. Send more messages
   // if any pending. Here we add optimization to wait for some more acks and
-  // send pending message in batch of atleast `kMinIovMsg`
-  if (nlSeqNumMap_.empty() or (kMaxIovMsg - nlSeqNumMap_.size() > kMinIovMsg)) {
+  // send pending message in batch of atleast `kMinIovMsg`. Chunks of route
+  // batch being sent are sent as soon as in-flight chunks limit permits
+  if (nlSeqNumMap_.empty() or (kMaxIovMsg - nlSeqNumMap_.size() > kMinIovMsg) or
+      (sendingBatch_ and batchChunkMap_.size() < kMaxBatchChunksInFlight)) {
     sendNetlinkMessage();
   }
 }
 
+bool
+NetlinkProtocolSocket::processBatchAck(uint32_t ack, int status) {
+  // Find chunk with smallest last sequence number that is not less than ack
+  auto it = batchChunkMap_.lower_bound(ack);
+  if (it == batchChunkMap_.end() or ack < it->second.firstSeq) {
+    return false;
+  }
+
+  auto& chunk = it->second;
+  chunk.batch->setMessageStatus(
+      chunk.firstMsg + (ack - chunk.firstSeq), status);
+  if (ack != it->first) {
+    // Error for one of the messages of chunk. Wait for ack of last message
+    return true;
+  }
+
+  // Kernel processes messages of a chunk in order, hence ack of the last
+  // message implies completion of the entire chunk
+  auto requestLatency = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - chunk.batch->getCreateTs());
+  fbData->addStatValue(
+      "netlink.requests.latency_ms", requestLatency.count(), fb303::AVG);
+  if (chunk.batch->chunkDone()) {
+    chunk.batch->setReturnStatus(0);
+  }
+  batchChunkMap_.erase(it);
+  return true;
+}
+
 void
 NetlinkProtocolSocket::sendNetlinkMessage() {
   CHECK(evb_->isInEventBaseThread());
+  fbData->setCounter("netlink.message_bytes", msgPool_->getBytesInUse());
+  fbData->setCounter(
+      "netlink.message_bytes.high_water_mark",
+      msgPool_->getBytesInUseHighWaterMark());
+  fbData->setCounter("netlink.message_bytes.free", msgPool_->getBytesFree());
+  while (true) {
+    // Finish sending batch before any subsequent messages
+    if (sendingBatch_) {
+      sendBatchChunks();
+      if (sendingBatch_) {
+        return; // No capacity to send remaining chunks
+      }
+    }
+
+    if (msgQueue_.empty()) {
+      return;
+    }
+
+    if (dynamic_cast<NetlinkRouteBatchMessage*>(msgQueue_.front().get())) {
+      sendingBatch_.reset(static_cast<NetlinkRouteBatchMessage*>(
+          msgQueue_.front().release()));
+      msgQueue_.pop();
+      continue;
+    }
+
+    sendQueuedMessages();
+    if (msgQueue_.empty() or
+        not dynamic_cast<NetlinkRouteBatchMessage*>(msgQueue_.front().get())) {
+      return; // Either all messages are sent or there is no capacity
+    }
+  }
+}
+
+void
+NetlinkProtocolSocket::sendBatchChunks() {
+  struct sockaddr_nl nladdr = {
+      .nl_family = AF_NETLINK, .nl_pad = 0, .nl_pid = 0, .nl_groups = 0};
+  while (sendingBatch_ and batchChunkMap_.size() < kMaxBatchChunksInFlight) {
+    auto& batch = *sendingBatch_;
+    const size_t numMsgs = batch.getNumMessages();
+    const size_t firstMsg = batch.getNumSentMessages();
+
+    // Chunk has at-least one message and is bounded by kMaxBatchChunkBytes
+    size_t endMsg = firstMsg + 1;
+    while (endMsg < numMsgs and
+           batch.getMessagesLength(firstMsg, endMsg + 1) <=
+               kMaxBatchChunkBytes) {
+      ++endMsg;
+    }
+    const size_t count = endMsg - firstMsg;
+
+    // Sequence numbers of chunk must not wrap around
+    if (nextNlSeqNum_ > std::numeric_limits<uint32_t>::max() - count) {
+      nextNlSeqNum_ = 1;
+    }
+    const uint32_t firstSeq = nextNlSeqNum_;
+    for (size_t i = firstMsg; i < endMsg; ++i) {
+      struct nlmsghdr* nlmsg_hdr = batch.getMessage(i);
+      nlmsg_hdr->nlmsg_pid = portId_;
+      nlmsg_hdr->nlmsg_seq = nextNlSeqNum_++;
+      // Only last message of chunk requests an ack. Kernel always responds
+      // with an error message for failed requests
+      if (i + 1 == endMsg) {
+        nlmsg_hdr->nlmsg_flags |= NLM_F_ACK;
+      } else {
+        nlmsg_hdr->nlmsg_flags &= ~NLM_F_ACK;
+      }
+    }
+    const uint32_t lastSeq = nextNlSeqNum_ - 1;
+
+    struct iovec iov;
+    iov.iov_base = reinterpret_cast<void*>(batch.getMessage(firstMsg));
+    iov.iov_len = batch.getMessagesLength(firstMsg, endMsg);
+
+    struct msghdr outMsg;
+    ::memset(&outMsg, 0, sizeof(outMsg));
+    outMsg.msg_name = &nladdr;
+    outMsg.msg_namelen = sizeof(nladdr);
+    outMsg.msg_iov = &iov;
+    outMsg.msg_iovlen = 1;
+
+    // Add chunk before sending. On send error, timer will fail the chunk
+    auto res = batchChunkMap_.emplace(
+        lastSeq, BatchChunk{sendingBatch_, firstSeq, firstMsg, count});
+    CHECK(res.second) << "Entry exists for " << lastSeq;
+    batch.chunkSent(count);
+    if (batch.getNumSentMessages() == numMsgs) {
+      sendingBatch_.reset();
+    }
+
+    int bytesSent = sendmsg(nlSock_, &outMsg, 0);
+    if (bytesSent < 0) {
+      LOG(ERROR) << "Error sending on netlink socket. Error: "
+                 << folly::errnoStr(std::abs(errno)) << ", errno=" << errno
+                 << ", fd=" << nlSock_ << ", num-messages=" << count;
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+    } else {
+      fbData->addStatValue("netlink.bytes.tx", bytesSent, fb303::SUM);
+    }
+    fbData->addStatValue("netlink.requests", count, fb303::SUM);
+    VLOG(2) << "Sent netlink route batch chunk. seq=" << firstSeq << "-"
+            << lastSeq << ", len=" << iov.iov_len;
+
+    // Schedule timer to wait for acks and send next set of messages
+    nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
+  }
+}
+
+void
+NetlinkProtocolSocket::sendQueuedMessages() {
   struct sockaddr_nl nladdr = {
       .nl_family = AF_NETLINK, .nl_pad = 0, .nl_pid = 0, .nl_groups = 0};
   CHECK_LE(nlSeqNumMap_.size(), kMaxIovMsg)
@@ -233,6 +461,10 @@ NetlinkProtocolSocket::sendNetlinkMessage() {
   auto iov = std::make_unique<struct iovec[]>(iovSize);
 
   while (count < iovSize && !msgQueue_.empty()) {
+    // Route batch is sent separately
+    if (dynamic_cast<NetlinkRouteBatchMessage*>(msgQueue_.front().get())) {
+      break;
+    }
     auto m = std::move(msgQueue_.front());
     msgQueue_.pop();
 
@@ -265,6 +497,10 @@ NetlinkProtocolSocket::sendNetlinkMessage() {
             << ", flags=" << nlmsg_hdr->nlmsg_flags;
   }
 
+  if (!count) {
+    return;
+  }
+
   auto outMsg = std::make_unique<struct msghdr>();
   outMsg->msg_name = &nladdr;
   outMsg->msg_namelen = sizeof(nladdr);
@@ -291,10 +527,9 @@ NetlinkProtocolSocket::sendNetlinkMessage() {
 }
 
 void
-NetlinkProtocolSocket::processMessage(
-    const std::array<char, kMaxNlPayloadSize>& rxMsg, uint32_t bytesRead) {
+NetlinkProtocolSocket::processMessage(const char* rxMsg, uint32_t bytesRead) {
   // first netlink message header
-  struct nlmsghdr* nlh = (struct nlmsghdr*)rxMsg.data();
+  const struct nlmsghdr* nlh = reinterpret_cast<const struct nlmsghdr*>(rxMsg);
   do {
     if (!NLMSG_OK(nlh, bytesRead)) {
       break;
@@ -308,17 +543,31 @@ NetlinkProtocolSocket::processMessage(
     switch (nlh->nlmsg_type) {
     case RTM_NEWROUTE:
     case RTM_DELROUTE: {
-      // next RTM message to be processed
-      auto route = NetlinkRouteMessage::parseMessage(nlh);
-      if (nlSeqIt != nlSeqNumMap_.end()) {
+      // NOTE: Route notifications caused by our add/del requests bear the
+      // sequence number of request. Only dump responses are multi-part.
+      if (nlSeqIt != nlSeqNumMap_.end() and (nlh->nlmsg_flags & NLM_F_MULTI)) {
         // Extend message timer as we received a valid ack
         nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
-        // Received route in response to request
-        nlSeqIt->second->rcvdRoute(std::move(route));
+        // Received route in response to request. Request parses it
+        nlSeqIt->second->rcvdRoute(nlh);
       } else {
         // Route notification
         fbData->addStatValue("netlink.notifications.route", 1, fb303::SUM);
-        DCHECK(false) << "Route notifications are not subscribed";
+        // Skip uninteresting routes before parsing them. Events for all
+        // protocols are received and parsing them is expensive
+        const auto* const rtm =
+            reinterpret_cast<const struct rtmsg*>(NLMSG_DATA(nlh));
+        if (routeEventFilter_ and
+            not routeEventFilter_(rtm->rtm_table, rtm->rtm_protocol)) {
+          fbData->addStatValue(
+              "netlink.notifications.route_filtered", 1, fb303::SUM);
+          break;
+        }
+        if (routeEventCB_) {
+          auto route = NetlinkRouteMessage::parseMessage(nlh);
+          VLOG(2) << "Netlink route event. " << route.str();
+          routeEventCB_(std::move(route), true);
+        }
       }
     } break;
 
@@ -336,6 +585,9 @@ NetlinkProtocolSocket::processMessage(
         // Link notification
         VLOG(2) << "Netlink link event. " << link.str();
         fbData->addStatValue("netlink.notifications.link", 1, fb303::SUM);
+        if (routesFlushedCB_ and not link.isUp()) {
+          routesFlushedCB_(link.getIfIndex());
+        }
         if (linkEventCB_) {
           linkEventCB_(std::move(link), true);
         }
@@ -427,24 +679,56 @@ NetlinkProtocolSocket::processMessage(
 
 void
 NetlinkProtocolSocket::recvNetlinkMessage() {
-  // messages buffer
-  std::array<char, kMaxNlPayloadSize> recvMsg = {};
-
-  int32_t bytesRead = ::recv(nlSock_, recvMsg.data(), kMaxNlPayloadSize, 0);
-  VLOG(4) << "Message received with size: " << bytesRead;
-
-  if (bytesRead < 0) {
-    if (errno == EINTR || errno == EAGAIN) {
+  for (size_t i = 0; i < kMaxNlRecvPerEvent; ++i) {
+    // MSG_TRUNC returns the real length of datagram even if it is truncated
+    int32_t bytesRead = ::recv(
+        nlSock_, recvBuf_.data(), recvBuf_.size(), MSG_DONTWAIT | MSG_TRUNC);
+    VLOG(4) << "Message received with size: " << bytesRead;
+
+    if (bytesRead < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      if (errno == ENOBUFS) {
+        // Kernel dropped events as receive buffer overran. Socket remains
+        // usable, notify subscribers and keep reading
+        LOG(ERROR) << "Netlink socket receive buffer overrun, events are lost";
+        fbData->addStatValue("netlink.events_lost", 1, fb303::SUM);
+        if (eventsLostCB_) {
+          eventsLostCB_();
+        }
+        continue;
+      }
+      LOG(ERROR) << "Error in netlink socket receive: " << bytesRead
+                 << " err: " << folly::errnoStr(std::abs(errno));
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
       return;
     }
-    LOG(ERROR) << "Error in netlink socket receive: " << bytesRead
-               << " err: " << folly::errnoStr(std::abs(errno));
-    fbData->addStatValue("netlink.errors", 1, fb303::SUM);
-    return;
-  } else {
     fbData->addStatValue("netlink.bytes.rx", bytesRead, fb303::SUM);
+
+    if (static_cast<size_t>(bytesRead) > recvBuf_.size()) {
+      // Remainder of datagram is lost. Partial data is dropped as it would
+      // yield incomplete dump or events. Request the datagram belongs to is
+      // failed, else notifications are lost. Buffer grows for subsequent
+      // datagrams
+      LOG(ERROR) << "Truncated netlink message. size: " << bytesRead
+                 << ", buffer size: " << recvBuf_.size();
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+      const auto nlh =
+          reinterpret_cast<const struct nlmsghdr*>(recvBuf_.data());
+      if (nlSeqNumMap_.count(nlh->nlmsg_seq)) {
+        processAck(nlh->nlmsg_seq, -EMSGSIZE);
+      } else {
+        fbData->addStatValue("netlink.events_lost", 1, fb303::SUM);
+        if (eventsLostCB_) {
+          eventsLostCB_();
+        }
+      }
+      recvBuf_.resize(folly::nextPowTwo(static_cast<size_t>(bytesRead)));
+      continue;
+    }
+    processMessage(recvBuf_.data(), static_cast<uint32_t>(bytesRead));
   }
-  processMessage(recvMsg, static_cast<uint32_t>(bytesRead));
 }
 
 folly::SemiFuture<int>
@@ -472,7 +756,8 @@ NetlinkProtocolSocket::collectReturnStatus(
 folly::SemiFuture<int>
 NetlinkProtocolSocket::addRoute(const openr::fbnl::Route& route) {
   VLOG(1) << "Netlink add route. " << route.str();
-  auto rtmMsg = std::make_unique<NetlinkRouteMessage>();
+  auto rtmMsg = std::make_unique<NetlinkRouteMessage>(
+      NetlinkRouteMessage::estimateSize(route), msgPool_);
   auto future = rtmMsg->getSemiFuture();
 
   int status{0};
@@ -507,7 +792,8 @@ NetlinkProtocolSocket::addRoute(const openr::fbnl::Route& route) {
 folly::SemiFuture<int>
 NetlinkProtocolSocket::deleteRoute(const openr::fbnl::Route& route) {
   VLOG(1) << "Netlink delete route. " << route.str();
-  auto rtmMsg = std::make_unique<openr::fbnl::NetlinkRouteMessage>();
+  auto rtmMsg = std::make_unique<openr::fbnl::NetlinkRouteMessage>(
+      kMinNlMessageSize, msgPool_);
   auto future = rtmMsg->getSemiFuture();
 
   int status{0};
@@ -532,10 +818,55 @@ NetlinkProtocolSocket::deleteRoute(const openr::fbnl::Route& route) {
   return future;
 }
 
+folly::SemiFuture<NetlinkRouteBatchMessage::Errors>
+NetlinkProtocolSocket::addRoutes(const std::vector<fbnl::Route>& routes) {
+  VLOG(1) << "Netlink add routes. numRoutes=" << routes.size();
+  auto batchMsg = std::make_unique<NetlinkRouteBatchMessage>(msgPool_);
+  auto future = batchMsg->getErrorsSemiFuture();
+
+  for (size_t i = 0; i < routes.size(); ++i) {
+    const auto& route = routes[i];
+    if (route.getFamily() == AF_INET6 and
+        not enableIPv6RouteReplaceSemantics_) {
+      // Special case for IPv6 route add. See addRoute(...)
+      // NOTE: We ignore the error for the delete request
+      batchMsg->appendRoute(RTM_DELROUTE, route, std::nullopt);
+    }
+    batchMsg->appendRoute(RTM_NEWROUTE, route, i);
+  }
+
+  if (batchMsg->getNumMessages() == 0) {
+    batchMsg->setReturnStatus(0);
+  } else {
+    notifQueue_.putMessage(std::move(batchMsg));
+  }
+
+  return future;
+}
+
+folly::SemiFuture<NetlinkRouteBatchMessage::Errors>
+NetlinkProtocolSocket::deleteRoutes(const std::vector<fbnl::Route>& routes) {
+  VLOG(1) << "Netlink delete routes. numRoutes=" << routes.size();
+  auto batchMsg = std::make_unique<NetlinkRouteBatchMessage>(msgPool_);
+  auto future = batchMsg->getErrorsSemiFuture();
+
+  for (size_t i = 0; i < routes.size(); ++i) {
+    batchMsg->appendRoute(RTM_DELROUTE, routes[i], i);
+  }
+
+  if (batchMsg->getNumMessages() == 0) {
+    batchMsg->setReturnStatus(0);
+  } else {
+    notifQueue_.putMessage(std::move(batchMsg));
+  }
+
+  return future;
+}
+
 folly::SemiFuture<int>
 NetlinkProtocolSocket::addIfAddress(const openr::fbnl::IfAddress& ifAddr) {
   VLOG(1) << "Netlink add interface address. " << ifAddr.str();
-  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>();
+  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>(msgPool_);
   auto future = addrMsg->getSemiFuture();
 
   // Initialize Netlink message fields to add interface address
@@ -552,7 +883,7 @@ NetlinkProtocolSocket::addIfAddress(const openr::fbnl::IfAddress& ifAddr) {
 folly::SemiFuture<int>
 NetlinkProtocolSocket::deleteIfAddress(const openr::fbnl::IfAddress& ifAddr) {
   VLOG(1) << "Netlink delete interface address. " << ifAddr.str();
-  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>();
+  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>(msgPool_);
   auto future = addrMsg->getSemiFuture();
 
   // Initialize Netlink message fields to delete interface address
@@ -569,7 +900,7 @@ NetlinkProtocolSocket::deleteIfAddress(const openr::fbnl::IfAddress& ifAddr) {
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Link>, int>>
 NetlinkProtocolSocket::getAllLinks() {
   VLOG(1) << "Netlink get links";
-  auto linkMsg = std::make_unique<openr::fbnl::NetlinkLinkMessage>();
+  auto linkMsg = std::make_unique<openr::fbnl::NetlinkLinkMessage>(msgPool_);
   auto future = linkMsg->getLinksSemiFuture();
 
   // Initialize message fields to get all links
@@ -582,7 +913,7 @@ NetlinkProtocolSocket::getAllLinks() {
 folly::SemiFuture<folly::Expected<std::vector<fbnl::IfAddress>, int>>
 NetlinkProtocolSocket::getAllIfAddresses() {
   VLOG(1) << "Netlink get interface addresses";
-  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>();
+  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>(msgPool_);
   auto future = addrMsg->getAddrsSemiFuture();
 
   // Initialize message fields to get all addresses
@@ -595,7 +926,8 @@ NetlinkProtocolSocket::getAllIfAddresses() {
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Neighbor>, int>>
 NetlinkProtocolSocket::getAllNeighbors() {
   VLOG(1) << "Netlink get neighbors";
-  auto neighMsg = std::make_unique<openr::fbnl::NetlinkNeighborMessage>();
+  auto neighMsg =
+      std::make_unique<openr::fbnl::NetlinkNeighborMessage>(msgPool_);
   auto future = neighMsg->getNeighborsSemiFuture();
 
   // Initialize message fields to get all neighbors
@@ -608,7 +940,8 @@ NetlinkProtocolSocket::getAllNeighbors() {
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
 NetlinkProtocolSocket::getRoutes(const fbnl::Route& filter) {
   VLOG(1) << "Netlink get routes with filter. " << filter.str();
-  auto routeMsg = std::make_unique<openr::fbnl::NetlinkRouteMessage>();
+  auto routeMsg = std::make_unique<openr::fbnl::NetlinkRouteMessage>(
+      kMinNlMessageSize, msgPool_);
   auto future = routeMsg->getRoutesSemiFuture();
 
   // Initialize message fields to get all addresses
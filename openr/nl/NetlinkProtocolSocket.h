@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include <folly/IPAddress.h>
@@ -25,11 +26,25 @@ namespace openr::fbnl {
 // Receive socket buffer for netlink socket
 constexpr uint32_t kNetlinkSockRecvBuf{1 * 1024 * 1024};
 
+// Initial size of buffer for receiving messages from netlink socket. Kernel
+// sizes the dump responses based on the receive buffer (up to 32KB), hence a
+// large buffer reduces the number of reads. Buffer grows on truncation.
+constexpr size_t kNlRecvBufferSize{64 * 1024};
+
+// Maximum number of datagrams read from netlink socket per read event before
+// yielding to event loop
+constexpr size_t kMaxNlRecvPerEvent{64};
+
 // Maximum number of in-flight messages. `kMinIovMsg` indicates the soft
 // requirement for sending bufferred messages.
 constexpr size_t kMaxIovMsg{500};
 constexpr size_t kMinIovMsg{200};
 
+// Maximum bytes of batched route messages sent with a single `sendmsg` call
+// (aka chunk) and maximum number of chunks awaiting an ack from kernel
+constexpr size_t kMaxBatchChunkBytes{64 * 1024};
+constexpr size_t kMaxBatchChunksInFlight{8};
+
 // Timeout for an ack from kernel for netlink messages we sent. The response for
 // big request (e.g. adding 5k routes or getting 10k routes) is sent back in
 // multiple parts. If we don't receive any part of below specified timeout, we
@@ -84,10 +99,15 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
  *   netlink.requests.latency_ms : Average latency of netlink request
  *   netlink.bytes.rx : Bytes received over netlink socket
  *   netlink.bytes.tx : Bytes sent over netlink socket
+ *   netlink.message_bytes : Buffer bytes held by outstanding messages
+ *   netlink.message_bytes.high_water_mark : Maximum of netlink.message_bytes
+ *   netlink.message_bytes.free : Buffer bytes retained in pool for reuse
  *   netlink.notifications.link : Received link notifications
  *   netlink.notifications.addr : Received address notifications
  *   netlink.notifications.neighbors : Received neighbor notifications
  *   netlink.notifications.route : Received route notifications
+ *   netlink.notifications.route_filtered : Route notifications skipped by
+ *     route event filter
  */
 class NetlinkProtocolSocket : public folly::EventHandler {
  public:
@@ -106,6 +126,25 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   void setNeighborEventCB(
       std::function<void(fbnl::Neighbor, bool)> neighborEventCB);
 
+  // Set netlinkSocket Route event callback. Unlike other events, route events
+  // are subscribed only once callback is set, as they can be many. Events are
+  // delivered for all routes in kernel, including ones added by this socket.
+  // Deleted routes are reported as invalid. If filter is set, only routes for
+  // which it returns true on table and protocol of `rtmsg` header are parsed
+  // and delivered, others are skipped cheaply.
+  void setRouteEventCB(
+      std::function<void(fbnl::Route, bool)> routeEventCB,
+      std::function<bool(uint8_t table, uint8_t protocol)> routeEventFilter =
+          nullptr);
+
+  // Set callback invoked with ifIndex of link going down. Kernel flushes
+  // routes over the link without sending route events for all of them
+  void setRoutesFlushedCB(std::function<void(int)> routesFlushedCB);
+
+  // Set callback invoked when events are lost because socket receive buffer
+  // overran (ENOBUFS). State learnt from events must be refreshed from kernel
+  void setEventsLostCB(std::function<void()> eventsLostCB);
+
   /**
    * Add or replace route. An existing paths of route will be replaced with
    * new paths. Supports AF_INET, AF_INET6 and AF_MPLS address families.
@@ -136,6 +175,19 @@ class NetlinkProtocolSocket : public folly::EventHandler {
    */
   virtual folly::SemiFuture<int> deleteRoute(const openr::fbnl::Route& route);
 
+  /**
+   * Batch flavor of addRoute and deleteRoute. Requests are packed into large
+   * `sendmsg` buffers and acknowledged per chunk instead of per route, which
+   * avoids per route future and allocation overhead when programming a large
+   * number of routes.
+   *
+   * @returns index and error code of failed routes. Empty if all succeeded
+   */
+  virtual folly::SemiFuture<NetlinkRouteBatchMessage::Errors> addRoutes(
+      const std::vector<fbnl::Route>& routes);
+  virtual folly::SemiFuture<NetlinkRouteBatchMessage::Errors> deleteRoutes(
+      const std::vector<fbnl::Route>& routes);
+
   /**
    * Add an address to the interface
    *
@@ -213,6 +265,10 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   std::function<void(fbnl::Link, bool)> linkEventCB_;
   std::function<void(fbnl::IfAddress, bool)> addrEventCB_;
   std::function<void(fbnl::Neighbor, bool)> neighborEventCB_;
+  std::function<void(fbnl::Route, bool)> routeEventCB_;
+  std::function<bool(uint8_t, uint8_t)> routeEventFilter_;
+  std::function<void(int)> routesFlushedCB_;
+  std::function<void()> eventsLostCB_;
 
  private:
   NetlinkProtocolSocket(NetlinkProtocolSocket const&) = delete;
@@ -224,14 +280,27 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Send a message batch to netlink socket from queue_
   void sendNetlinkMessage();
 
-  // Receive messages from netlink socket. Invoke `processMessage` for every
-  // message received.
+  // Send queued messages up to the first route batch in queue_
+  void sendQueuedMessages();
+
+  // Send chunks of sendingBatch_ as long as in-flight chunks limit permits
+  void sendBatchChunks();
+
+  // Process ack or error for a message of route batch chunk
+  // @returns false if sequence number doesn't belong to any in-flight chunk
+  bool processBatchAck(uint32_t ack, int status);
+
+  // Join multicast groups of IPv4, IPv6 and MPLS route events
+  void subscribeRouteEvents();
+
+  // Receive messages from netlink socket till it is drained or till
+  // `kMaxNlRecvPerEvent` datagrams are read. Invoke `processMessage` for every
+  // datagram received.
   void recvNetlinkMessage();
 
-  // Process received netlink message. Set return values for pending requests
-  // or send notifications.
-  void processMessage(
-      const std::array<char, kMaxNlPayloadSize>& rxMsg, uint32_t bytesRead);
+  // Process netlink messages of received datagram in place. Set return values
+  // for pending requests or send notifications.
+  void processMessage(const char* rxMsg, uint32_t bytesRead);
 
   // Process ack message. Set return status on pending requests in nlSeqNumMap_
   // Resume sending messages from queue_ if any pending
@@ -277,6 +346,13 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   //    value of nlh->nlmsg_seq will set to 0.
   uint32_t nextNlSeqNum_{1};
 
+  // Buffer for receiving messages. Reused across reads
+  std::vector<char> recvBuf_ = std::vector<char>(kNlRecvBufferSize);
+
+  // Pool of buffers for messages created by this socket
+  const std::shared_ptr<NetlinkMessageBufferPool> msgPool_{
+      std::make_shared<NetlinkMessageBufferPool>()};
+
   // Netlink message queue. Every add/del/get call for route/addr/neighbor/link
   // translates into one or more NetlinkMessages. These messages are first
   // stored in the queue and sent to kernel in rate limiting fashion. When ack
@@ -289,6 +365,24 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // corresponding entry from this map.
   std::unordered_map<uint32_t, std::shared_ptr<NetlinkMessage>> nlSeqNumMap_;
 
+  // In-flight chunk of a route batch. Messages of a chunk have consecutive
+  // sequence numbers, starting with `firstSeq` for message `firstMsg` of batch
+  struct BatchChunk {
+    std::shared_ptr<NetlinkRouteBatchMessage> batch;
+    uint32_t firstSeq{0};
+    size_t firstMsg{0};
+    size_t numMsgs{0};
+  };
+
+  // Sequence number of last message in chunk (which requests an ack) to
+  // in-flight chunk. Entry is cleared when ack for the last message is received
+  std::map<uint32_t, BatchChunk> batchChunkMap_;
+
+  // Route batch which is being sent in chunks. Messages queued after it in
+  // msgQueue_ are sent only after the batch is sent completely to preserve the
+  // order of requests
+  std::shared_ptr<NetlinkRouteBatchMessage> sendingBatch_;
+
   // Timer to help keep track of timeout of messages sent to kernel. It also
   // ensures the aliveness of the netlink socket-fd. Timer is
   // - Started when a new message is sent
@@ -303,6 +397,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Timer for initializing this socket. This gets cancelled automatically if
   // event-base is never started
   std::unique_ptr<folly::AsyncTimeout> nlInitTimer_{nullptr};
+
+  // Timer for subscribing route events of an initialized socket
+  std::unique_ptr<folly::AsyncTimeout> routeSubscribeTimer_{nullptr};
 };
 
 } // namespace openr::fbnl
@@ -7,52 +7,79 @@
 
 #include <openr/nl/NetlinkRoute.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace openr::fbnl {
 
-NetlinkRouteMessage::NetlinkRouteMessage() {
+NetlinkRouteMessage::NetlinkRouteMessage(
+    size_t capacity, std::shared_ptr<NetlinkMessageBufferPool> pool)
+    : NetlinkMessage(capacity, std::move(pool)) {
   // get pointer to NLMSG header
   msghdr_ = getMessagePtr();
 }
 
+size_t
+NetlinkRouteMessage::estimateSize(const Route& route) {
+  // header, destination and priority
+  size_t size = NLMSG_LENGTH(sizeof(struct rtmsg)) +
+      RTA_SPACE(sizeof(struct in6_addr)) + RTA_SPACE(sizeof(uint32_t));
+  if (route.getNextHops().empty()) {
+    return size;
+  }
+
+  // RTA_MULTIPATH and worst case encoding of each next-hop
+  size += RTA_SPACE(0);
+  for (const auto& path : route.getNextHops()) {
+    size += sizeof(struct rtnexthop);
+    auto action = path.getLabelAction();
+    if (not action.has_value()) {
+      size += RTA_SPACE(sizeof(struct in6_addr));
+      continue;
+    }
+    switch (action.value()) {
+    case thrift::MplsActionCode::PUSH:
+      size += RTA_SPACE(0) + RTA_SPACE(kMaxLabels * sizeof(struct mpls_label)) +
+          RTA_SPACE(sizeof(uint16_t)) + RTA_SPACE(sizeof(struct in6_addr));
+      break;
+    case thrift::MplsActionCode::POP_AND_LOOKUP:
+      size += RTA_SPACE(sizeof(int));
+      break;
+    default:
+      size += RTA_SPACE(sizeof(struct mpls_label)) +
+          RTA_SPACE(sizeof(struct _NextHop));
+    }
+  }
+  return size;
+}
+
 NetlinkRouteMessage::~NetlinkRouteMessage() {
   CHECK(routePromise_.isFulfilled());
 }
 
 void
-NetlinkRouteMessage::rcvdRoute(Route&& route) {
+NetlinkRouteMessage::rcvdRoute(const struct nlmsghdr* nlh) {
   //
-  // Implement application side filters for table and protocol if specified
+  // Implement application side filters for table and protocol if specified.
+  // Filters are applied on header before parsing the route
   //
 
-  if (filters_.table && filters_.table != route.getRouteTable()) {
-    return; // ignore the route
-  }
+  const struct rtmsg* const routeEntry =
+      reinterpret_cast<const struct rtmsg*>(NLMSG_DATA(nlh));
 
-  if (filters_.protocol && filters_.protocol != route.getProtocolId()) {
+  if (filters_.table && filters_.table != routeEntry->rtm_table) {
     return; // ignore the route
   }
 
-  if (filters_.type && filters_.type != route.getType()) {
+  if (filters_.protocol && filters_.protocol != routeEntry->rtm_protocol) {
     return; // ignore the route
   }
 
-  NextHopSet reversedMplsLabelNhs;
-  bool reverted = false;
-  for (auto nh : route.getNextHops()) {
-    auto pushLabels = nh.getPushLabels();
-    // reverse the push labels becasue thrift API definition.
-    if (pushLabels.has_value()) {
-      reverted = true;
-      std::reverse(pushLabels.value().begin(), pushLabels.value().end());
-      nh.setPushLabels(pushLabels.value());
-    }
-    reversedMplsLabelNhs.insert(nh);
-  }
-  if (reverted) {
-    route.setNextHops(reversedMplsLabelNhs);
+  if (filters_.type && filters_.type != routeEntry->rtm_type) {
+    return; // ignore the route
   }
 
-  rcvdRoutes_.emplace_back(std::move(route));
+  rcvdRoutes_.emplace_back(parseMessage(nlh));
 }
 
 void
@@ -361,39 +388,45 @@ NetlinkRouteMessage::addPushNexthop(
 
 int
 NetlinkRouteMessage::addNextHops(const Route& route) {
-  std::array<char, kMaxNlPayloadSize> nhop = {};
-  int status{0};
-  if (route.getNextHops().size()) {
-    if ((status = addMultiPathNexthop(nhop, route))) {
-      return status;
-    }
+  if (route.getNextHops().empty()) {
+    return 0;
+  }
 
-    // copy the encap info into NLMSG payload
-    const char* const data = reinterpret_cast<const char*>(
-        RTA_DATA(reinterpret_cast<struct rtattr*>(nhop.data())));
-    int payloadLen = RTA_PAYLOAD(reinterpret_cast<struct rtattr*>(nhop.data()));
-    if ((status = addAttributes(RTA_MULTIPATH, data, payloadLen, msghdr_))) {
-      return status;
-    };
+  // Add empty RTA_MULTIPATH attribute and encode next-hops in place into it
+  const uint32_t rtaOffset = NLMSG_ALIGN(msghdr_->nlmsg_len);
+  int status{0};
+  if ((status = addAttributes(RTA_MULTIPATH, nullptr, 0, msghdr_))) {
+    return status;
+  }
+  struct rtattr* rta = reinterpret_cast<struct rtattr*>(
+      reinterpret_cast<char*>(msghdr_) + rtaOffset);
+  if ((status = addMultiPathNexthop(rta, route))) {
+    return status;
   }
+
+  // update the length in NL MSG header
+  msghdr_->nlmsg_len = rtaOffset + RTA_ALIGN(rta->rta_len);
   return 0;
 }
 
 int
 NetlinkRouteMessage::addMultiPathNexthop(
-    std::array<char, kMaxNlPayloadSize>& nhop, const Route& route) const {
+    struct rtattr* rta, const Route& route) const {
   // Add [RTA_MULTIPATH - label, via, dev][RTA_ENCAP][RTA_ENCAP_TYPE]
-  struct rtattr* rta = reinterpret_cast<struct rtattr*>(nhop.data());
-
-  // MULTIPATH
-  rta->rta_type = RTA_MULTIPATH;
-  rta->rta_len = RTA_LENGTH(0);
   struct rtnexthop* rtnh = reinterpret_cast<struct rtnexthop*>(RTA_DATA(rta));
 
   int result{0};
   const auto& paths = route.getNextHops();
   for (const auto& path : paths) {
+    if (RTA_ALIGN(rta->rta_len) + sizeof(*rtnh) >
+            std::numeric_limits<decltype(rta->rta_len)>::max() or
+        not hasSpace(rtnh, sizeof(*rtnh))) {
+      LOG(ERROR) << "No buffer for adding next-hop of " << route.str();
+      return ENOBUFS;
+    }
+    // buffer may be reused, reset fields which are not always set
     rtnh->rtnh_len = sizeof(*rtnh);
+    rtnh->rtnh_ifindex = 0;
     rta->rta_len += rtnh->rtnh_len;
     auto action = path.getLabelAction();
 
@@ -534,6 +567,9 @@ NetlinkRouteMessage::parseNextHopAttribute(
     // MPLS Labels
     auto pushLabels = parseMplsLabels(routeAttr);
     if (pushLabels.has_value()) {
+      // reverse the push labels becasue thrift API definition. They're
+      // encoded in reverse order, see `addPushNexthop`
+      std::reverse(pushLabels->begin(), pushLabels->end());
       nhBuilder.setPushLabels(pushLabels.value());
     }
   } break;
@@ -628,13 +664,7 @@ NetlinkRouteMessage::parseMessage(const struct nlmsghdr* nlmsg) {
     // are subattributes in RTA_MULTIPATH
     case RTA_MULTIPATH: {
       singleNextHopFlag = false;
-      auto nextHops = parseNextHops(routeAttr, routeEntry->rtm_family);
-      for (auto& nh : nextHops) {
-        // don't add empty nexthop
-        if (nh.getGateway().has_value() || nh.getIfIndex().has_value()) {
-          routeBuilder.addNextHop(nh);
-        }
-      }
+      parseNextHops(routeAttr, routeEntry->rtm_family, routeBuilder);
     } break;
     }
   }
@@ -664,10 +694,11 @@ NetlinkRouteMessage::parseMessage(const struct nlmsghdr* nlmsg) {
   return route;
 }
 
-std::vector<NextHop>
+void
 NetlinkRouteMessage::parseNextHops(
-    const struct rtattr* routeAttrMP, unsigned char family) {
-  std::vector<NextHop> nextHops;
+    const struct rtattr* routeAttrMP,
+    unsigned char family,
+    RouteBuilder& routeBuilder) {
   struct rtnexthop* nh =
       reinterpret_cast<struct rtnexthop*> RTA_DATA(routeAttrMP);
 
@@ -696,12 +727,14 @@ NetlinkRouteMessage::parseNextHops(
       nhBuilder.setWeight(nh->rtnh_hops + 1);
     }
     setMplsAction(nhBuilder, family);
+    // don't add empty nexthop
     auto nexthop = nhBuilder.build();
-    nextHops.emplace_back(nexthop);
+    if (nexthop.getGateway().has_value() || nexthop.getIfIndex().has_value()) {
+      routeBuilder.addNextHop(nexthop);
+    }
     nhLen -= NLMSG_ALIGN(nh->rtnh_len);
     nh = RTNH_NEXT(nh);
   } while (RTNH_OK(nh, nhLen));
-  return nextHops;
 }
 
 int
@@ -809,7 +842,91 @@ NetlinkRouteMessage::deleteLabelRoute(const Route& route) {
       msghdr_);
 }
 
-NetlinkLinkMessage::NetlinkLinkMessage() {
+NetlinkRouteBatchMessage::NetlinkRouteBatchMessage(
+    std::shared_ptr<NetlinkMessageBufferPool> pool)
+    : NetlinkMessage(kMinNlMessageSize, pool), pool_(std::move(pool)) {}
+
+NetlinkRouteBatchMessage::~NetlinkRouteBatchMessage() {
+  CHECK(errorsPromise_.isFulfilled());
+  if (pool_) {
+    pool_->releaseExternal(bufBytesAccounted_);
+  }
+}
+
+int
+NetlinkRouteBatchMessage::appendRoute(
+    int type, const Route& route, std::optional<size_t> index) {
+  // Requests are encoded in scratch message and then copied to buf_. It is
+  // reused by all batches built on the thread
+  thread_local auto const scratch = []() {
+    auto msg = std::make_unique<NetlinkRouteMessage>(kMaxNlMessageSize);
+    // only used for encoding, its promises are never consumed
+    msg->setReturnStatus(0);
+    return msg;
+  }();
+
+  int status{0};
+  const bool isMpls = route.getFamily() == AF_MPLS;
+  if (type == RTM_NEWROUTE) {
+    status = isMpls ? scratch->addLabelRoute(route) : scratch->addRoute(route);
+  } else if (type == RTM_DELROUTE) {
+    status =
+        isMpls ? scratch->deleteLabelRoute(route) : scratch->deleteRoute(route);
+  } else {
+    status = EINVAL;
+  }
+
+  if (status != 0) {
+    if (index.has_value()) {
+      encodeErrors_.emplace_back(*index, status);
+    }
+    return status;
+  }
+
+  // Copy encoded message at the end of the buffer
+  const auto len = NLMSG_ALIGN(scratch->getDataLength());
+  const auto offset = buf_.size();
+  buf_.resize(offset + len);
+  memcpy(buf_.data() + offset, scratch->getMessagePtr(), len);
+  if (pool_ and buf_.capacity() != bufBytesAccounted_) {
+    pool_->acquireExternal(buf_.capacity() - bufBytesAccounted_);
+    bufBytesAccounted_ = buf_.capacity();
+  }
+  msgOffsets_.emplace_back(offset);
+  msgRouteIndex_.emplace_back(index);
+  msgStatus_.emplace_back(0);
+  return 0;
+}
+
+void
+NetlinkRouteBatchMessage::failMessages(size_t begin, size_t end, int status) {
+  for (size_t i = begin; i < end; ++i) {
+    if (msgStatus_.at(i) == 0) {
+      msgStatus_.at(i) = status;
+    }
+  }
+}
+
+void
+NetlinkRouteBatchMessage::setReturnStatus(int status) {
+  if (status != 0) {
+    failMessages(numSentMessages_, getNumMessages(), status);
+  }
+
+  Errors errors = std::move(encodeErrors_);
+  for (size_t i = 0; i < getNumMessages(); ++i) {
+    if (msgStatus_[i] != 0 and msgRouteIndex_[i].has_value()) {
+      errors.emplace_back(*msgRouteIndex_[i], msgStatus_[i]);
+    }
+  }
+  errorsPromise_.setValue(std::move(errors));
+
+  NetlinkMessage::setReturnStatus(status);
+}
+
+NetlinkLinkMessage::NetlinkLinkMessage(
+    std::shared_ptr<NetlinkMessageBufferPool> pool)
+    : NetlinkMessage(kMinNlMessageSize, std::move(pool)) {
   // get pointer to NLMSG header
   msghdr_ = getMessagePtr();
 }
@@ -883,7 +1000,9 @@ NetlinkLinkMessage::parseMessage(const struct nlmsghdr* nlmsg) {
   return link;
 }
 
-NetlinkAddrMessage::NetlinkAddrMessage() {
+NetlinkAddrMessage::NetlinkAddrMessage(
+    std::shared_ptr<NetlinkMessageBufferPool> pool)
+    : NetlinkMessage(kMinNlMessageSize, std::move(pool)) {
   // get pointer to NLMSG header
   msghdr_ = getMessagePtr();
 }
@@ -1016,7 +1135,9 @@ NetlinkAddrMessage::parseMessage(const struct nlmsghdr* nlmsg) {
   return addr;
 }
 
-NetlinkNeighborMessage::NetlinkNeighborMessage() {
+NetlinkNeighborMessage::NetlinkNeighborMessage(
+    std::shared_ptr<NetlinkMessageBufferPool> pool)
+    : NetlinkMessage(kMinNlMessageSize, std::move(pool)) {
   // get pointer to NLMSG header
   msghdr_ = getMessagePtr();
 }
@@ -40,7 +40,9 @@ constexpr uint32_t kLabelSizeBits{20};
  */
 class NetlinkRouteMessage final : public NetlinkMessage {
  public:
-  NetlinkRouteMessage();
+  explicit NetlinkRouteMessage(
+      size_t capacity = kMinNlMessageSize,
+      std::shared_ptr<NetlinkMessageBufferPool> pool = nullptr);
 
   ~NetlinkRouteMessage() override;
 
@@ -84,6 +86,10 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   // process netlink route message
   static Route parseMessage(const struct nlmsghdr* nlmsg);
 
+  // Upper bound on the size of add or delete request of the route. Use it as
+  // capacity of the message
+  static size_t estimateSize(const Route& route);
+
  private:
   // print ancillary data
   void showRtmMsg(const struct rtmsg* const hdr) const;
@@ -98,9 +104,11 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   static folly::Expected<folly::IPAddress, folly::IPAddressFormatError> parseIp(
       const struct rtattr* ipAttr, unsigned char family);
 
-  // process netlink next hops
-  static std::vector<NextHop> parseNextHops(
-      const struct rtattr* routeAttrMultipath, unsigned char family);
+  // process netlink next hops and add them to the route
+  static void parseNextHops(
+      const struct rtattr* routeAttrMultipath,
+      unsigned char family,
+      RouteBuilder& routeBuilder);
 
   // parse NextHop Attributes
   static void parseNextHopAttribute(
@@ -121,9 +129,9 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   // add set of nexthops
   int addNextHops(const Route& route);
 
-  // Add ECMP paths
-  int addMultiPathNexthop(
-      std::array<char, kMaxNlPayloadSize>& nhop, const Route& route) const;
+  // Add ECMP paths into RTA_MULTIPATH attribute, which must be the last
+  // attribute of the message
+  int addMultiPathNexthop(struct rtattr* rta, const Route& route) const;
 
   // Add label encap
   int addPushNexthop(
@@ -159,7 +167,7 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   } __attribute__((__packed__));
 
  private:
-  void rcvdRoute(Route&& route) override;
+  void rcvdRoute(const struct nlmsghdr* nlh) override;
 
   struct {
     uint8_t table{0};
@@ -171,12 +179,121 @@ class NetlinkRouteMessage final : public NetlinkMessage {
   std::vector<Route> rcvdRoutes_;
 };
 
+/**
+ * Batch of route add/delete requests. Messages are encoded back to back into a
+ * single buffer so that they can be sent to kernel in large chunks with one
+ * `sendmsg` call each. Only the last message of a chunk requests an ack, kernel
+ * reports failures of others with an error message. Completion is tracked per
+ * batch and only the failed requests are reported back.
+ */
+class NetlinkRouteBatchMessage final : public NetlinkMessage {
+ public:
+  // Index of the route in the batch request and its error code
+  using Errors = std::vector<std::pair<size_t, int>>;
+
+  explicit NetlinkRouteBatchMessage(
+      std::shared_ptr<NetlinkMessageBufferPool> pool = nullptr);
+
+  ~NetlinkRouteBatchMessage() override;
+
+  // Override setReturnStatus. Set errorsPromise_ with failed requests. Non
+  // zero status is set on all messages which haven't been sent yet
+  void setReturnStatus(int status) override;
+
+  // Get future for failed requests of the batch
+  folly::SemiFuture<Errors>
+  getErrorsSemiFuture() {
+    return errorsPromise_.getSemiFuture();
+  }
+
+  // Append RTM_NEWROUTE or RTM_DELROUTE request for the route at given index
+  // of batch request. Errors of the request, including encoding errors, are
+  // not reported if index is not set
+  // @returns 0 on success else relevant system error code
+  int appendRoute(int type, const Route& route, std::optional<size_t> index);
+
+  size_t
+  getNumMessages() const {
+    return msgOffsets_.size();
+  }
+
+  // get pointer to NLMSG header of i-th message
+  struct nlmsghdr*
+  getMessage(size_t i) {
+    return reinterpret_cast<struct nlmsghdr*>(buf_.data() + msgOffsets_.at(i));
+  }
+
+  // Length of contiguous messages in range [begin, end)
+  size_t
+  getMessagesLength(size_t begin, size_t end) const {
+    const size_t endOffset =
+        end < msgOffsets_.size() ? msgOffsets_.at(end) : buf_.size();
+    return endOffset - msgOffsets_.at(begin);
+  }
+
+  // Set return status of i-th message
+  void
+  setMessageStatus(size_t i, int status) {
+    msgStatus_.at(i) = status;
+  }
+
+  // Set status on messages in range [begin, end) without status set yet
+  void failMessages(size_t begin, size_t end, int status);
+
+  size_t
+  getNumSentMessages() const {
+    return numSentMessages_;
+  }
+
+  // Mark next chunk of given number of messages as sent to kernel
+  void
+  chunkSent(size_t numMessages) {
+    numSentMessages_ += numMessages;
+    ++numPendingChunks_;
+  }
+
+  // Mark a chunk as acknowledged by kernel
+  // @returns true if all the messages are sent and acknowledged
+  bool
+  chunkDone() {
+    CHECK_GT(numPendingChunks_, 0);
+    --numPendingChunks_;
+    return numPendingChunks_ == 0 and numSentMessages_ == getNumMessages();
+  }
+
+ private:
+  // Pool accounting for buf_, if any
+  const std::shared_ptr<NetlinkMessageBufferPool> pool_;
+
+  // Contiguous messages and offset of each message in it. Its capacity is
+  // accounted in pool_ as it can exceed size of pool buffers
+  std::vector<char> buf_;
+  size_t bufBytesAccounted_{0};
+  std::vector<size_t> msgOffsets_;
+
+  // Index of route in batch request per message, not set for messages whose
+  // errors are ignored
+  std::vector<std::optional<size_t>> msgRouteIndex_;
+
+  // Return status per message
+  std::vector<int> msgStatus_;
+
+  // Errors for routes which couldn't be encoded and hence are not sent
+  Errors encodeErrors_;
+
+  size_t numSentMessages_{0};
+  size_t numPendingChunks_{0};
+
+  folly::Promise<Errors> errorsPromise_;
+};
+
 /**
  * Message specialization for LINK object
  */
 class NetlinkLinkMessage final : public NetlinkMessage {
  public:
-  NetlinkLinkMessage();
+  explicit NetlinkLinkMessage(
+      std::shared_ptr<NetlinkMessageBufferPool> pool = nullptr);
 
   ~NetlinkLinkMessage() override;
 
@@ -213,7 +330,8 @@ class NetlinkLinkMessage final : public NetlinkMessage {
  */
 class NetlinkAddrMessage final : public NetlinkMessage {
  public:
-  NetlinkAddrMessage();
+  explicit NetlinkAddrMessage(
+      std::shared_ptr<NetlinkMessageBufferPool> pool = nullptr);
 
   ~NetlinkAddrMessage() override;
 
@@ -254,7 +372,8 @@ class NetlinkAddrMessage final : public NetlinkMessage {
  */
 class NetlinkNeighborMessage final : public NetlinkMessage {
  public:
-  NetlinkNeighborMessage();
+  explicit NetlinkNeighborMessage(
+      std::shared_ptr<NetlinkMessageBufferPool> pool = nullptr);
 
   ~NetlinkNeighborMessage() override;
 
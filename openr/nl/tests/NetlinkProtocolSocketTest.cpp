@@ -541,6 +541,102 @@ TEST(NetlinkRouteMessage, EncodeLabel) {
   }
 }
 
+TEST(NetlinkMessageBufferPool, ReuseBuffers) {
+  fbnl::NetlinkMessageBufferPool pool(1 /* maxFreeBuffersPerSize */);
+
+  // Sizes are rounded up to size class
+  auto [buf1, size1] = pool.allocate(1);
+  auto [buf2, size2] = pool.allocate(fbnl::kMinNlMessageSize + 1);
+  auto [buf3, size3] = pool.allocate(fbnl::kMaxNlMessageSize * 2);
+  EXPECT_EQ(fbnl::kMinNlMessageSize, size1);
+  EXPECT_EQ(fbnl::kMinNlMessageSize * 2, size2);
+  EXPECT_EQ(fbnl::kMaxNlMessageSize, size3);
+  EXPECT_EQ(size1 + size2 + size3, pool.getBytesInUse());
+  EXPECT_EQ(0, pool.getBytesFree());
+
+  // Released buffer is reused and zeroed
+  buf1[0] = 'x';
+  auto* const ptr1 = buf1.get();
+  pool.release(std::move(buf1), size1);
+  EXPECT_EQ(size1, pool.getBytesFree());
+  auto [buf4, size4] = pool.allocate(10);
+  EXPECT_EQ(ptr1, buf4.get());
+  EXPECT_EQ(0, buf4[0]);
+  EXPECT_EQ(0, pool.getBytesFree());
+
+  // Only one free buffer is retained per size class
+  auto [buf5, size5] = pool.allocate(10);
+  pool.release(std::move(buf4), size4);
+  pool.release(std::move(buf5), size5);
+  EXPECT_EQ(size1, pool.getBytesFree());
+
+  pool.release(std::move(buf2), size2);
+  pool.release(std::move(buf3), size3);
+  EXPECT_EQ(0, pool.getBytesInUse());
+  EXPECT_EQ(size1 * 2 + size2 + size3, pool.getBytesInUseHighWaterMark());
+}
+
+TEST(NetlinkRouteBatchMessage, PoolAccounting) {
+  auto pool = std::make_shared<fbnl::NetlinkMessageBufferPool>();
+
+  fbnl::RouteBuilder rtBuilder;
+  rtBuilder.setDestination(ipPrefix1).setProtocolId(kRouteProtoId);
+  fbnl::NextHopBuilder nhBuilder;
+  nhBuilder.setIfIndex(1).setGateway(folly::IPAddress("fe80::1"));
+  rtBuilder.addNextHop(nhBuilder.build());
+  const auto route = rtBuilder.build();
+
+  // Payload of batch exceeding size of pool buffers is accounted in pool
+  {
+    fbnl::NetlinkRouteBatchMessage batch(pool);
+    const auto bytesInUse = pool->getBytesInUse();
+    while (batch.getMessagesLength(0, batch.getNumMessages()) <=
+           fbnl::kMaxNlMessageSize) {
+      EXPECT_EQ(0, batch.appendRoute(RTM_NEWROUTE, route, 0));
+    }
+    EXPECT_LT(bytesInUse + fbnl::kMaxNlMessageSize, pool->getBytesInUse());
+    EXPECT_EQ(pool->getBytesInUse(), pool->getBytesInUseHighWaterMark());
+    batch.setReturnStatus(0);
+  }
+  EXPECT_EQ(0, pool->getBytesInUse());
+}
+
+TEST(NetlinkRouteMessage, LargeMultipathRoute) {
+  auto pool = std::make_shared<fbnl::NetlinkMessageBufferPool>();
+
+  // Encoded nexthops exceed 4KB
+  fbnl::RouteBuilder rtBuilder;
+  rtBuilder.setDestination(ipPrefix1).setProtocolId(kRouteProtoId);
+  for (uint32_t i = 0; i < 300; i++) {
+    fbnl::NextHopBuilder nhBuilder;
+    nhBuilder.setIfIndex(1).setGateway(
+        folly::IPAddress(folly::sformat("fe80::{:x}", i + 1)));
+    rtBuilder.addNextHop(nhBuilder.build());
+  }
+  const auto route = rtBuilder.build();
+
+  {
+    NetlinkRouteMessage msg(NetlinkRouteMessage::estimateSize(route), pool);
+    EXPECT_EQ(0, msg.addRoute(route));
+    EXPECT_LT(4096, msg.getDataLength());
+    EXPECT_GE(msg.getCapacity(), msg.getDataLength());
+    EXPECT_EQ(msg.getCapacity(), pool->getBytesInUse());
+
+    auto parsedRoute = NetlinkRouteMessage::parseMessage(msg.getMessagePtr());
+    EXPECT_EQ(route.getDestination(), parsedRoute.getDestination());
+    EXPECT_EQ(300, parsedRoute.getNextHops().size());
+    msg.setReturnStatus(0);
+  }
+  EXPECT_EQ(0, pool->getBytesInUse());
+
+  // Encoding beyond the capacity fails
+  {
+    NetlinkRouteMessage msg(fbnl::kMinNlMessageSize, pool);
+    EXPECT_EQ(ENOBUFS, msg.addRoute(route));
+    msg.setReturnStatus(ENOBUFS);
+  }
+}
+
 /**
  * This test intends to test the delayed looping of event-base. Request is
  * made before event loop is started. This will help ensuring that socket
@@ -838,14 +934,14 @@ TEST_F(NlMessageFixture, IpRouteMultipleLabelNextHops) {
 }
 
 TEST_F(NlMessageFixture, MaxPayloadExceeded) {
-  // check for max payload handling. Add nexthops that exceeds payload size
-  // Should error out
+  // check for max payload handling. Add nexthops that exceeds maximum length
+  // of RTA_MULTIPATH attribute. Should error out
 
   std::vector<openr::fbnl::NextHop> paths;
   struct v6Addr addr6 {
     0
   };
-  for (uint32_t i = 0; i < 200; i++) {
+  for (uint32_t i = 0; i < 2000; i++) {
     addr6.u32_addr[0] = htonl(0xfe800000 + i);
     folly::IPAddress ipAddress = folly::IPAddress::fromBinary(folly::ByteRange(
         static_cast<const unsigned char*>(&addr6.u8_addr[0]), 16));
@@ -1133,6 +1229,53 @@ TEST_F(NlMessageFixture, MultipleIpRoutesLabelNexthop) {
   EXPECT_EQ(0, kernelRoutes.size());
 }
 
+TEST_F(NlMessageFixture, MultipleIpRoutesBatch) {
+  // Add IPv6 routes in a batch along with an invalid route. Only the invalid
+  // route must be reported as failed
+
+  uint32_t count{100000};
+  auto routes = buildV6RouteDb(count);
+
+  // Invalid route, send PUSH without labels
+  std::vector<openr::fbnl::NextHop> paths;
+  paths.push_back(buildNextHop(
+      folly::none,
+      folly::none,
+      thrift::MplsActionCode::PUSH,
+      ipAddrY1V6,
+      ifIndexX,
+      1));
+  routes.emplace_back(
+      buildRoute(kRouteProtoId, ipPrefix1, folly::none, paths));
+
+  LOG(INFO) << "Adding " << count << " routes in a batch";
+  {
+    auto errors = nlSock->addRoutes(routes).get();
+    ASSERT_EQ(1, errors.size());
+    EXPECT_EQ(count, errors.at(0).first);
+    EXPECT_EQ(EINVAL, std::abs(errors.at(0).second));
+  }
+  LOG(INFO) << "Done adding " << count << " routes";
+
+  // verify routes are programmed
+  auto kernelRoutes = nlSock->getIPv6Routes(kRouteProtoId).get().value();
+  routes.pop_back(); // Invalid route
+  EXPECT_EQ(kernelRoutes.size(), routes.size());
+  EXPECT_EQ(findRoutesInKernelRoutes(kernelRoutes, routes), count);
+
+  // delete routes, and one more time to get ESRCH for every route
+  EXPECT_TRUE(nlSock->deleteRoutes(routes).get().empty());
+  auto errors = nlSock->deleteRoutes(routes).get();
+  EXPECT_EQ(count, errors.size());
+  for (auto const& [_, error] : errors) {
+    EXPECT_EQ(ESRCH, std::abs(error));
+  }
+
+  // verify route deletions
+  kernelRoutes = nlSock->getIPv6Routes(kRouteProtoId).get().value();
+  EXPECT_EQ(0, kernelRoutes.size());
+}
+
 TEST_F(NlMessageFixture, LabelRouteV4Nexthop) {
   // Add label route with single path label with PHP nexthop
 
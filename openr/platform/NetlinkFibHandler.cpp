@@ -11,6 +11,7 @@
 #include <functional>
 #include <iterator>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 
 #include <folly/Format.h>
@@ -40,11 +41,74 @@ createSemiFutureWithClientIdError() {
   return std::move(sf);
 }
 
+// Whether protocol is mapped to any FIB client, i.e. it is programmed by us
+bool
+isClientProtocol(uint8_t protocol) {
+  static const std::unordered_set<uint8_t> kClientProtocols = []() {
+    std::unordered_set<uint8_t> protocols;
+    for (auto const& [_, protocolId] :
+         thrift::Platform_constants::clientIdtoProtocolId()) {
+      protocols.emplace(static_cast<uint8_t>(protocolId));
+    }
+    return protocols;
+  }();
+  return kClientProtocols.count(protocol);
+}
+
+// Whether any nexthop of route is over interface
+bool
+hasNextHopOverIf(const fbnl::Route& route, int ifIndex) {
+  return std::any_of(
+      route.getNextHops().begin(),
+      route.getNextHops().end(),
+      [ifIndex](const fbnl::NextHop& nh) {
+        return nh.getIfIndex() == ifIndex;
+      });
+}
+
+// Erase routes with nexthop over interface, returns number of erased routes
+template <typename K>
+size_t
+eraseRoutesOverIf(std::unordered_map<K, fbnl::Route>& routes, int ifIndex) {
+  size_t numErased{0};
+  for (auto it = routes.begin(); it != routes.end();) {
+    if (hasNextHopOverIf(it->second, ifIndex)) {
+      it = routes.erase(it);
+      ++numErased;
+    } else {
+      ++it;
+    }
+  }
+  return numErased;
+}
+
+// Number of routes which differ between two route maps
+template <typename K>
+size_t
+getNumMismatchedRoutes(
+    const std::unordered_map<K, fbnl::Route>& routes1,
+    const std::unordered_map<K, fbnl::Route>& routes2) {
+  size_t numMismatched{0};
+  for (auto const& [key, route] : routes1) {
+    auto it = routes2.find(key);
+    if (it == routes2.end() or not(it->second == route)) {
+      ++numMismatched;
+    }
+  }
+  for (auto const& [key, _] : routes2) {
+    numMismatched += routes1.count(key) ? 0 : 1;
+  }
+  return numMismatched;
+}
+
 } // namespace
 
-NetlinkFibHandler::NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock)
+NetlinkFibHandler::NetlinkFibHandler(
+    fbnl::NetlinkProtocolSocket* nlSock,
+    std::chrono::seconds routeCacheAuditInterval)
     : facebook::fb303::BaseService("openr"),
       nlSock_(nlSock),
+      routeCacheAuditInterval_(routeCacheAuditInterval),
       startTime_(std::chrono::duration_cast<std::chrono::seconds>(
                      std::chrono::system_clock::now().time_since_epoch())
                      .count()) {
@@ -65,6 +129,19 @@ NetlinkFibHandler::NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock)
           });
     }
   });
+
+  // Keep route cache up to date with route events. Only routes of main table
+  // and of protocols mapped to clients are parsed
+  nlSock_->setRouteEventCB(
+      [this](fbnl::Route route, bool) { updateRouteCache(std::move(route)); },
+      [](uint8_t table, uint8_t protocol) {
+        return table == RT_TABLE_MAIN and isClientProtocol(protocol);
+      });
+  // Kernel flushes routes over down links silently
+  nlSock_->setRoutesFlushedCB(
+      [this](int ifIndex) { invalidateRouteCache(ifIndex); });
+  // Route events may be lost on socket overrun, cache can't be trusted then
+  nlSock_->setEventsLostCB([this]() { invalidateRouteCache(); });
 }
 
 NetlinkFibHandler::~NetlinkFibHandler() {}
@@ -103,19 +180,27 @@ NetlinkFibHandler::protocolToPriority(const uint8_t protocol) {
 
 folly::SemiFuture<folly::Unit>
 NetlinkFibHandler::collectAllResult(
-    std::vector<folly::SemiFuture<int>>&& result,
+    std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>>&&
+        result,
     std::set<int> errorsToIgnore) {
   return folly::collectAll(std::move(result))
-      .deferValue([errorsToIgnore](std::vector<folly::Try<int>>&& retvals) {
-        for (auto& retvalTry : retvals) {
-          auto retval = std::abs(retvalTry.value()); // Throws exception if any
-          if (retval == 0 or errorsToIgnore.count(retval)) {
-            continue;
-          }
-          throw fbnl::NlException("One or more netlink request failed", retval);
-        }
-        return folly::Unit();
-      });
+      .deferValue(
+          [errorsToIgnore](
+              std::vector<folly::Try<fbnl::NetlinkRouteBatchMessage::Errors>>&&
+                  batchErrors) {
+            for (auto& errorsTry : batchErrors) {
+              // Throws exception if any
+              for (auto const& [_, error] : errorsTry.value()) {
+                auto retval = std::abs(error);
+                if (errorsToIgnore.count(retval)) {
+                  continue;
+                }
+                throw fbnl::NlException(
+                    "One or more netlink request failed", retval);
+              }
+            }
+            return folly::Unit();
+          });
 }
 
 folly::SemiFuture<folly::Unit>
@@ -146,11 +231,14 @@ NetlinkFibHandler::semifuture_addUnicastRoutes(
   LOG(INFO) << "Adding/Updating unicast routes of client "
             << getClientName(clientId) << ", numRoutes=" << routes->size();
 
-  // Add routes and return a collected semifuture
-  std::vector<folly::SemiFuture<int>> result;
+  // Add routes in a batch and return a collected semifuture
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(routes->size());
   for (auto& route : *routes) {
-    result.emplace_back(nlSock_->addRoute(buildRoute(route, protocol.value())));
+    nlRoutes.emplace_back(buildRoute(route, protocol.value()));
   }
+  std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>> result;
+  result.emplace_back(nlSock_->addRoutes(nlRoutes));
   return collectAllResult(std::move(result), {EEXIST});
 }
 
@@ -165,14 +253,17 @@ NetlinkFibHandler::semifuture_deleteUnicastRoutes(
   LOG(INFO) << "Deleting unicast routes of client " << getClientName(clientId)
             << ", numRoutes=" << prefixes->size();
 
-  // Delete routes and return a collected semifuture
-  std::vector<folly::SemiFuture<int>> result;
+  // Delete routes in a batch and return a collected semifuture
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(prefixes->size());
   for (auto& prefix : *prefixes) {
     fbnl::RouteBuilder rtBuilder;
     rtBuilder.setDestination(toIPNetwork(prefix));
     rtBuilder.setProtocolId(protocol.value());
-    result.emplace_back(nlSock_->deleteRoute(rtBuilder.build()));
+    nlRoutes.emplace_back(rtBuilder.build());
   }
+  std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>> result;
+  result.emplace_back(nlSock_->deleteRoutes(nlRoutes));
   return collectAllResult(std::move(result), {ESRCH});
 }
 
@@ -187,12 +278,14 @@ NetlinkFibHandler::semifuture_addMplsRoutes(
   LOG(INFO) << "Adding/Updating mpls routes of client "
             << getClientName(clientId) << ", numRoutes=" << routes->size();
 
-  // Add routes and return a collected semifuture
-  std::vector<folly::SemiFuture<int>> result;
+  // Add routes in a batch and return a collected semifuture
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(routes->size());
   for (auto& route : *routes) {
-    result.emplace_back(
-        nlSock_->addRoute(buildMplsRoute(route, protocol.value())));
+    nlRoutes.emplace_back(buildMplsRoute(route, protocol.value()));
   }
+  std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>> result;
+  result.emplace_back(nlSock_->addRoutes(nlRoutes));
   return collectAllResult(std::move(result), {EEXIST});
 }
 
@@ -207,14 +300,17 @@ NetlinkFibHandler::semifuture_deleteMplsRoutes(
   LOG(INFO) << "Deleting mpls routes of client " << getClientName(clientId)
             << ", numRoutes=" << topLabels->size();
 
-  // Delete routes and return a collected semifuture
-  std::vector<folly::SemiFuture<int>> result;
+  // Delete routes in a batch and return a collected semifuture
+  std::vector<fbnl::Route> nlRoutes;
+  nlRoutes.reserve(topLabels->size());
   for (auto& topLabel : *topLabels) {
     fbnl::RouteBuilder rtBuilder;
     rtBuilder.setMplsLabel(topLabel);
     rtBuilder.setProtocolId(protocol.value());
-    result.emplace_back(nlSock_->deleteRoute(rtBuilder.build()));
+    nlRoutes.emplace_back(rtBuilder.build());
   }
+  std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>> result;
+  result.emplace_back(nlSock_->deleteRoutes(nlRoutes));
   return collectAllResult(std::move(result), {ESRCH});
 }
 
@@ -230,62 +326,51 @@ NetlinkFibHandler::semifuture_syncFib(
   LOG(INFO) << "Syncing unicast FIB for client " << getClientName(clientId)
             << ", numRoutes=" << unicastRoutes->size();
 
-  // SemiFuture vector for collecting return values of all API calls
-  std::vector<folly::SemiFuture<int>> result;
+  // Routes to add or replace and stale routes to delete, sent in batches
+  std::vector<fbnl::Route> routesToAdd;
+  std::vector<fbnl::Route> routesToDelete;
 
-  // Create set of existing route
-  // NOTE: Synchronous call to retrieve all the routes. We first make both
-  // requests to retrieve IPv4 and IPv6 routes. Subsequently we wait on them
-  // to complete and prepare the map of existing routes
-  std::unordered_map<folly::CIDRNetwork, fbnl::Route> existingRoutes;
+  // Get existing routes from cache. Refreshed from kernel if needed
+  refreshUnicastRouteCache(protocol.value());
   {
-    auto v4Routes = nlSock_->getIPv4Routes(protocol.value()).get();
-    auto v6Routes = nlSock_->getIPv6Routes(protocol.value()).get();
-    if (v4Routes.hasError()) {
-      throw fbnl::NlException("Failed fetching IPv4 routes", v4Routes.error());
-    }
-    if (v6Routes.hasError()) {
-      throw fbnl::NlException("Failed fetching IPv6 routes", v6Routes.error());
-    }
-    for (auto& route : std::move(v4Routes).value()) {
-      const auto prefix = route.getDestination();
-      existingRoutes.emplace(prefix, std::move(route));
-    }
-    for (auto& route : std::move(v6Routes).value()) {
-      const auto prefix = route.getDestination();
-      existingRoutes.emplace(prefix, std::move(route));
+    auto cache = routeCache_.rlock();
+    const auto& existingRoutes = cache->at(protocol.value()).unicast.routes;
+
+    // Go over the new routes. Add or update
+    std::unordered_set<folly::CIDRNetwork> newPrefixes;
+    for (auto& route : *unicastRoutes) {
+      const auto network = toIPNetwork(route.dest);
+      newPrefixes.insert(network);
+      auto nlRoute = buildRoute(route, protocol.value());
+      auto it = existingRoutes.find(network);
+      if (it != existingRoutes.end() and it->second == nlRoute) {
+        // Existing route is same as the one we're trying to add. SKIP
+        continue;
+      }
+      // Add new route or replace existing one
+      routesToAdd.emplace_back(std::move(nlRoute));
     }
-  }
 
-  // Go over the new routes. Add or update
-  std::unordered_set<folly::CIDRNetwork> newPrefixes;
-  for (auto& route : *unicastRoutes) {
-    const auto network = toIPNetwork(route.dest);
-    newPrefixes.insert(network);
-    auto nlRoute = buildRoute(route, protocol.value());
-    auto it = existingRoutes.find(network);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
-      // Existing route is same as the one we're trying to add. SKIP
-      continue;
+    // Go over the old routes to remove stale ones
+    for (auto& [prefix, nlRoute] : existingRoutes) {
+      if (newPrefixes.count(prefix)) {
+        // not a stale route
+        continue;
+      }
+      // Delete stale route
+      routesToDelete.emplace_back(nlRoute);
     }
-    // Add new route or replace existing one
-    result.emplace_back(nlSock_->addRoute(nlRoute));
   }
 
-  // Go over the old routes to remove stale ones
-  for (auto& [prefix, nlRoute] : existingRoutes) {
-    if (newPrefixes.count(prefix)) {
-      // not a stale route
-      continue;
-    }
-    // Delete stale route
-    result.emplace_back(nlSock_->deleteRoute(nlRoute));
-  }
+  // SemiFuture vector for collecting return values of all API calls
+  std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>> result;
+  result.emplace_back(nlSock_->addRoutes(routesToAdd));
+  result.emplace_back(nlSock_->deleteRoutes(routesToDelete));
 
   // Return collected result
-  // NOTE: We're ignoring EEXIST error code. ESRCH error code must not be
-  // raised because we're deleting route that already exist
-  return collectAllResult(std::move(result), {EEXIST});
+  // NOTE: We're ignoring EEXIST and ESRCH error codes. Route cache can lag
+  // behind kernel by route events which are not yet processed
+  return collectAllResult(std::move(result), {EEXIST, ESRCH});
 }
 
 folly::SemiFuture<folly::Unit>
@@ -300,47 +385,192 @@ NetlinkFibHandler::semifuture_syncMplsFib(
   LOG(INFO) << "Syncing mpls FIB for client " << getClientName(clientId)
             << ", numRoutes=" << mplsRoutes->size();
 
+  // Routes to add or replace and stale routes to delete, sent in batches
+  std::vector<fbnl::Route> routesToAdd;
+  std::vector<fbnl::Route> routesToDelete;
+
+  // Get existing routes from cache. Refreshed from kernel if needed
+  refreshMplsRouteCache(protocol.value());
+  {
+    auto cache = routeCache_.rlock();
+    const auto& existingRoutes = cache->at(protocol.value()).mpls.routes;
+
+    // Go over the new routes. Add or update
+    std::unordered_set<int32_t> newLabels;
+    for (auto& route : *mplsRoutes) {
+      newLabels.insert(route.topLabel);
+      auto nlRoute = buildMplsRoute(route, protocol.value());
+      auto it = existingRoutes.find(route.topLabel);
+      if (it != existingRoutes.end() and it->second == nlRoute) {
+        // Existing route is same as the one we're trying to add. SKIP
+        continue;
+      }
+      // Add new route or replace existing one
+      routesToAdd.emplace_back(std::move(nlRoute));
+    }
+
+    // Go over the old routes to remove stale ones
+    for (auto& [topLabel, nlRoute] : existingRoutes) {
+      if (newLabels.count(topLabel)) {
+        // not a stale route
+        continue;
+      }
+      // Delete stale route
+      routesToDelete.emplace_back(nlRoute);
+    }
+  }
+
   // SemiFuture vector for collecting return values of all API calls
-  std::vector<folly::SemiFuture<int>> result;
+  std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>> result;
+  result.emplace_back(nlSock_->addRoutes(routesToAdd));
+  result.emplace_back(nlSock_->deleteRoutes(routesToDelete));
+
+  // Return collected result
+  return collectAllResult(std::move(result), {EEXIST, ESRCH});
+}
+
+template <typename K>
+bool
+NetlinkFibHandler::isAuditDue(const CachedRoutes<K>& cachedRoutes) const {
+  return not cachedRoutes.auditTs.has_value() or
+      std::chrono::steady_clock::now() - cachedRoutes.auditTs.value() >=
+      routeCacheAuditInterval_;
+}
+
+void
+NetlinkFibHandler::invalidateRouteCache() {
+  auto cache = routeCache_.wlock();
+  for (auto& [protocol, routeCache] : *cache) {
+    LOG(INFO) << "Route cache of protocol " << static_cast<int>(protocol)
+              << " will be refreshed from kernel on next sync";
+    routeCache.unicast.auditTs.reset();
+    routeCache.mpls.auditTs.reset();
+  }
+}
+
+void
+NetlinkFibHandler::invalidateRouteCache(int ifIndex) {
+  // Dropped routes are re-programmed by next sync. Kernel replaces them if
+  // they weren't flushed
+  auto cache = routeCache_.wlock();
+  for (auto& [protocol, routeCache] : *cache) {
+    const auto numErased =
+        eraseRoutesOverIf(routeCache.unicast.routes, ifIndex) +
+        eraseRoutesOverIf(routeCache.mpls.routes, ifIndex);
+    LOG_IF(INFO, numErased)
+        << "Dropped " << numErased << " cached routes of protocol "
+        << static_cast<int>(protocol) << " over down interface " << ifIndex;
+  }
+}
+
+void
+NetlinkFibHandler::updateRouteCache(fbnl::Route&& route) {
+  if (route.getRouteTable() != RT_TABLE_MAIN) {
+    return; // Only main table is programmed
+  }
+
+  // NOTE: Old kernels notify IPv6 multipath routes per next-hop. Cached route
+  // then differs from the programmed one and gets re-programmed on next sync.
+  auto cache = routeCache_.wlock();
+  auto it = cache->find(route.getProtocolId());
+  if (it == cache->end()) {
+    return; // Protocol is not synced yet
+  }
+  if (route.getFamily() == AF_MPLS) {
+    auto& routes = it->second.mpls.routes;
+    const int32_t topLabel = route.getMplsLabel().value();
+    if (route.isValid()) {
+      routes.insert_or_assign(topLabel, std::move(route));
+    } else {
+      routes.erase(topLabel);
+    }
+  } else {
+    auto& routes = it->second.unicast.routes;
+    const auto prefix = route.getDestination();
+    if (route.isValid()) {
+      routes.insert_or_assign(prefix, std::move(route));
+    } else {
+      routes.erase(prefix);
+    }
+  }
+}
+
+void
+NetlinkFibHandler::refreshUnicastRouteCache(uint8_t protocol) {
+  if (not routeCache_.withRLock([&](auto& cache) {
+        auto it = cache.find(protocol);
+        return it == cache.end() or isAuditDue(it->second.unicast);
+      })) {
+    return;
+  }
+
+  // NOTE: Synchronous call to retrieve all the routes. We first make both
+  // requests to retrieve IPv4 and IPv6 routes. Subsequently we wait on them
+  // to complete and prepare the map of existing routes
+  std::unordered_map<folly::CIDRNetwork, fbnl::Route> kernelRoutes;
+  {
+    auto v4Routes = nlSock_->getIPv4Routes(protocol).get();
+    auto v6Routes = nlSock_->getIPv6Routes(protocol).get();
+    if (v4Routes.hasError()) {
+      throw fbnl::NlException("Failed fetching IPv4 routes", v4Routes.error());
+    }
+    if (v6Routes.hasError()) {
+      throw fbnl::NlException("Failed fetching IPv6 routes", v6Routes.error());
+    }
+    for (auto& route : std::move(v4Routes).value()) {
+      const auto prefix = route.getDestination();
+      kernelRoutes.emplace(prefix, std::move(route));
+    }
+    for (auto& route : std::move(v6Routes).value()) {
+      const auto prefix = route.getDestination();
+      kernelRoutes.emplace(prefix, std::move(route));
+    }
+  }
+
+  auto cache = routeCache_.wlock();
+  auto& cachedRoutes = (*cache)[protocol].unicast;
+  if (cachedRoutes.auditTs.has_value()) {
+    auto numMismatched =
+        getNumMismatchedRoutes(cachedRoutes.routes, kernelRoutes);
+    LOG_IF(WARNING, numMismatched)
+        << "Unicast route cache of protocol " << static_cast<int>(protocol)
+        << " mismatched with kernel for " << numMismatched << " routes";
+  }
+  cachedRoutes.routes = std::move(kernelRoutes);
+  cachedRoutes.auditTs = std::chrono::steady_clock::now();
+}
+
+void
+NetlinkFibHandler::refreshMplsRouteCache(uint8_t protocol) {
+  if (not routeCache_.withRLock([&](auto& cache) {
+        auto it = cache.find(protocol);
+        return it == cache.end() or isAuditDue(it->second.mpls);
+      })) {
+    return;
+  }
 
-  // Create set of existing route
   // NOTE: Synchronous call to retrieve all the routes
-  std::unordered_map<int32_t, fbnl::Route> existingRoutes;
-  auto nlRoutes = nlSock_->getMplsRoutes(protocol.value()).get();
+  std::unordered_map<int32_t, fbnl::Route> kernelRoutes;
+  auto nlRoutes = nlSock_->getMplsRoutes(protocol).get();
   if (nlRoutes.hasError()) {
-    throw fbnl::NlException("Failed fetching IPv6 routes", nlRoutes.error());
+    throw fbnl::NlException("Failed fetching MPLS routes", nlRoutes.error());
   }
   for (auto& route : std::move(nlRoutes).value()) {
     const auto topLabel = route.getMplsLabel().value();
-    existingRoutes.emplace(topLabel, std::move(route));
-  }
-
-  // Go over the new routes. Add or update
-  std::unordered_set<uint32_t> newLabels;
-  for (auto& route : *mplsRoutes) {
-    newLabels.insert(route.topLabel);
-    auto nlRoute = buildMplsRoute(route, protocol.value());
-    auto it = existingRoutes.find(route.topLabel);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
-      // Existing route is same as the one we're trying to add. SKIP
-      continue;
-    }
-    // Add new route or replace existing one
-    result.emplace_back(nlSock_->addRoute(nlRoute));
+    kernelRoutes.emplace(topLabel, std::move(route));
   }
 
-  // Go over the old routes to remove stale ones
-  for (auto& [topLabel, nlRoute] : existingRoutes) {
-    if (newLabels.count(topLabel)) {
-      // not a stale route
-      continue;
-    }
-    // Delete stale route
-    result.emplace_back(nlSock_->deleteRoute(nlRoute));
+  auto cache = routeCache_.wlock();
+  auto& cachedRoutes = (*cache)[protocol].mpls;
+  if (cachedRoutes.auditTs.has_value()) {
+    auto numMismatched =
+        getNumMismatchedRoutes(cachedRoutes.routes, kernelRoutes);
+    LOG_IF(WARNING, numMismatched)
+        << "MPLS route cache of protocol " << static_cast<int>(protocol)
+        << " mismatched with kernel for " << numMismatched << " routes";
   }
-
-  // Return collected result
-  return collectAllResult(std::move(result), {EEXIST, ESRCH});
+  cachedRoutes.routes = std::move(kernelRoutes);
+  cachedRoutes.auditTs = std::chrono::steady_clock::now();
 }
 
 int64_t
@@ -10,15 +10,19 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <fb303/BaseService.h>
 #include <fbzmq/async/ZmqTimeout.h>
 #include <folly/Expected.h>
+#include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/AsyncSocket.h>
 
+#include <openr/common/Constants.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
 #include <openr/if/gen-cpp2/FibService.h>
@@ -36,11 +40,19 @@ namespace openr {
  * - Translates netlink representation of routes to thrift for get* queries
  * - All APIs exposed are asynchronous. Sync API retries the existing routing
  *   state in synchronous way and program changes asynchrnously.
+ * - Existing routing state is served from a cache of kernel routes, kept up to
+ *   date with route events. As kernel doesn't notify every removal of IPv4
+ *   routes of an interface going down, cached routes over it are dropped on
+ *   link down. Cache is refreshed from kernel on first sync of a client and
+ *   on periodic audit for any other drift.
  */
 class NetlinkFibHandler : public thrift::FibServiceSvIf,
                           public facebook::fb303::BaseService {
  public:
-  explicit NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock);
+  explicit NetlinkFibHandler(
+      fbnl::NetlinkProtocolSocket* nlSock,
+      std::chrono::seconds routeCacheAuditInterval =
+          Constants::kPlatformRouteCacheAuditInterval);
   ~NetlinkFibHandler() override;
 
   void
@@ -112,11 +124,12 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf,
   static uint8_t protocolToPriority(const uint8_t protocol);
 
   /**
-   * Convert list<SemiFuture<int>> to SemiFuture<Unit>
+   * Convert errors of route batch requests to SemiFuture<Unit>
    * The first error if any will be converted to NlException
    */
   static folly::SemiFuture<folly::Unit> collectAllResult(
-      std::vector<folly::SemiFuture<int>>&& result,
+      std::vector<folly::SemiFuture<fbnl::NetlinkRouteBatchMessage::Errors>>&&
+          result,
       std::set<int> errorsToIgnore);
 
  protected:
@@ -197,6 +210,32 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf,
    */
   void initializeInterfaceCache() noexcept;
 
+  /**
+   * Update route cache with route event from kernel. Routes of protocols which
+   * are not synced yet are ignored.
+   */
+  void updateRouteCache(fbnl::Route&& route);
+
+  /**
+   * Mark cached routes of all protocols for refresh from kernel on next sync.
+   * Used when route events may have been lost.
+   */
+  void invalidateRouteCache();
+
+  /**
+   * Drop cached routes of all protocols with a next-hop over interface going
+   * down. Kernel flushes such routes without notifying all of them.
+   */
+  void invalidateRouteCache(int ifIndex);
+
+  /**
+   * Dump routes of protocol from kernel and replace cached ones if cache is
+   * not initialized or audit is due. Reports mismatch between cached and
+   * kernel routes on audit.
+   */
+  void refreshUnicastRouteCache(uint8_t protocol);
+  void refreshMplsRouteCache(uint8_t protocol);
+
   // Cache for interface index <-> name mapping
   folly::Synchronized<std::unordered_map<std::string, int>> ifNameToIndex_;
   folly::Synchronized<std::unordered_map<int, std::string>> ifIndexToName_;
@@ -204,6 +243,30 @@ class NetlinkFibHandler : public thrift::FibServiceSvIf,
   // Loopback interface index cache. Initialized to negative number
   std::atomic<int> loopbackIfIndex_{-1};
 
+  // Routes of a protocol in kernel, keyed by prefix or label, and last time
+  // when they were refreshed from kernel
+  template <typename K>
+  struct CachedRoutes {
+    std::unordered_map<K, fbnl::Route> routes;
+    std::optional<std::chrono::steady_clock::time_point> auditTs;
+  };
+
+  struct RouteCache {
+    CachedRoutes<folly::CIDRNetwork> unicast;
+    CachedRoutes<int32_t> mpls;
+  };
+
+  // Whether cached routes needs to be refreshed from kernel
+  template <typename K>
+  bool isAuditDue(const CachedRoutes<K>& cachedRoutes) const;
+
+  // Cache of kernel routes per protocol. Updated from event base thread of
+  // netlink socket and read by sync APIs
+  folly::Synchronized<std::unordered_map<uint8_t, RouteCache>> routeCache_;
+
+  // Interval for auditing route cache against kernel routes
+  const std::chrono::seconds routeCacheAuditInterval_;
+
   // Time when service started, in number of seconds, since epoch
   const int64_t startTime_{0};
 };
@@ -15,6 +15,7 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/Random.h>
+#include <folly/Subprocess.h>
 #include <folly/gen/Base.h>
 #include <folly/init/Init.h>
 #include <folly/io/async/EventBase.h>
@@ -40,6 +41,11 @@ const uint8_t kNumOfNexthops = 128;
 
 const int16_t kFibId{static_cast<int16_t>(openr::thrift::FibClient::OPENR)};
 
+// Protocol of routes programmed in kernel
+const uint8_t kRouteProtoId{99};
+// Nexthop of routes programmed in kernel
+const folly::IPAddress kNextHopV6{"fe80::2"};
+
 } // namespace
 
 namespace openr {
@@ -107,12 +113,157 @@ BM_NetlinkFibHandler(uint32_t iters, size_t numOfPrefixes) {
   }
 }
 
+// This class creates a veth pair and a real NetlinkProtocolSocket to program
+// routes in kernel. Requires root privileges.
+class NetlinkSocketWrapper {
+ public:
+  NetlinkSocketWrapper() {
+    runCmd("ip link del {} 2>/dev/null"_shellify(kVethNameX.c_str()));
+    runCmd("ip link add {} type veth peer name {}"_shellify(
+        kVethNameX.c_str(), kVethNameY.c_str()));
+    runCmd("ip link set dev {} up"_shellify(kVethNameX.c_str()));
+    runCmd("ip link set dev {} up"_shellify(kVethNameY.c_str()));
+
+    nlSock = std::make_unique<NetlinkProtocolSocket>(&evb);
+    eventThread = std::thread([&]() { evb.loopForever(); });
+    evb.waitUntilRunning();
+
+    for (auto const& link : nlSock->getAllLinks().get().value()) {
+      if (link.getLinkName() == kVethNameY) {
+        ifIndex = link.getIfIndex();
+      }
+    }
+    CHECK_NE(0, ifIndex);
+  }
+
+  ~NetlinkSocketWrapper() {
+    runCmd("ip link del {} 2>/dev/null"_shellify(kVethNameX.c_str()));
+    evb.terminateLoopSoon();
+    eventThread.join();
+    nlSock.reset();
+  }
+
+  static void
+  runCmd(std::vector<std::string> cmd) {
+    folly::Subprocess proc(std::move(cmd));
+    proc.wait();
+  }
+
+  std::vector<fbnl::Route>
+  buildRoutes(size_t numOfPrefixes) const {
+    std::vector<fbnl::Route> routes;
+    for (auto const& prefix :
+         PrefixGenerator::ipv6PrefixGenerator(numOfPrefixes, kBitMaskLen)) {
+      fbnl::NextHopBuilder nhBuilder;
+      nhBuilder.setGateway(kNextHopV6).setIfIndex(ifIndex);
+      fbnl::RouteBuilder rtBuilder;
+      rtBuilder.setDestination(toIPNetwork(prefix))
+          .setProtocolId(kRouteProtoId)
+          .addNextHop(nhBuilder.build());
+      routes.emplace_back(rtBuilder.build());
+    }
+    return routes;
+  }
+
+  folly::EventBase evb;
+  std::thread eventThread;
+  std::unique_ptr<NetlinkProtocolSocket> nlSock;
+  int ifIndex{0};
+};
+
+/**
+ * Benchmark adding routes in kernel with a request (and future) per route
+ * vs batch request
+ * 1. Create veth interfaces and a NetlinkProtocolSocket
+ * 2. Generate random IPv6 routes
+ * 3. Add routes and wait for completion
+ * 4. Delete routes (not measured)
+ */
+static void
+benchmarkKernelRoutes(uint32_t iters, size_t numOfPrefixes, bool batch) {
+  auto suspender = folly::BenchmarkSuspender();
+  if (getuid()) {
+    LOG(ERROR) << "Must run as root for programming routes in kernel";
+    return;
+  }
+  auto wrapper = std::make_unique<NetlinkSocketWrapper>();
+  auto const routes = wrapper->buildRoutes(numOfPrefixes);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    suspender.dismiss(); // Start measuring benchmark time
+    if (batch) {
+      CHECK(wrapper->nlSock->addRoutes(routes).get().empty());
+    } else {
+      std::vector<folly::SemiFuture<int>> futures;
+      for (auto const& route : routes) {
+        futures.emplace_back(wrapper->nlSock->addRoute(route));
+      }
+      CHECK_EQ(
+          0,
+          NetlinkProtocolSocket::collectReturnStatus(std::move(futures)).get());
+    }
+    suspender.rehire(); // Stop measuring time again
+
+    CHECK(wrapper->nlSock->deleteRoutes(routes).get().empty());
+  }
+}
+
+static void
+BM_NetlinkKernelAddRoute(uint32_t iters, size_t numOfPrefixes) {
+  benchmarkKernelRoutes(iters, numOfPrefixes, false /* batch */);
+}
+
+static void
+BM_NetlinkKernelAddRoutesBatch(uint32_t iters, size_t numOfPrefixes) {
+  benchmarkKernelRoutes(iters, numOfPrefixes, true /* batch */);
+}
+
+/**
+ * Benchmark dumping routes of a protocol from kernel, as done on FIB sync
+ * 1. Create veth interfaces and a NetlinkProtocolSocket
+ * 2. Add random IPv6 routes in kernel (not measured)
+ * 3. Get routes of the protocol and wait for completion
+ * 4. Delete routes (not measured)
+ */
+static void
+BM_NetlinkKernelGetRoutes(uint32_t iters, size_t numOfPrefixes) {
+  auto suspender = folly::BenchmarkSuspender();
+  if (getuid()) {
+    LOG(ERROR) << "Must run as root for programming routes in kernel";
+    return;
+  }
+  auto wrapper = std::make_unique<NetlinkSocketWrapper>();
+  auto const routes = wrapper->buildRoutes(numOfPrefixes);
+  CHECK(wrapper->nlSock->addRoutes(routes).get().empty());
+
+  for (uint32_t i = 0; i < iters; i++) {
+    suspender.dismiss(); // Start measuring benchmark time
+    auto kernelRoutes =
+        wrapper->nlSock->getIPv6Routes(kRouteProtoId).get().value();
+    suspender.rehire(); // Stop measuring time again
+    CHECK_EQ(numOfPrefixes, kernelRoutes.size());
+  }
+
+  CHECK(wrapper->nlSock->deleteRoutes(routes).get().empty());
+}
+
 // The parameter is the number of prefixes
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 10);
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 100);
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 1000);
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 10000);
 
+// The parameter is the number of routes programmed in kernel
+BENCHMARK_PARAM(BM_NetlinkKernelAddRoute, 1000);
+BENCHMARK_PARAM(BM_NetlinkKernelAddRoute, 10000);
+BENCHMARK_PARAM(BM_NetlinkKernelAddRoute, 100000);
+BENCHMARK_PARAM(BM_NetlinkKernelAddRoutesBatch, 1000);
+BENCHMARK_PARAM(BM_NetlinkKernelAddRoutesBatch, 10000);
+BENCHMARK_PARAM(BM_NetlinkKernelAddRoutesBatch, 100000);
+BENCHMARK_PARAM(BM_NetlinkKernelGetRoutes, 1000);
+BENCHMARK_PARAM(BM_NetlinkKernelGetRoutes, 10000);
+BENCHMARK_PARAM(BM_NetlinkKernelGetRoutes, 100000);
+
 } // namespace openr
 
 int
@@ -409,6 +409,135 @@ TEST_P(FibHandlerFixture, UnicastSync) {
   EXPECT_EQ(rts, *routes);
 }
 
+//
+// Test that sync is served from route cache. Kernel routes are dumped only on
+// first sync and on audit, and out of band changes are learnt via route events
+//
+TEST(NetlinkFibHandler, UnicastSyncFromRouteCache) {
+  const int16_t kClientId = 786;
+  folly::EventBase evb;
+  fbnl::MockNetlinkProtocolSocket nlSock(&evb);
+  NetlinkFibHandler handler(&nlSock);
+
+  // First sync dumps IPv4 and IPv6 routes
+  auto rts = createUnicastRoutes(4, true /* isV4 */);
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(2, nlSock.getNumGetRoutes());
+
+  // Subsequent sync is served from cache
+  rts = createUnicastRoutes(6, true /* isV4 */);
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(2, nlSock.getNumGetRoutes());
+
+  // Delete route out of band. Cache learns it from route event and next sync
+  // adds it back
+  fbnl::RouteBuilder builder;
+  builder.setDestination(toIPNetwork(rts.at(0).dest)).setProtocolId(99);
+  EXPECT_EQ(0, nlSock.deleteRoute(builder.build()).get());
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(2, nlSock.getNumGetRoutes());
+
+  auto routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(6, routes->size());
+  sortNextHops(*routes);
+  EXPECT_EQ(rts, *routes);
+
+  // Delete route out of band while route events are lost. Once overrun is
+  // reported, next sync dumps routes again and adds the route back
+  nlSock.setRouteEventsLost(true);
+  EXPECT_EQ(0, nlSock.deleteRoute(builder.build()).get());
+  nlSock.setRouteEventsLost(false);
+  auto const numGetRoutes = nlSock.getNumGetRoutes();
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(numGetRoutes + 2, nlSock.getNumGetRoutes());
+  routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(6, routes->size());
+  sortNextHops(*routes);
+  EXPECT_EQ(rts, *routes);
+
+  // Route cache is audited on every sync with zero audit interval
+  fbnl::MockNetlinkProtocolSocket auditNlSock(&evb);
+  NetlinkFibHandler auditHandler(&auditNlSock, std::chrono::seconds(0));
+  for (int i = 0; i < 3; ++i) {
+    auditHandler
+        .semifuture_syncFib(
+            kClientId,
+            std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+        .get();
+  }
+  EXPECT_EQ(6, auditNlSock.getNumGetRoutes());
+}
+
+//
+// Test that cached routes over interface going down are dropped. Kernel
+// flushes IPv4 routes over down link silently and next sync adds them back
+//
+TEST(NetlinkFibHandler, UnicastSyncAfterLinkDown) {
+  const int16_t kClientId = 786;
+  folly::EventBase evb;
+  fbnl::MockNetlinkProtocolSocket nlSock(&evb);
+  for (size_t i = 0; i < kInterfaces.size(); ++i) {
+    ASSERT_EQ(
+        0,
+        nlSock
+            .addLink(
+                fbnl::utils::createLink(i + 1, kInterfaces.at(i), true, false))
+            .get());
+  }
+  NetlinkFibHandler handler(&nlSock);
+
+  // Route over eth0 and route over eth1
+  auto rts = createUnicastRoutes(2, true /* isV4 */);
+  for (size_t i = 0; i < rts.size(); ++i) {
+    rts.at(i).nextHops = {createNextHop(i, true /* isV4 */)};
+    rts.at(i).nextHops.at(0).address.ifName_ref() = kInterfaces.at(i);
+  }
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  auto const numGetRoutes = nlSock.getNumGetRoutes();
+
+  // eth0 goes down and up. Its route is flushed from kernel and cache
+  ASSERT_EQ(
+      0,
+      nlSock
+          .addLink(fbnl::utils::createLink(1, kInterfaces.at(0), false, false))
+          .get());
+  ASSERT_EQ(
+      0,
+      nlSock
+          .addLink(fbnl::utils::createLink(1, kInterfaces.at(0), true, false))
+          .get());
+  auto routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(1, routes->size());
+  EXPECT_EQ(rts.at(1), routes->at(0));
+
+  // Next sync programs flushed route again without dumping routes
+  handler
+      .semifuture_syncFib(
+          kClientId, std::make_unique<std::vector<thrift::UnicastRoute>>(rts))
+      .get();
+  EXPECT_EQ(numGetRoutes, nlSock.getNumGetRoutes());
+  routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+  ASSERT_EQ(2, routes->size());
+  std::sort(routes->begin(), routes->end());
+  std::sort(rts.begin(), rts.end());
+  EXPECT_EQ(rts, *routes);
+}
+
 //
 // Test correctness of multiple client support. Incrementally add and remove
 // route for same prefix1 from client1 and client2. Verify that addition or
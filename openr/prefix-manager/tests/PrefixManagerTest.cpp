@@ -1310,10 +1310,10 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteUpdates) {
     expected.emplace(keyStrB, expectedPrefixEntry1A);
     expected.emplace(keyStrC, expectedPrefixEntry1A);
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
-    auto pub2 = kvStoreUpdatesQueue.get().value();
+    auto pub2 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub2, got, gotDeleted);
 
     EXPECT_EQ(expected, got);
@@ -1344,13 +1344,13 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteUpdates) {
     expected.emplace(keyStrA, expectedPrefixEntry1B);
     expected.emplace(keyStrC, expectedPrefixEntry1B);
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
-    auto pub2 = kvStoreUpdatesQueue.get().value();
+    auto pub2 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub2, got, gotDeleted);
 
-    auto pub3 = kvStoreUpdatesQueue.get().value();
+    auto pub3 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub3, got, gotDeleted);
 
     EXPECT_EQ(expected, got);
@@ -1369,10 +1369,10 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteUpdates) {
 
     std::map<std::string, thrift::PrefixEntry> got, gotDeleted;
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
-    auto pub2 = kvStoreUpdatesQueue.get().value();
+    auto pub2 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub2, got, gotDeleted);
 
     EXPECT_EQ(0, got.size());
@@ -1431,7 +1431,7 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
     std::map<std::string, thrift::PrefixEntry> expected, got, gotDeleted;
     expected.emplace(keyStrC, expectedPrefixEntry1A);
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
     EXPECT_EQ(expected, got);
@@ -1451,7 +1451,7 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
 
     std::map<std::string, thrift::PrefixEntry> got, gotDeleted;
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
     EXPECT_EQ(0, got.size());
@@ -1472,7 +1472,7 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
     std::map<std::string, thrift::PrefixEntry> expected, got, gotDeleted;
     expected.emplace(keyStrB, expectedPrefixEntry1A);
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
     EXPECT_EQ(expected, got);
@@ -1508,7 +1508,7 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
     // here skip ttl updates
     int expectedPubCnt{3}, gotPubCnt{0};
     while (gotPubCnt < expectedPubCnt) {
-      auto pub = kvStoreUpdatesQueue.get().value();
+      auto pub = *kvStoreUpdatesQueue.get().value();
       gotPubCnt += readPublication(pub, got, gotDeleted);
     }
 
@@ -1529,10 +1529,10 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
 
     std::map<std::string, thrift::PrefixEntry> got, gotDeleted;
 
-    auto pub1 = kvStoreUpdatesQueue.get().value();
+    auto pub1 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub1, got, gotDeleted);
 
-    auto pub2 = kvStoreUpdatesQueue.get().value();
+    auto pub2 = *kvStoreUpdatesQueue.get().value();
     readPublication(pub2, got, gotDeleted);
 
     EXPECT_EQ(0, got.size());
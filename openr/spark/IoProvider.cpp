@@ -12,86 +12,30 @@
 #include <folly/SocketAddress.h>
 #include <openr/spark/IoProvider.h>
 
-namespace openr {
-
-int
-IoProvider::socket(int domain, int type, int protocol) {
-  return ::socket(domain, type, protocol);
-}
-
-int
-IoProvider::fcntl(int fd, int cmd, int arg) {
-  return ::fcntl(fd, cmd, arg);
-}
-
-int
-IoProvider::bind(
-    int sockfd, const struct sockaddr* my_addr, socklen_t addrlen) {
-  return ::bind(sockfd, my_addr, addrlen);
-}
-
-ssize_t
-IoProvider::recvfrom(
-    int sockfd,
-    void* buf,
-    size_t len,
-    int flags,
-    struct sockaddr* src_addr,
-    socklen_t* addrlen) {
-  return ::recvfrom(sockfd, buf, len, flags, src_addr, addrlen);
-}
-
-ssize_t
-IoProvider::sendto(
-    int sockfd,
-    const void* buf,
-    size_t len,
-    int flags,
-    const struct sockaddr* dest_addr,
-    socklen_t addrlen) {
-  return ::sendto(sockfd, buf, len, flags, dest_addr, addrlen);
-}
-
-int
-IoProvider::setsockopt(
-    int sockfd, int level, int optname, const void* optval, socklen_t optlen) {
-  return ::setsockopt(sockfd, level, optname, optval, optlen);
-}
-
-ssize_t
-IoProvider::recvmsg(int sockfd, struct msghdr* msg, int flags) {
-  return ::recvmsg(sockfd, msg, flags);
-}
-
-ssize_t
-IoProvider::sendmsg(int sockfd, const struct msghdr* msg, int flags) {
-  return ::sendmsg(sockfd, msg, flags);
-}
-
-std::tuple<
-    ssize_t /* size */,
-    int /* ifIndex */,
-    folly::SocketAddress /* srcAddr */,
-    int /* hopLimit */,
-    std::chrono::microseconds /* kernel timestamp */>
-IoProvider::recvMessage(
-    int fd, unsigned char* buf, int len, openr::IoProvider* ioProvider) {
-  // the control message buffer
-  // XXX: hardcoded, but this hardly should be a problem
-  union {
-    char ctrlBuf[CMSG_SPACE(1024)];
-    struct cmsghdr align;
-  } u;
-
-  // the message header to receive into
-  struct msghdr msg;
-
-  // the IO vector for data to be received with recvmsg
-  struct iovec entry;
-
-  // for address of the sender
-  sockaddr_storage addrStorage;
-
+namespace {
+
+// the control message buffer for receiving ifIndex, hop limit and timestamp
+// XXX: hardcoded, but this hardly should be a problem
+union RecvCtrlBuf {
+  char ctrlBuf[CMSG_SPACE(1024)];
+  struct cmsghdr align;
+};
+
+// the control message buffer for setting source address and ifIndex
+union SendCtrlBuf {
+  char cbuf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+  struct cmsghdr align;
+};
+
+// Prepare message header to receive a single block of data into buf
+void
+prepareRecvMsg(
+    struct msghdr& msg,
+    struct iovec& entry,
+    sockaddr_storage& addrStorage,
+    RecvCtrlBuf& u,
+    unsigned char* buf,
+    int len) {
   ::memset(&msg, 0, sizeof(msg));
 
   // we only expect to receive one block of data, single entry
@@ -116,28 +60,21 @@ IoProvider::recvMessage(
   // write the data here
   entry.iov_base = buf;
   entry.iov_len = len;
+}
 
-  ssize_t bytesRead = ioProvider->recvmsg(fd, &msg, MSG_DONTWAIT);
-
-  if (bytesRead < 0) {
-    throw std::runtime_error(folly::sformat(
-        "Failed reading message on fd {}: {}", fd, folly::errnoStr(errno)));
-  }
-
-  if (msg.msg_flags & MSG_TRUNC) {
-    throw std::runtime_error("Message truncated");
-  }
+// Read ifIndex, hop limit, kernel timestamp and sender address of received
+// message
+openr::IoProvider::RecvMessage
+parseRecvMsg(struct msghdr& msg, sockaddr_storage& addrStorage) {
+  openr::IoProvider::RecvMessage recvMsg;
 
   // grab the inIndex we received this packet on and the hopLimit
   // those are available since we requested them via socket options
   struct cmsghdr* cmsg{nullptr};
-  int ifIndex{-1};
-  int hopLimit{0};
 
   // use user space timestamp if kernel timestamp is not found
-  std::chrono::microseconds recvTs{
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::system_clock::now().time_since_epoch())};
+  recvMsg.recvTs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch());
 
   for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
     if (cmsg->cmsg_level == IPPROTO_IPV6) {
@@ -147,12 +84,12 @@ IoProvider::recvMessage(
             reinterpret_cast<void*>(&pktinfo),
             CMSG_DATA(cmsg),
             sizeof(pktinfo));
-        ifIndex = pktinfo.ipi6_ifindex;
+        recvMsg.ifIndex = pktinfo.ipi6_ifindex;
       } else if (cmsg->cmsg_type == IPV6_HOPLIMIT) {
         memcpy(
-            reinterpret_cast<void*>(&hopLimit),
+            reinterpret_cast<void*>(&recvMsg.hopLimit),
             CMSG_DATA(cmsg),
-            sizeof(hopLimit));
+            sizeof(recvMsg.hopLimit));
       }
     }
     if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPNS) {
@@ -167,44 +104,37 @@ IoProvider::recvMessage(
       const std::chrono::microseconds kernelRecvTs(usecs);
 
       // sanity check
-      DCHECK(recvTs >= kernelRecvTs) << "Time anomaly";
+      DCHECK(recvMsg.recvTs >= kernelRecvTs) << "Time anomaly";
       VLOG(4) << "Got kernel-timestamp. It took "
-              << (recvTs - kernelRecvTs).count()
+              << (recvMsg.recvTs - kernelRecvTs).count()
               << " us for the packet to get from kernel to user space";
-      recvTs = kernelRecvTs;
+      recvMsg.recvTs = kernelRecvTs;
     }
   } // for
 
   // build the source socket address from recvmsg data
-  folly::SocketAddress srcAddr{};
   // this will throw if sender address was not filled in
-  srcAddr.setFromSockaddr(reinterpret_cast<struct sockaddr*>(&addrStorage));
+  recvMsg.srcAddr.setFromSockaddr(
+      reinterpret_cast<struct sockaddr*>(&addrStorage));
 
-  DCHECK(ifIndex != -1) << "ifIndex is not found";
-  DCHECK(hopLimit) << "hopLimit is not found";
+  DCHECK(recvMsg.ifIndex != -1) << "ifIndex is not found";
+  DCHECK(recvMsg.hopLimit) << "hopLimit is not found";
 
-  return std::make_tuple(bytesRead, ifIndex, srcAddr, hopLimit, recvTs);
+  return recvMsg;
 }
 
-ssize_t
-IoProvider::sendMessage(
-    int fd,
+// Prepare message header to send packet via given interface to dstAddr
+void
+prepareSendMsg(
+    struct msghdr& msg,
+    struct iovec& entry,
+    sockaddr_storage& addrStorage,
+    SendCtrlBuf& u,
     int ifIndex,
-    folly::IPAddressV6 srcAddr,
-    folly::SocketAddress dstAddr,
-    std::string const& packet,
-    IoProvider* ioProvider) {
-  struct msghdr msg;
-  struct cmsghdr* cmsg{nullptr};
-
-  // pack control buffer, aligned by control message hdr
-  union {
-    char cbuf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
-    struct cmsghdr align;
-  } u;
-
+    folly::IPAddressV6 const& srcAddr,
+    folly::SocketAddress const& dstAddr,
+    std::string const& packet) {
   // Set the destination address for the message
-  sockaddr_storage addrStorage;
   dstAddr.getAddress(&addrStorage);
 
   ::memset(&msg, 0, sizeof(msg));
@@ -215,7 +145,7 @@ IoProvider::sendMessage(
   // this goes into ancilliary data fields
   msg.msg_control = u.cbuf;
   msg.msg_controllen = sizeof(u.cbuf);
-  cmsg = CMSG_FIRSTHDR(&msg);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
 
   cmsg->cmsg_level = IPPROTO_IPV6;
   cmsg->cmsg_type = IPV6_PKTINFO;
@@ -226,15 +156,186 @@ IoProvider::sendMessage(
   ::memcpy(&pktinfo->ipi6_addr, srcAddr.bytes(), srcAddr.byteCount());
 
   // the IO vector for data to be sent
-  struct iovec entry;
   msg.msg_iov = &entry;
   msg.msg_iovlen = 1;
 
   // write the data here (we need to remove the const qualifier)
   entry.iov_base = const_cast<char*>(packet.data());
   entry.iov_len = packet.size();
+}
+
+} // namespace
+
+namespace openr {
+
+int
+IoProvider::socket(int domain, int type, int protocol) {
+  return ::socket(domain, type, protocol);
+}
+
+int
+IoProvider::fcntl(int fd, int cmd, int arg) {
+  return ::fcntl(fd, cmd, arg);
+}
+
+int
+IoProvider::bind(
+    int sockfd, const struct sockaddr* my_addr, socklen_t addrlen) {
+  return ::bind(sockfd, my_addr, addrlen);
+}
+
+ssize_t
+IoProvider::recvfrom(
+    int sockfd,
+    void* buf,
+    size_t len,
+    int flags,
+    struct sockaddr* src_addr,
+    socklen_t* addrlen) {
+  return ::recvfrom(sockfd, buf, len, flags, src_addr, addrlen);
+}
+
+ssize_t
+IoProvider::sendto(
+    int sockfd,
+    const void* buf,
+    size_t len,
+    int flags,
+    const struct sockaddr* dest_addr,
+    socklen_t addrlen) {
+  return ::sendto(sockfd, buf, len, flags, dest_addr, addrlen);
+}
+
+int
+IoProvider::setsockopt(
+    int sockfd, int level, int optname, const void* optval, socklen_t optlen) {
+  return ::setsockopt(sockfd, level, optname, optval, optlen);
+}
+
+ssize_t
+IoProvider::recvmsg(int sockfd, struct msghdr* msg, int flags) {
+  return ::recvmsg(sockfd, msg, flags);
+}
+
+ssize_t
+IoProvider::sendmsg(int sockfd, const struct msghdr* msg, int flags) {
+  return ::sendmsg(sockfd, msg, flags);
+}
+
+int
+IoProvider::recvmmsg(
+    int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  return ::recvmmsg(sockfd, msgvec, vlen, flags, nullptr /* timeout */);
+}
+
+int
+IoProvider::sendmmsg(
+    int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  return ::sendmmsg(sockfd, msgvec, vlen, flags);
+}
+
+std::vector<IoProvider::RecvMessage>
+IoProvider::recvMessages(
+    int fd,
+    unsigned char* buf,
+    int len,
+    unsigned int numMsgs,
+    IoProvider* ioProvider) {
+  std::vector<RecvCtrlBuf> ctrlBufs(numMsgs);
+  std::vector<struct mmsghdr> msgs(numMsgs);
+  std::vector<struct iovec> entries(numMsgs);
+  std::vector<sockaddr_storage> addrStorages(numMsgs);
+  for (unsigned int i = 0; i < numMsgs; ++i) {
+    ::memset(&msgs[i], 0, sizeof(msgs[i]));
+    prepareRecvMsg(
+        msgs[i].msg_hdr,
+        entries[i],
+        addrStorages[i],
+        ctrlBufs[i],
+        buf + i * len,
+        len);
+  }
+
+  std::vector<RecvMessage> recvMsgs;
+  int numRead = ioProvider->recvmmsg(fd, msgs.data(), numMsgs, MSG_DONTWAIT);
+  if (numRead < 0) {
+    if (errno == EAGAIN or errno == EWOULDBLOCK) {
+      return recvMsgs; // nothing to read
+    }
+    throw std::runtime_error(folly::sformat(
+        "Failed reading messages on fd {}: {}", fd, folly::errnoStr(errno)));
+  }
+
+  recvMsgs.reserve(numRead);
+  for (int i = 0; i < numRead; ++i) {
+    auto& msg = msgs[i].msg_hdr;
+    if (msg.msg_flags & MSG_TRUNC) {
+      LOG(ERROR) << "Message truncated on fd " << fd << ". Dropping it";
+      continue;
+    }
+    recvMsgs.emplace_back(parseRecvMsg(msg, addrStorages[i]));
+    recvMsgs.back().data = folly::ByteRange(buf + i * len, msgs[i].msg_len);
+  }
+  return recvMsgs;
+}
+
+ssize_t
+IoProvider::sendMessage(
+    int fd,
+    int ifIndex,
+    folly::IPAddressV6 srcAddr,
+    folly::SocketAddress dstAddr,
+    std::string const& packet,
+    IoProvider* ioProvider) {
+  struct msghdr msg;
+  SendCtrlBuf u;
+  sockaddr_storage addrStorage;
+  struct iovec entry;
+
+  prepareSendMsg(msg, entry, addrStorage, u, ifIndex, srcAddr, dstAddr, packet);
 
   return ioProvider->sendmsg(fd, &msg, MSG_DONTWAIT);
 }
 
+std::vector<ssize_t>
+IoProvider::sendMessages(
+    int fd, std::vector<SendMessage> const& msgs, IoProvider* ioProvider) {
+  const size_t numMsgs = msgs.size();
+  std::vector<SendCtrlBuf> ctrlBufs(numMsgs);
+  std::vector<struct mmsghdr> hdrs(numMsgs);
+  std::vector<struct iovec> entries(numMsgs);
+  std::vector<sockaddr_storage> addrStorages(numMsgs);
+  for (size_t i = 0; i < numMsgs; ++i) {
+    auto const& msg = msgs[i];
+    hdrs[i].msg_len = 0;
+    prepareSendMsg(
+        hdrs[i].msg_hdr,
+        entries[i],
+        addrStorages[i],
+        ctrlBufs[i],
+        msg.ifIndex,
+        msg.srcAddr,
+        msg.dstAddr,
+        msg.packet);
+  }
+
+  // sendmmsg stops at first message which fails. Skip it and send the rest
+  std::vector<ssize_t> bytesSent(numMsgs, -1);
+  size_t offset{0};
+  while (offset < numMsgs) {
+    int numSent = ioProvider->sendmmsg(
+        fd, hdrs.data() + offset, numMsgs - offset, MSG_DONTWAIT);
+    if (numSent <= 0) {
+      VLOG(1) << "Failed sending message on fd " << fd << " via ifIndex "
+              << msgs[offset].ifIndex << ": " << folly::errnoStr(errno);
+      ++offset;
+      continue;
+    }
+    for (int i = 0; i < numSent; ++i, ++offset) {
+      bytesSent[offset] = hdrs[offset].msg_len;
+    }
+  }
+  return bytesSent;
+}
+
 } // namespace openr
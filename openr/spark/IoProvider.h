@@ -13,8 +13,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <chrono>
+#include <string>
+#include <vector>
 
 #include <folly/IPAddress.h>
+#include <folly/Range.h>
 #include <folly/SocketAddress.h>
 
 namespace openr {
@@ -59,22 +62,40 @@ class IoProvider {
 
   virtual ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags);
 
+  virtual int recvmmsg(
+      int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+
+  virtual int sendmmsg(
+      int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags);
+
   virtual int setsockopt(
       int sockfd, int level, int optname, const void* optval, socklen_t optlen);
 
   // Utility functions that operate on sockets
 
   /*
-   * Receive a message on fd, and return its size, interface index,
-   * and the source address
+   * Message received with recvMessages. Data points into the caller supplied
+   * buffer
    */
-  static std::tuple<
-      ssize_t /* size */,
-      int /* ifIndex */,
-      folly::SocketAddress /* srcAddr */,
-      int /* hopLimit */,
-      std::chrono::microseconds /* kernel timestamp */>
-  recvMessage(int fd, unsigned char* buf, int len, IoProvider* ioProvider);
+  struct RecvMessage {
+    folly::ByteRange data;
+    int ifIndex{-1};
+    folly::SocketAddress srcAddr;
+    int hopLimit{0};
+    std::chrono::microseconds recvTs{0};
+  };
+
+  /*
+   * Receive up to numMsgs messages on fd with a single syscall. Message i is
+   * received into [buf + i * len, buf + (i + 1) * len). Truncated messages are
+   * dropped. Returns empty vector if there is nothing to read
+   */
+  static std::vector<RecvMessage> recvMessages(
+      int fd,
+      unsigned char* buf,
+      int len,
+      unsigned int numMsgs,
+      IoProvider* ioProvider);
 
   /*
    * Send message on fd via given interface to the address provided
@@ -88,6 +109,23 @@ class IoProvider {
       std::string const& packet,
       IoProvider* ioProvider);
 
+  /*
+   * Message to be sent with sendMessages
+   */
+  struct SendMessage {
+    int ifIndex{0};
+    folly::IPAddressV6 srcAddr;
+    folly::SocketAddress dstAddr;
+    std::string packet;
+  };
+
+  /*
+   * Send messages on fd with as few syscalls as possible. Returns number of
+   * bytes sent for every message, or -1 if sending of message failed
+   */
+  static std::vector<ssize_t> sendMessages(
+      int fd, std::vector<SendMessage> const& msgs, IoProvider* ioProvider);
+
  private:
   IoProvider(IoProvider const&) = delete;
   IoProvider& operator=(IoProvider const&) = delete;
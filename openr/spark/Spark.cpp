@@ -16,10 +16,12 @@
 #include <folly/MapUtil.h>
 #include <folly/SocketAddress.h>
 #include <folly/String.h>
+#include <folly/Varint.h>
 #include <folly/fibers/FiberManagerMap.h>
 #include <folly/futures/Future.h>
 #include <folly/futures/Promise.h>
 #include <folly/gen/Base.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/NetworkUtil.h>
@@ -44,6 +46,9 @@ const int kSparkHopLimit = 255;
 // number of restarting packets to send out per interface before I'm going down
 const int kNumRestartingPktSent = 3;
 
+// max number of packets received with a single syscall
+const unsigned int kRecvBatchSize = 32;
+
 //
 // Function to get current timestamp in microseconds using steady clock
 // NOTE: we use non-monotonic clock since kernel time-stamps do not support
@@ -326,13 +331,18 @@ void
 Spark::stop() {
   // send out restarting packets for all interfaces before I'm going down
   // here we are sending duplicate restarting packets (3 times per interface)
-  // in case some packets get lost
-  for (int i = 0; i < kNumRestartingPktSent; ++i) {
-    for (const auto& kv : interfaceDb_) {
-      const auto& ifName = kv.first;
-      sendHelloMsg(ifName, false /* inFastInitState */, true /* restarting */);
+  // in case some packets get lost. Packets are queued and flushed in the
+  // event base thread as pending packets are also touched by timers there.
+  getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait([this]() {
+    for (int i = 0; i < kNumRestartingPktSent; ++i) {
+      for (const auto& kv : interfaceDb_) {
+        const auto& ifName = kv.first;
+        sendHelloMsg(
+            ifName, false /* inFastInitState */, true /* restarting */);
+      }
     }
-  }
+    sendPendingPackets();
+  });
 
   LOG(INFO)
       << "I have sent all restarting packets to my neighbors, ready to go down";
@@ -451,7 +461,9 @@ Spark::prepareSocket(std::optional<int> maybeIpTos) noexcept {
 
   LOG(INFO) << "Spark thread attaching socket/events callbacks...";
 
-  // Listen for incoming messages on multicast FD
+  // Listen for incoming messages on multicast FD. Packets are received in
+  // batches of kRecvBatchSize
+  recvBuf_.resize(kMinIpv6Mtu * kRecvBatchSize);
   addSocketFd(mcastFd_, ZMQ_POLLIN, [this](int) noexcept {
     try {
       processPacket();
@@ -461,6 +473,11 @@ Spark::prepareSocket(std::optional<int> maybeIpTos) noexcept {
     }
   });
 
+  // Hello and heartbeat packets are queued and sent out together at the end
+  // of event loop iteration in which their timers fired
+  sendPacketsTimer_ = folly::AsyncTimeout::make(
+      *getEvb(), [this]() noexcept { sendPendingPackets(); });
+
   // update counters every few seconds
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     updateGlobalCounters();
@@ -525,37 +542,29 @@ Spark::shouldProcessHelloPacket(
 
 bool
 Spark::parsePacket(
+    IoProvider::RecvMessage const& msg,
     thrift::SparkHelloPacket& pkt,
-    std::string& ifName,
-    std::chrono::microseconds& recvTime) {
-  // the read buffer
-  uint8_t buf[kMinIpv6Mtu];
-
-  ssize_t bytesRead;
-  int ifIndex;
-  folly::SocketAddress clientAddr;
-  int hopLimit;
-
-  std::tie(bytesRead, ifIndex, clientAddr, hopLimit, recvTime) =
-      IoProvider::recvMessage(mcastFd_, buf, kMinIpv6Mtu, ioProvider_.get());
+    std::string& ifName) {
+  auto const& clientAddr = msg.srcAddr;
+  const auto bytesRead = msg.data.size();
 
-  if (hopLimit < kSparkHopLimit) {
+  if (msg.hopLimit < kSparkHopLimit) {
     LOG(ERROR) << "Rejecting packet from " << clientAddr.getAddressStr()
-               << " due to hop limit being " << hopLimit;
+               << " due to hop limit being " << msg.hopLimit;
     return false;
   }
 
-  auto res = findInterfaceFromIfindex(ifIndex);
+  auto res = findInterfaceFromIfindex(msg.ifIndex);
   if (!res.has_value()) {
     LOG(ERROR) << "Received packet from " << clientAddr.getAddressStr()
-               << " on unknown interface with index " << ifIndex
+               << " on unknown interface with index " << msg.ifIndex
                << ". Ignoring the packet.";
     return false;
   }
 
   ifName = res.value();
 
-  VLOG(4) << "Received message on " << ifName << " ifindex " << ifIndex
+  VLOG(4) << "Received message on " << ifName << " ifindex " << msg.ifIndex
           << " from " << clientAddr.getAddressStr();
 
   // update counters for packets received, dropped and processed
@@ -574,25 +583,12 @@ Spark::parsePacket(
 
   fb303::fbData->addStatValue("spark.hello_packet_processed", 1, fb303::SUM);
 
-  if (bytesRead >= 0) {
-    VLOG(4) << "Read a total of " << bytesRead << " bytes from fd " << mcastFd_;
-
-    if (static_cast<size_t>(bytesRead) > kMinIpv6Mtu) {
-      LOG(ERROR) << "Message from " << clientAddr.getAddressStr()
-                 << " has been truncated";
-      return false;
-    }
-  } else {
-    LOG(ERROR) << "Failed reading from fd " << mcastFd_ << " error "
-               << folly::errnoStr(errno);
-    return false;
-  }
+  VLOG(4) << "Read a total of " << bytesRead << " bytes from fd " << mcastFd_;
 
-  // Copy buffer into string object and parse it into helloPacket.
-  std::string readBuf(reinterpret_cast<const char*>(&buf[0]), bytesRead);
+  // Parse buffer into helloPacket
   try {
     pkt = fbzmq::util::readThriftObjStr<thrift::SparkHelloPacket>(
-        readBuf, serializer_);
+        msg.data.toString(), serializer_);
   } catch (std::exception const& err) {
     LOG(ERROR) << "Failed parsing hello packet " << folly::exceptionStr(err);
     return false;
@@ -772,6 +768,8 @@ Spark::sendHandshakeMsg(
   handshakeMsg.kvStoreCmdPort = kKvStoreCmdPort_;
   handshakeMsg.area = neighborAreaId; // send neighborAreaId deduced locally
   handshakeMsg.neighborNodeName_ref() = neighborName;
+  // every node can decompress, compressing is up to the sender's config
+  handshakeMsg.supportCompression = true;
 
   thrift::SparkHelloPacket pkt;
   pkt.handshakeMsg_ref() = std::move(handshakeMsg);
@@ -828,15 +826,13 @@ Spark::sendHeartbeatMsg(std::string const& ifName) {
   const auto ifIndex = interfaceEntry.ifIndex;
   const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
 
-  // build heartbeat msg
-  thrift::SparkHeartbeatMsg heartbeatMsg;
-  heartbeatMsg.nodeName = myNodeName_;
-  heartbeatMsg.seqNum = mySeqNum_;
-
-  thrift::SparkHelloPacket pkt;
-  pkt.heartbeatMsg_ref() = std::move(heartbeatMsg);
-
-  auto packet = fbzmq::util::writeThriftObjStr(pkt, serializer_);
+  // heartbeat msg only differs in seqNum between ticks and interfaces
+  if (not heartbeatTemplate_.has_value()) {
+    thrift::SparkHeartbeatMsg heartbeatMsg;
+    heartbeatMsg.nodeName = myNodeName_;
+    heartbeatTemplate_ = buildHeartbeatTemplate(heartbeatMsg);
+  }
+  auto packet = heartbeatTemplate_->fill({static_cast<int64_t>(mySeqNum_)});
 
   // send the pkt
   folly::SocketAddress dstAddr(
@@ -848,19 +844,12 @@ Spark::sendHeartbeatMsg(std::string const& ifName) {
     return;
   }
 
-  auto bytesSent = IoProvider::sendMessage(
-      mcastFd_, ifIndex, v6Addr.asV6(), dstAddr, packet, ioProvider_.get());
-
-  if ((bytesSent < 0) || (static_cast<size_t>(bytesSent) != packet.size())) {
-    VLOG(1) << "Sending multicast to " << dstAddr.getAddressStr() << " on "
-            << ifName << " failed due to error " << folly::errnoStr(errno);
-    return;
-  }
-
-  // update counters for number of pkts and total size of pkts sent
-  fb303::fbData->addStatValue(
-      "spark.heartbeat.bytes_sent", packet.size(), fb303::SUM);
-  fb303::fbData->addStatValue("spark.heartbeat.packets_sent", 1, fb303::SUM);
+  // send out along with other packets of this event loop iteration
+  queuePacket(
+      ifName,
+      "spark.heartbeat",
+      IoProvider::SendMessage{
+          ifIndex, v6Addr.asV6(), std::move(dstAddr), std::move(packet)});
 }
 
 void
@@ -923,8 +912,8 @@ Spark::neighborUpWrapper(
   neighbor.negotiateHoldTimer.reset();
 
   // create heartbeat hold timer when promote to "ESTABLISHED"
-  neighbor.heartbeatHoldTimer = folly::AsyncTimeout::make(
-      *getEvb(), [this, ifName, neighborName]() noexcept {
+  neighbor.heartbeatHoldTimer = NeighborTimer::make(
+      getEvb()->timer(), [this, ifName, neighborName]() noexcept {
         processHeartbeatTimeout(ifName, neighborName);
       });
   neighbor.heartbeatHoldTimer->scheduleTimeout(neighbor.heartbeatHoldTime);
@@ -940,7 +929,8 @@ Spark::neighborUpWrapper(
       neighbor.rtt.count(),
       neighbor.label,
       true /* support flood-optimization */,
-      neighbor.area);
+      neighbor.area,
+      neighbor.supportCompression);
 }
 
 void
@@ -978,7 +968,8 @@ Spark::notifySparkNeighborEvent(
     int64_t rttUs,
     int32_t label,
     bool supportFloodOptimization,
-    const std::string& area) {
+    const std::string& area,
+    bool supportCompression) {
   thrift::SparkNeighborEvent event;
   event.eventType = eventType;
   event.ifName = ifName;
@@ -987,6 +978,7 @@ Spark::notifySparkNeighborEvent(
   event.label = label;
   event.supportFloodOptimization = supportFloodOptimization;
   event.area = area;
+  event.supportCompression = supportCompression;
   neighborUpdatesQueue_.push(std::move(event));
 }
 
@@ -997,8 +989,10 @@ Spark::processHeartbeatTimeout(
   auto& ifNeighbors = sparkNeighbors_.at(ifName);
   auto& neighbor = ifNeighbors.at(neighborName);
 
-  // remove from tracked neighbor at the end
+  // remove from tracked neighbor at the end. NOTE: ifName and neighborName
+  // are owned by the neighbor's timer, don't use them after erasing neighbor
   SCOPE_EXIT {
+    helloTemplates_.erase(ifName);
     allocatedLabels_.erase(neighbor.label);
     ifNeighbors.erase(neighborName);
   };
@@ -1049,8 +1043,10 @@ Spark::processGRTimeout(
   auto& ifNeighbors = sparkNeighbors_.at(ifName);
   auto& neighbor = ifNeighbors.at(neighborName);
 
-  // remove from tracked neighbor at the end
+  // remove from tracked neighbor at the end. NOTE: ifName and neighborName
+  // are owned by the neighbor's timer, don't use them after erasing neighbor
   SCOPE_EXIT {
+    helloTemplates_.erase(ifName);
     allocatedLabels_.erase(neighbor.label);
     ifNeighbors.erase(neighborName);
   };
@@ -1086,8 +1082,8 @@ Spark::processGRMsg(
       neighbor.area);
 
   // start graceful-restart timer
-  neighbor.gracefulRestartHoldTimer = folly::AsyncTimeout::make(
-      *getEvb(), [this, ifName, neighborName]() noexcept {
+  neighbor.gracefulRestartHoldTimer = NeighborTimer::make(
+      getEvb()->timer(), [this, ifName, neighborName]() noexcept {
         // change the state back to IDLE
         processGRTimeout(ifName, neighborName);
       });
@@ -1176,6 +1172,9 @@ Spark::processHelloMsg(
     checkNeighborState(neighbor, SparkNeighState::IDLE);
   }
 
+  // Neighbor state reflected in our hello msg is going to change
+  helloTemplates_.erase(ifName);
+
   // Up till now, node knows about this neighbor and perform SM check
   auto& neighbor = ifNeighbors.at(neighborName);
 
@@ -1244,8 +1243,9 @@ Spark::processHelloMsg(
 
     // Starts timer to periodically send hankshake msg
     const std::string neighborAreaId = neighbor.area;
-    neighbor.negotiateTimer = folly::AsyncTimeout::make(
-        *getEvb(), [this, ifName, neighborName, neighborAreaId]() noexcept {
+    neighbor.negotiateTimer = NeighborTimer::make(
+        getEvb()->timer(),
+        [this, ifName, neighborName, neighborAreaId]() noexcept {
           sendHandshakeMsg(ifName, neighborName, neighborAreaId, false);
           // send out handshake msg periodically to this neighbor
           CHECK(sparkNeighbors_.count(ifName) > 0)
@@ -1260,8 +1260,8 @@ Spark::processHelloMsg(
     neighbor.negotiateTimer->scheduleTimeout(handshakeTime_);
 
     // Starts negotiate hold-timer
-    neighbor.negotiateHoldTimer = folly::AsyncTimeout::make(
-        *getEvb(), [this, ifName, neighborName]() noexcept {
+    neighbor.negotiateHoldTimer = NeighborTimer::make(
+        getEvb()->timer(), [this, ifName, neighborName]() noexcept {
           // prevent to stucking in NEGOTIATE forever
           processNegotiateTimeout(ifName, neighborName);
         });
@@ -1333,11 +1333,12 @@ Spark::processHelloMsg(
         neighbor.rtt.count(),
         neighbor.label,
         true /* support flood-optimization */,
-        neighbor.area);
+        neighbor.area,
+        neighbor.supportCompression);
 
     // start heartbeat timer again to make sure neighbor is alive
-    neighbor.heartbeatHoldTimer = folly::AsyncTimeout::make(
-        *getEvb(), [this, ifName, neighborName]() noexcept {
+    neighbor.heartbeatHoldTimer = NeighborTimer::make(
+        getEvb()->timer(), [this, ifName, neighborName]() noexcept {
           processHeartbeatTimeout(ifName, neighborName);
         });
     neighbor.heartbeatHoldTimer->scheduleTimeout(neighbor.heartbeatHoldTime);
@@ -1426,6 +1427,7 @@ Spark::processHandshakeMsg(
   neighbor.openrCtrlThriftPort = handshakeMsg.openrCtrlThriftPort;
   neighbor.transportAddressV4 = handshakeMsg.transportAddressV4;
   neighbor.transportAddressV6 = handshakeMsg.transportAddressV6;
+  neighbor.supportCompression = handshakeMsg.supportCompression;
 
   // update neighbor holdTime as "NEGOTIATING" process
   neighbor.heartbeatHoldTime =
@@ -1530,18 +1532,43 @@ Spark::processHeartbeatMsg(
 
 void
 Spark::processPacket() {
-  // receive and parse pkt
+  // drain all pending packets, receiving a batch of them per syscall
+  while (true) {
+    auto msgs = IoProvider::recvMessages(
+        mcastFd_,
+        recvBuf_.data(),
+        kMinIpv6Mtu,
+        kRecvBatchSize,
+        ioProvider_.get());
+
+    for (auto const& msg : msgs) {
+      try {
+        processPacket(msg);
+      } catch (std::exception const& err) {
+        LOG(ERROR) << "Spark: error processing hello packet "
+                   << folly::exceptionStr(err);
+      }
+    }
+
+    if (msgs.size() < kRecvBatchSize) {
+      break;
+    }
+  }
+}
+
+void
+Spark::processPacket(IoProvider::RecvMessage const& msg) {
+  // parse pkt
   thrift::SparkHelloPacket helloPacket;
   std::string ifName;
-  std::chrono::microseconds myRecvTime;
 
-  if (!parsePacket(helloPacket, ifName, myRecvTime)) {
+  if (!parsePacket(msg, helloPacket, ifName)) {
     return;
   }
 
   // Spark specific msg processing
   if (helloPacket.helloMsg_ref().has_value()) {
-    processHelloMsg(helloPacket.helloMsg_ref().value(), ifName, myRecvTime);
+    processHelloMsg(helloPacket.helloMsg_ref().value(), ifName, msg.recvTs);
   } else if (helloPacket.heartbeatMsg_ref().has_value()) {
     processHeartbeatMsg(helloPacket.heartbeatMsg_ref().value(), ifName);
   } else if (helloPacket.handshakeMsg_ref().has_value()) {
@@ -1549,6 +1576,190 @@ Spark::processPacket() {
   }
 }
 
+void
+Spark::queuePacket(
+    std::string const& ifName,
+    folly::StringPiece counterPrefix,
+    IoProvider::SendMessage&& msg) {
+  pendingPackets_.emplace_back(PendingPacket{ifName, counterPrefix});
+  pendingMsgs_.emplace_back(std::move(msg));
+  // flush at the end of current event loop iteration. Always called in event
+  // base thread, `stop()` queues restarting packets there as well
+  if (not sendPacketsTimer_->isScheduled()) {
+    sendPacketsTimer_->scheduleTimeout(std::chrono::milliseconds(0));
+  }
+}
+
+void
+Spark::sendPendingPackets() {
+  if (pendingMsgs_.empty()) {
+    return;
+  }
+
+  auto bytesSent =
+      IoProvider::sendMessages(mcastFd_, pendingMsgs_, ioProvider_.get());
+  CHECK_EQ(bytesSent.size(), pendingMsgs_.size());
+
+  for (size_t i = 0; i < pendingMsgs_.size(); ++i) {
+    auto const& msg = pendingMsgs_[i];
+    auto const& pending = pendingPackets_[i];
+    if ((bytesSent[i] < 0) ||
+        (static_cast<size_t>(bytesSent[i]) != msg.packet.size())) {
+      VLOG(1) << "Sending multicast to " << msg.dstAddr.getAddressStr()
+              << " on " << pending.ifName << " failed";
+      continue;
+    }
+
+    // update counters for number of pkts and total size of pkts sent
+    fb303::fbData->addStatValue(
+        folly::sformat("{}.bytes_sent", pending.counterPrefix),
+        msg.packet.size(),
+        fb303::SUM);
+    fb303::fbData->addStatValue(
+        folly::sformat("{}.packets_sent", pending.counterPrefix),
+        1,
+        fb303::SUM);
+  }
+  VLOG(4) << "Sent " << pendingMsgs_.size() << " packets in a batch";
+
+  pendingPackets_.clear();
+  pendingMsgs_.clear();
+}
+
+std::string
+Spark::PacketTemplate::fill(std::initializer_list<int64_t> values) const {
+  CHECK_EQ(placeholders.size(), values.size());
+  std::string packet;
+  packet.reserve(data.size() + values.size() * folly::kMaxVarintLength64);
+
+  // copy data in between placeholders and replace single byte placeholders
+  // with zigzag varint encoded values, as compact protocol does for i64
+  size_t offset{0};
+  auto placeholderIt = placeholders.begin();
+  for (auto value : values) {
+    packet.append(data, offset, *placeholderIt - offset);
+    uint8_t buf[folly::kMaxVarintLength64];
+    auto len = folly::encodeVarint(folly::encodeZigZag(value), buf);
+    packet.append(reinterpret_cast<const char*>(buf), len);
+    offset = *placeholderIt + 1;
+    ++placeholderIt;
+  }
+  packet.append(data, offset, std::string::npos);
+  return packet;
+}
+
+namespace {
+
+// Write i64 field with a single byte placeholder (zero) as value and record
+// its offset in the template
+void
+writeI64Placeholder(
+    apache::thrift::CompactProtocolWriter& writer,
+    folly::IOBufQueue& queue,
+    const char* name,
+    int16_t fieldId,
+    std::vector<size_t>& placeholders) {
+  writer.writeFieldBegin(name, apache::thrift::protocol::T_I64, fieldId);
+  placeholders.emplace_back(queue.chainLength());
+  writer.writeI64(0);
+  writer.writeFieldEnd();
+}
+
+void
+writeStringField(
+    apache::thrift::CompactProtocolWriter& writer,
+    const char* name,
+    int16_t fieldId,
+    std::string const& value) {
+  writer.writeFieldBegin(name, apache::thrift::protocol::T_STRING, fieldId);
+  writer.writeString(value);
+  writer.writeFieldEnd();
+}
+
+} // namespace
+
+//
+// NOTE: Templates are written field by field, in the same way as generated
+// code would serialize thrift::SparkHelloPacket, to leave placeholders for
+// fields updated on every send. Keep them in sync with Spark.thrift
+//
+Spark::PacketTemplate
+Spark::buildHelloTemplate(thrift::SparkHelloMsg const& helloMsg) {
+  using apache::thrift::protocol::TType;
+
+  PacketTemplate helloTemplate;
+  folly::IOBufQueue queue(folly::IOBufQueue::cacheChainLength());
+  apache::thrift::CompactProtocolWriter writer;
+  writer.setOutput(&queue);
+
+  writer.writeStructBegin("SparkHelloPacket");
+  writer.writeFieldBegin("helloMsg", TType::T_STRUCT, 3);
+
+  writer.writeStructBegin("SparkHelloMsg");
+  writeStringField(writer, "domainName", 1, helloMsg.domainName);
+  writeStringField(writer, "nodeName", 2, helloMsg.nodeName);
+  writeStringField(writer, "ifName", 3, helloMsg.ifName);
+  writeI64Placeholder(writer, queue, "seqNum", 4, helloTemplate.placeholders);
+
+  writer.writeFieldBegin("neighborInfos", TType::T_MAP, 5);
+  writer.writeMapBegin(
+      TType::T_STRING, TType::T_STRUCT, helloMsg.neighborInfos.size());
+  for (auto const& [neighborName, neighborInfo] : helloMsg.neighborInfos) {
+    writer.writeString(neighborName);
+    neighborInfo.write(&writer);
+  }
+  writer.writeMapEnd();
+  writer.writeFieldEnd();
+
+  writer.writeFieldBegin("version", TType::T_I32, 6);
+  writer.writeI32(helloMsg.version);
+  writer.writeFieldEnd();
+  writer.writeFieldBegin("solicitResponse", TType::T_BOOL, 7);
+  writer.writeBool(helloMsg.solicitResponse);
+  writer.writeFieldEnd();
+  writer.writeFieldBegin("restarting", TType::T_BOOL, 8);
+  writer.writeBool(helloMsg.restarting);
+  writer.writeFieldEnd();
+  writeI64Placeholder(
+      writer, queue, "sentTsInUs", 9, helloTemplate.placeholders);
+  writer.writeFieldStop();
+  writer.writeStructEnd();
+
+  writer.writeFieldEnd();
+  writer.writeFieldStop();
+  writer.writeStructEnd();
+
+  helloTemplate.data = queue.move()->moveToFbString().toStdString();
+  return helloTemplate;
+}
+
+Spark::PacketTemplate
+Spark::buildHeartbeatTemplate(thrift::SparkHeartbeatMsg const& heartbeatMsg) {
+  using apache::thrift::protocol::TType;
+
+  PacketTemplate heartbeatTemplate;
+  folly::IOBufQueue queue(folly::IOBufQueue::cacheChainLength());
+  apache::thrift::CompactProtocolWriter writer;
+  writer.setOutput(&queue);
+
+  writer.writeStructBegin("SparkHelloPacket");
+  writer.writeFieldBegin("heartbeatMsg", TType::T_STRUCT, 4);
+
+  writer.writeStructBegin("SparkHeartbeatMsg");
+  writeStringField(writer, "nodeName", 1, heartbeatMsg.nodeName);
+  writeI64Placeholder(
+      writer, queue, "seqNum", 2, heartbeatTemplate.placeholders);
+  writer.writeFieldStop();
+  writer.writeStructEnd();
+
+  writer.writeFieldEnd();
+  writer.writeFieldStop();
+  writer.writeStructEnd();
+
+  heartbeatTemplate.data = queue.move()->moveToFbString().toStdString();
+  return heartbeatTemplate;
+}
+
 void
 Spark::sendHelloMsg(
     std::string const& ifName, bool inFastInitState, bool restarting) {
@@ -1573,40 +1784,44 @@ Spark::sendHelloMsg(
   // down event has not arrived yet
   const auto& interfaceEntry = interfaceDb_.at(ifName);
   const auto ifIndex = interfaceEntry.ifIndex;
-  const auto v4Addr = interfaceEntry.v4Network.first;
   const auto v6Addr = interfaceEntry.v6LinkLocalNetwork.first;
-  thrift::OpenrVersion openrVer(kVersion_.version);
-
-  // build the helloMsg from scratch
-  thrift::SparkHelloMsg helloMsg;
-  helloMsg.domainName = myDomainName_;
-  helloMsg.nodeName = myNodeName_;
-  helloMsg.ifName = ifName;
-  helloMsg.seqNum = mySeqNum_;
-  helloMsg.neighborInfos =
-      std::map<std::string, thrift::ReflectedNeighborInfo>{};
-  helloMsg.version = openrVer;
-  helloMsg.solicitResponse = inFastInitState;
-  helloMsg.restarting = restarting;
-  helloMsg.sentTsInUs = getCurrentTimeInUs().count();
-
-  // bake neighborInfo into helloMsg
-  for (const auto& kv : sparkNeighbors_.at(ifName)) {
-    auto const& neighborName = kv.first;
-    auto const& neighbor = kv.second;
-
-    auto& neighborInfo = helloMsg.neighborInfos[neighborName];
-    neighborInfo.seqNum = neighbor.seqNum;
-    neighborInfo.lastNbrMsgSentTsInUs = neighbor.neighborTimestamp.count();
-    neighborInfo.lastMyMsgRcvdTsInUs = neighbor.localTimestamp.count();
-  }
-
-  // fill in helloMsg field
-  thrift::SparkHelloPacket helloPacket;
-  helloPacket.helloMsg_ref() = std::move(helloMsg);
 
-  // send the payload
-  auto packet = fbzmq::util::writeThriftObjStr(helloPacket, serializer_);
+  // (re)build packet template if neighbor state or flags have changed since
+  // last hello on this interface
+  auto templateIt = helloTemplates_.find(ifName);
+  if (templateIt == helloTemplates_.end() or
+      templateIt->second.solicitResponse != inFastInitState or
+      templateIt->second.restarting != restarting) {
+    // seqNum and sentTsInUs are filled in on every send
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName = myDomainName_;
+    helloMsg.nodeName = myNodeName_;
+    helloMsg.ifName = ifName;
+    helloMsg.version = kVersion_.version;
+    helloMsg.solicitResponse = inFastInitState;
+    helloMsg.restarting = restarting;
+
+    // bake neighborInfo into helloMsg
+    for (const auto& kv : sparkNeighbors_.at(ifName)) {
+      auto const& neighborName = kv.first;
+      auto const& neighbor = kv.second;
+
+      auto& neighborInfo = helloMsg.neighborInfos[neighborName];
+      neighborInfo.seqNum = neighbor.seqNum;
+      neighborInfo.lastNbrMsgSentTsInUs = neighbor.neighborTimestamp.count();
+      neighborInfo.lastMyMsgRcvdTsInUs = neighbor.localTimestamp.count();
+    }
+
+    HelloTemplate helloTemplate{
+        inFastInitState, restarting, buildHelloTemplate(helloMsg)};
+    templateIt =
+        helloTemplates_.insert_or_assign(ifName, std::move(helloTemplate))
+            .first;
+  }
+
+  // send the payload with up to date seqNum and sentTsInUs
+  auto packet = templateIt->second.packet.fill(
+      {static_cast<int64_t>(mySeqNum_), getCurrentTimeInUs().count()});
   folly::SocketAddress dstAddr(
       folly::IPAddress(Constants::kSparkMcastAddr.toString()),
       neighborDiscoveryPort_);
@@ -1616,21 +1831,12 @@ Spark::sendHelloMsg(
     return;
   }
 
-  auto bytesSent = IoProvider::sendMessage(
-      mcastFd_, ifIndex, v6Addr.asV6(), dstAddr, packet, ioProvider_.get());
-
-  if ((bytesSent < 0) || (static_cast<size_t>(bytesSent) != packet.size())) {
-    VLOG(1) << "Sending multicast to " << dstAddr.getAddressStr() << " on "
-            << ifName << " failed due to error " << folly::errnoStr(errno);
-    return;
-  }
-
-  // update counters for number of pkts and total size of pkts sent
-  fb303::fbData->addStatValue(
-      "spark.hello.bytes_sent", packet.size(), fb303::SUM);
-  fb303::fbData->addStatValue("spark.hello.packets_sent", 1, fb303::SUM);
-
-  VLOG(4) << "Sent " << bytesSent << " bytes in hello packet";
+  // send out along with other packets of this event loop iteration
+  queuePacket(
+      ifName,
+      "spark.hello",
+      IoProvider::SendMessage{
+          ifIndex, v6Addr.asV6(), std::move(dstAddr), std::move(packet)});
 }
 
 void
@@ -1759,6 +1965,7 @@ Spark::deleteInterfaceFromDb(const std::set<std::string>& toDel) {
     }
     sparkNeighbors_.erase(ifName);
     ifNameToHeartbeatTimers_.erase(ifName);
+    helloTemplates_.erase(ifName);
 
     // unsubscribe the socket from mcast group on this interface
     // On error, log and continue
@@ -11,7 +11,9 @@
 #include <functional>
 
 #include <folly/SocketAddress.h>
+#include <folly/Function.h>
 #include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <folly/stats/BucketedTimeSeries.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
@@ -93,6 +95,24 @@ class Spark final : public OpenrEventBase {
   // override eventloop stop()
   void stop() override;
 
+  // Serialized packet with single byte placeholders for i64 fields which
+  // change on every send (seqNum, timestamp)
+  struct PacketTemplate {
+    // Packet with placeholders filled in with given values, in order
+    std::string fill(std::initializer_list<int64_t> values) const;
+
+    std::string data;
+    std::vector<size_t> placeholders;
+  };
+
+  // util calls to serialize templates of hello and heartbeat packets, public
+  // for unit-testing. Placeholders are left for seqNum and sentTsInUs of
+  // hello msg and for seqNum of heartbeat msg, in that order
+  static PacketTemplate buildHelloTemplate(
+      thrift::SparkHelloMsg const& helloMsg);
+  static PacketTemplate buildHeartbeatTemplate(
+      thrift::SparkHeartbeatMsg const& heartbeatMsg);
+
  private:
   //
   // Interface tracking
@@ -141,9 +161,12 @@ class Spark final : public OpenrEventBase {
   bool shouldProcessHelloPacket(
       std::string const& ifName, folly::IPAddress const& addr);
 
+  // receive all pending hello packets from neighbors and process them
+  void processPacket();
+
   // process hello packet from a neighbor. we want to see if
   // the neighbor could be added as adjacent peer.
-  void processPacket();
+  void processPacket(IoProvider::RecvMessage const& msg);
 
   // process helloMsg in Spark context
   void processHelloMsg(
@@ -175,6 +198,16 @@ class Spark final : public OpenrEventBase {
   // util call to send heartbeat msg
   void sendHeartbeatMsg(std::string const& ifName);
 
+  // queue packet to be sent out in next batch. Counters prefixed with
+  // counterPrefix are updated once it is sent
+  void queuePacket(
+      std::string const& ifName,
+      folly::StringPiece counterPrefix,
+      IoProvider::SendMessage&& msg);
+
+  // send out all queued packets with as few syscalls as possible
+  void sendPendingPackets();
+
   // Function processes interface updates from LinkMonitor and appropriately
   // enable/disable neighbor discovery
   void processInterfaceUpdates(thrift::InterfaceDatabase&& interfaceUpdates);
@@ -230,11 +263,11 @@ class Spark final : public OpenrEventBase {
       const std::unordered_map<std::string /* areaId */, AreaConfiguration>&
           areaConfigs);
 
-  // function to receive and parse received pkt
+  // function to validate and parse received pkt
   bool parsePacket(
+      IoProvider::RecvMessage const& msg /* received message */,
       thrift::SparkHelloPacket& pkt /* packet( type will be renamed later) */,
-      std::string& ifName /* interface */,
-      std::chrono::microseconds& recvTime /* kernel timestamp when recved */);
+      std::string& ifName /* interface */);
 
   // function to validate v4Address with its subnet
   PacketValidationResult validateV4AddressSubnet(
@@ -250,6 +283,42 @@ class Spark final : public OpenrEventBase {
       std::string const& remoteIfName,
       std::string const& ifName);
 
+  //
+  // Per-neighbor timer backed by the event base's HHWheelTimer. Every
+  // neighbor owns several hold timers which are re-armed on each received
+  // packet. Keeping them in the shared timer wheel makes schedule/cancel an
+  // O(1) bucket operation instead of a libevent timer heap update per packet.
+  //
+  class NeighborTimer : public folly::HHWheelTimer::Callback {
+   public:
+    static std::unique_ptr<NeighborTimer>
+    make(folly::HHWheelTimer& wheel, folly::Function<void()> callback) {
+      return std::make_unique<NeighborTimer>(wheel, std::move(callback));
+    }
+
+    NeighborTimer(folly::HHWheelTimer& wheel, folly::Function<void()> callback)
+        : wheel_(wheel), callback_(std::move(callback)) {}
+
+    // (re)schedule the timer. Pending expiry gets cancelled
+    void
+    scheduleTimeout(std::chrono::milliseconds timeout) {
+      wheel_.scheduleTimeout(this, timeout);
+    }
+
+   private:
+    void
+    timeoutExpired() noexcept override {
+      callback_();
+    }
+
+    // timer got cancelled or the wheel is being destroyed, nothing to do
+    void
+    callbackCanceled() noexcept override {}
+
+    folly::HHWheelTimer& wheel_;
+    folly::Function<void()> callback_;
+  };
+
   //
   // Spark related function call
   //
@@ -298,21 +367,24 @@ class Spark final : public OpenrEventBase {
     SparkNeighState state;
 
     // timer to periodically send out handshake pkt
-    std::unique_ptr<folly::AsyncTimeout> negotiateTimer{nullptr};
+    std::unique_ptr<NeighborTimer> negotiateTimer{nullptr};
 
     // negotiate stage hold-timer
-    std::unique_ptr<folly::AsyncTimeout> negotiateHoldTimer{nullptr};
+    std::unique_ptr<NeighborTimer> negotiateHoldTimer{nullptr};
 
     // heartbeat hold-timer
-    std::unique_ptr<folly::AsyncTimeout> heartbeatHoldTimer{nullptr};
+    std::unique_ptr<NeighborTimer> heartbeatHoldTimer{nullptr};
 
     // graceful restart hold-timer
-    std::unique_ptr<folly::AsyncTimeout> gracefulRestartHoldTimer{nullptr};
+    std::unique_ptr<NeighborTimer> gracefulRestartHoldTimer{nullptr};
 
     // KvStore related port. Info passed to LinkMonitor for neighborEvent
     int32_t kvStoreCmdPort{0};
     int32_t openrCtrlThriftPort{0};
 
+    // neighbor can decompress KvStore messages. Learnt from handshake
+    bool supportCompression{false};
+
     // hold time
     std::chrono::milliseconds heartbeatHoldTime{0};
     std::chrono::milliseconds gracefulRestartHoldTime{0};
@@ -376,7 +448,8 @@ class Spark final : public OpenrEventBase {
       int32_t label,
       bool supportFloodOptimization,
       const std::string& area =
-          openr::thrift::KvStore_constants::kDefaultArea());
+          openr::thrift::KvStore_constants::kDefaultArea(),
+      bool supportCompression = false);
 
   // callback function for rtt change
   void processRttChange(
@@ -514,5 +587,32 @@ class Spark final : public OpenrEventBase {
 
   // Timer for updating and submitting counters periodically
   std::unique_ptr<folly::AsyncTimeout> counterUpdateTimer_{nullptr};
+
+  // Buffer for receiving a batch of packets, kMinIpv6Mtu bytes per packet
+  std::vector<uint8_t> recvBuf_;
+
+  // Hello and heartbeat packets to be sent out in next batch, along with
+  // interface and counter prefix of every packet
+  struct PendingPacket {
+    std::string ifName;
+    folly::StringPiece counterPrefix;
+  };
+  std::vector<PendingPacket> pendingPackets_;
+  std::vector<IoProvider::SendMessage> pendingMsgs_;
+
+  // Timer for sending out queued packets at the end of event loop iteration
+  std::unique_ptr<folly::AsyncTimeout> sendPacketsTimer_{nullptr};
+
+  // Hello packet templates for each interface. Invalidated when state of
+  // neighbors on interface changes
+  struct HelloTemplate {
+    bool solicitResponse{false};
+    bool restarting{false};
+    PacketTemplate packet;
+  };
+  std::unordered_map<std::string /* ifName */, HelloTemplate> helloTemplates_;
+
+  // Heartbeat packet template, same for all interfaces
+  std::optional<PacketTemplate> heartbeatTemplate_;
 };
 } // namespace openr
@@ -0,0 +1,326 @@
+/**
+ * Copyright (c) 2014-present, Facebook, Inc.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <fbzmq/zmq/Zmq.h>
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <openr/common/Constants.h>
+#include <openr/common/NetworkUtil.h>
+#include <openr/config/Config.h>
+#include <openr/config/tests/Utils.h>
+#include <openr/spark/SparkWrapper.h>
+#include <openr/tests/mocks/MockIoProvider.h>
+
+/**
+ * Defines a benchmark that allows users to record customized counter during
+ * benchmarking and passes a parameter to another one. This is common for
+ * benchmarks that need a "problem size" in addition to "number of iterations".
+ */
+#define BENCHMARK_COUNTERS_PARAM(name, counters, param) \
+  BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param, param)
+
+/*
+ * Like BENCHMARK_COUNTERS_PARAM(), but allows a custom name to be specified for
+ * each parameter, rather than using the parameter value.
+ */
+#define BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param_name, ...) \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
+namespace {
+
+const std::string kDomainName{"domain"};
+const std::string kNodeName{"node-0"};
+
+// Number of interfaces the simulated neighbors are spread across
+const int kNumOfIfaces{16};
+
+// Spark timers. Long enough to keep adjacencies up while the benchmark is
+// suspended between rounds of packets
+const int32_t kKeepAliveTimeS{10};
+const int32_t kHoldTimeS{30};
+
+// Spark rate limits received packets per (ifName, srcAddr) hash bucket over a
+// one second window. Space out rounds of packets to stay below the limit.
+const std::chrono::milliseconds kRoundInterval{1100};
+
+std::string
+getSparkIfName(int i) {
+  return folly::sformat("spark-iface{}", i);
+}
+
+std::string
+getPeerIfName(int i) {
+  return folly::sformat("peer-iface{}", i);
+}
+
+} // namespace
+
+namespace openr {
+
+/**
+ * Spark instance adjacent to a large number of simulated neighbors. Neighbors
+ * don't run Spark. Their packets are crafted and injected through
+ * MockIoProvider, hence a single Spark thread is driven.
+ */
+class SparkScaleFixture {
+ public:
+  struct SimulatedNeighbor {
+    std::string nodeName;
+    std::string ifName;
+    int ifIndex{0};
+    folly::IPAddressV6 v6Addr;
+    folly::IPAddressV4 v4Addr;
+  };
+
+  explicit SparkScaleFixture(uint32_t numOfNeighbors) {
+    mockIoProvider_ = std::make_shared<MockIoProvider>();
+    mockIoProviderThread_ = std::make_unique<std::thread>(
+        [this]() { mockIoProvider_->start(); });
+    mockIoProvider_->waitUntilRunning();
+
+    // packets flow from neighbors' interfaces towards Spark only
+    IfNameAndifIndex ifNameAndIfIndex;
+    ConnectedIfPairs connectedPairs;
+    std::vector<SparkInterfaceEntry> interfaceEntries;
+    for (int i = 0; i < kNumOfIfaces; ++i) {
+      ifNameAndIfIndex.emplace_back(getSparkIfName(i), i + 1);
+      ifNameAndIfIndex.emplace_back(getPeerIfName(i), kNumOfIfaces + i + 1);
+      connectedPairs[getPeerIfName(i)] = {{getSparkIfName(i), 0}};
+      interfaceEntries.emplace_back(SparkInterfaceEntry{
+          getSparkIfName(i),
+          i + 1,
+          folly::IPAddress::createNetwork(
+              folly::sformat("10.{}.0.1", i), 16, false /* apply mask */),
+          folly::IPAddress::createNetwork(
+              folly::sformat("fe80::ffff:{:x}/128", i + 1))});
+    }
+    mockIoProvider_->addIfNameIfIndex(ifNameAndIfIndex);
+    mockIoProvider_->setConnectedPairs(connectedPairs);
+
+    for (uint32_t i = 0; i < numOfNeighbors; ++i) {
+      const int iface = i % kNumOfIfaces;
+      const uint32_t hostId = i / kNumOfIfaces + 2;
+      neighbors_.emplace_back(SimulatedNeighbor{
+          folly::sformat("neighbor-{}", i),
+          getPeerIfName(iface),
+          kNumOfIfaces + iface + 1,
+          folly::IPAddressV6(folly::sformat("fe80::1:{:x}", i + 1)),
+          folly::IPAddressV4(folly::sformat(
+              "10.{}.{}.{}", iface, hostId / 256, hostId % 256))});
+    }
+    injectFd_ = mockIoProvider_->socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+
+    auto tConfig = getBasicOpenrConfig(kNodeName, kDomainName);
+    tConfig.spark_config.keepalive_time_s = kKeepAliveTimeS;
+    tConfig.spark_config.hold_time_s = kHoldTimeS;
+    tConfig.spark_config.graceful_restart_time_s = kHoldTimeS;
+    spark_ = std::make_unique<SparkWrapper>(
+        kNodeName,
+        std::make_pair(
+            Constants::kOpenrVersion, Constants::kOpenrSupportedVersion),
+        mockIoProvider_,
+        std::make_shared<Config>(tConfig));
+    CHECK(spark_->updateInterfaceDb(interfaceEntries));
+
+    // IDLE => WARM. Retry until Spark starts tracking the interfaces
+    auto const hellos = createRound([this](SimulatedNeighbor const& neighbor) {
+      return createHelloPacket(neighbor, false /* reflect Spark */);
+    });
+    do {
+      std::this_thread::sleep_for(kRoundInterval);
+      sendRound(hellos);
+    } while (not allInState(SparkNeighState::WARM));
+
+    // WARM => NEGOTIATE
+    std::this_thread::sleep_for(kRoundInterval);
+    sendRound(createRound([this](SimulatedNeighbor const& neighbor) {
+      return createHelloPacket(neighbor, true /* reflect Spark */);
+    }));
+
+    // NEGOTIATE => ESTABLISHED
+    std::this_thread::sleep_for(kRoundInterval);
+    sendRound(createRound([this](SimulatedNeighbor const& neighbor) {
+      return createHandshakePacket(neighbor);
+    }));
+    for (uint32_t i = 0; i < numOfNeighbors; ++i) {
+      CHECK(spark_->waitForEvent(thrift::SparkNeighborEventType::NEIGHBOR_UP)
+                .has_value());
+    }
+  }
+
+  ~SparkScaleFixture() {
+    spark_.reset();
+    mockIoProvider_->stop();
+    mockIoProviderThread_->join();
+  }
+
+  // one packet from every simulated neighbor
+  std::vector<IoProvider::SendMessage>
+  createRound(std::function<thrift::SparkHelloPacket(
+                  SimulatedNeighbor const&)> const& createPacket) {
+    const folly::SocketAddress dstAddr(
+        folly::IPAddress(Constants::kSparkMcastAddr),
+        Constants::kSparkMcastPort);
+    std::vector<IoProvider::SendMessage> msgs;
+    for (auto const& neighbor : neighbors_) {
+      msgs.emplace_back(IoProvider::SendMessage{
+          neighbor.ifIndex,
+          neighbor.v6Addr,
+          dstAddr,
+          fbzmq::util::writeThriftObjStr(createPacket(neighbor), serializer_)});
+    }
+    return msgs;
+  }
+
+  // inject packets and wait for Spark to process all of them
+  void
+  sendRound(std::vector<IoProvider::SendMessage> const& msgs) {
+    IoProvider::sendMessages(injectFd_, msgs, mockIoProvider_.get());
+    while (mockIoProvider_->getNumPendingMessages()) {
+      std::this_thread::yield();
+    }
+    // round trip through Spark's event loop to finish the last received batch
+    spark_->getSparkNeighState(getSparkIfName(0), neighbors_.front().nodeName);
+  }
+
+  bool
+  allInState(SparkNeighState state) {
+    for (auto const& neighbor : neighbors_) {
+      auto const iface = (neighbor.ifIndex - 1) % kNumOfIfaces;
+      auto const neighborState =
+          spark_->getSparkNeighState(getSparkIfName(iface), neighbor.nodeName);
+      if (neighborState != state) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  thrift::SparkHelloPacket
+  createHelloPacket(SimulatedNeighbor const& neighbor, bool reflectSpark) {
+    const int64_t nowInUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    thrift::SparkHelloMsg helloMsg;
+    helloMsg.domainName = kDomainName;
+    helloMsg.nodeName = neighbor.nodeName;
+    helloMsg.ifName = neighbor.ifName;
+    helloMsg.seqNum = 1;
+    helloMsg.version = Constants::kOpenrVersion;
+    helloMsg.sentTsInUs = nowInUs;
+    if (reflectSpark) {
+      // plausible timestamps so that RTT can be derived
+      thrift::ReflectedNeighborInfo info;
+      info.seqNum = 0;
+      info.lastNbrMsgSentTsInUs = nowInUs - 1000;
+      info.lastMyMsgRcvdTsInUs = nowInUs - 500;
+      helloMsg.neighborInfos.emplace(kNodeName, std::move(info));
+    }
+
+    thrift::SparkHelloPacket pkt;
+    pkt.helloMsg_ref() = std::move(helloMsg);
+    return pkt;
+  }
+
+  thrift::SparkHelloPacket
+  createHandshakePacket(SimulatedNeighbor const& neighbor) {
+    thrift::SparkHandshakeMsg handshakeMsg;
+    handshakeMsg.nodeName = neighbor.nodeName;
+    handshakeMsg.isAdjEstablished = true;
+    handshakeMsg.holdTime = kHoldTimeS * 1000;
+    handshakeMsg.gracefulRestartTime = kHoldTimeS * 1000;
+    handshakeMsg.transportAddressV6 = toBinaryAddress(neighbor.v6Addr);
+    handshakeMsg.transportAddressV4 = toBinaryAddress(neighbor.v4Addr);
+    handshakeMsg.openrCtrlThriftPort = Constants::kOpenrCtrlPort;
+    handshakeMsg.kvStoreCmdPort = Constants::kKvStoreRepPort;
+    handshakeMsg.area = thrift::KvStore_constants::kDefaultArea();
+    handshakeMsg.neighborNodeName_ref() = kNodeName;
+
+    thrift::SparkHelloPacket pkt;
+    pkt.handshakeMsg_ref() = std::move(handshakeMsg);
+    return pkt;
+  }
+
+  thrift::SparkHelloPacket
+  createHeartbeatPacket(SimulatedNeighbor const& neighbor) {
+    thrift::SparkHeartbeatMsg heartbeatMsg;
+    heartbeatMsg.nodeName = neighbor.nodeName;
+    heartbeatMsg.seqNum = 1;
+
+    thrift::SparkHelloPacket pkt;
+    pkt.heartbeatMsg_ref() = std::move(heartbeatMsg);
+    return pkt;
+  }
+
+ private:
+  std::shared_ptr<MockIoProvider> mockIoProvider_{nullptr};
+  std::unique_ptr<std::thread> mockIoProviderThread_{nullptr};
+  std::unique_ptr<SparkWrapper> spark_{nullptr};
+
+  // fd used to inject neighbors' packets
+  int injectFd_{-1};
+  std::vector<SimulatedNeighbor> neighbors_;
+
+  apache::thrift::CompactSerializer serializer_;
+};
+
+/**
+ * Benchmark for processing heartbeats of established neighbors
+ * 1. Bring up numOfNeighbors adjacencies with Spark
+ * 2. Every neighbor sends a heartbeat which re-arms its hold timer
+ * Time is measured from injecting the heartbeats until all are processed
+ */
+static void
+BM_SparkNeighborHeartbeat(
+    folly::UserCounters& counters, uint32_t iters, uint32_t numOfNeighbors) {
+  auto suspender = folly::BenchmarkSuspender();
+  SparkScaleFixture fixture(numOfNeighbors);
+  auto const heartbeats =
+      fixture.createRound([&fixture](auto const& neighbor) {
+        return fixture.createHeartbeatPacket(neighbor);
+      });
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    std::this_thread::sleep_for(kRoundInterval);
+    suspender.dismiss(); // Start measuring benchmark time
+    fixture.sendRound(heartbeats);
+    suspender.rehire(); // Stop measuring time again
+  }
+
+  counters["num_neighbors"] = numOfNeighbors;
+}
+
+// The parameter is the number of neighbors. Spark allocates a local label out
+// of kSrLocalRange (10k labels) for every adjacency, hence max is below 10k
+BENCHMARK_COUNTERS_PARAM(BM_SparkNeighborHeartbeat, counters, 1000);
+BENCHMARK_COUNTERS_PARAM(BM_SparkNeighborHeartbeat, counters, 3000);
+BENCHMARK_COUNTERS_PARAM(BM_SparkNeighborHeartbeat, counters, 9000);
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
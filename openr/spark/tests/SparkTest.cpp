@@ -6,6 +6,7 @@
  */
 
 #include <chrono>
+#include <limits>
 #include <thread>
 
 #include <glog/logging.h>
@@ -146,6 +147,8 @@ class SimpleSparkFixture : public SparkFixture {
       EXPECT_EQ(
           std::make_pair(ip2V4.first, ip2V6.first),
           SparkWrapper::getTransportAddrs(*event));
+      // support learnt from neighbor's handshake
+      EXPECT_TRUE(event->supportCompression);
       LOG(INFO) << "node-1 reported adjacency to node-2";
     }
 
@@ -157,6 +160,8 @@ class SimpleSparkFixture : public SparkFixture {
       EXPECT_EQ(
           std::make_pair(ip1V4.first, ip1V6.first),
           SparkWrapper::getTransportAddrs(*event));
+      // support learnt from neighbor's handshake
+      EXPECT_TRUE(event->supportCompression);
       LOG(INFO) << "node-2 reported adjacency to node-1";
     }
   }
@@ -1536,6 +1541,69 @@ TEST_F(SparkFixture, MultiplePeersWithDiffAreaOverSameLink) {
   }
 }
 
+//
+// Validate that packets filled in from templates are identical to the ones
+// serialized by generated thrift code, for values with different varint
+// encoded sizes (including negative ones)
+//
+TEST(SparkPacketTemplateTest, FillTest) {
+  const std::vector<int64_t> values = {
+      0,
+      1,
+      -1,
+      63,
+      -64,
+      64,
+      300,
+      -12345,
+      1600000000000000,
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min(),
+  };
+
+  thrift::SparkHelloMsg helloMsg;
+  helloMsg.domainName = kDomainName;
+  helloMsg.nodeName = "node-1";
+  helloMsg.ifName = iface1;
+  helloMsg.version = Constants::kOpenrVersion;
+  helloMsg.solicitResponse = true;
+  helloMsg.restarting = false;
+  helloMsg.neighborInfos["node-2"].seqNum = 5;
+  helloMsg.neighborInfos["node-2"].lastNbrMsgSentTsInUs = -7;
+  helloMsg.neighborInfos["node-3"].lastMyMsgRcvdTsInUs = 1600000000000000;
+  const auto helloTemplate = Spark::buildHelloTemplate(helloMsg);
+
+  thrift::SparkHeartbeatMsg heartbeatMsg;
+  heartbeatMsg.nodeName = "node-1";
+  const auto heartbeatTemplate = Spark::buildHeartbeatTemplate(heartbeatMsg);
+
+  for (auto seqNum : values) {
+    for (auto sentTsInUs : values) {
+      helloMsg.seqNum = seqNum;
+      helloMsg.sentTsInUs = sentTsInUs;
+      thrift::SparkHelloPacket expectedPkt;
+      expectedPkt.helloMsg_ref() = helloMsg;
+
+      auto packet = helloTemplate.fill({seqNum, sentTsInUs});
+      EXPECT_EQ(CompactSerializer::serialize<std::string>(expectedPkt), packet);
+      auto pkt =
+          CompactSerializer::deserialize<thrift::SparkHelloPacket>(packet);
+      ASSERT_TRUE(pkt.helloMsg_ref().has_value());
+      EXPECT_EQ(helloMsg, *pkt.helloMsg_ref());
+    }
+
+    heartbeatMsg.seqNum = seqNum;
+    thrift::SparkHelloPacket expectedPkt;
+    expectedPkt.heartbeatMsg_ref() = heartbeatMsg;
+
+    auto packet = heartbeatTemplate.fill({seqNum});
+    EXPECT_EQ(CompactSerializer::serialize<std::string>(expectedPkt), packet);
+    auto pkt = CompactSerializer::deserialize<thrift::SparkHelloPacket>(packet);
+    ASSERT_TRUE(pkt.heartbeatMsg_ref().has_value());
+    EXPECT_EQ(heartbeatMsg, *pkt.heartbeatMsg_ref());
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -1613,6 +1613,98 @@ TEST(MockIoProviderTestSetup, PartialMeshOfNodesTest) {
   mockIoProviderThread.join();
 }
 
+//
+// This test sends a batch of packets with IoProvider::sendMessages and
+// receives them with IoProvider::recvMessages.
+//
+// 2-node topology: 1 <-> 2 (2-node bidirectional)
+//
+TEST(MockIoProviderTestSetup, BatchedSendRecvTest) {
+  folly::IPAddressV6 ipAddr1V6("fe80::1");
+  folly::IPAddressV6 ipAddr2V6("fe80::2");
+
+  std::string ifName1("iface1");
+  std::string ifName2("iface2");
+
+  int ifIndex1 = 1;
+  int ifIndex2 = 2;
+
+  auto mockIoProvider = std::make_shared<MockIoProvider>();
+
+  // Start mock IoProvider thread
+  std::thread mockIoProviderThread([&]() {
+    LOG(INFO) << "Starting mockIoProvider thread.";
+    mockIoProvider->start();
+    LOG(INFO) << "mockIoProvider thread got stopped.";
+  });
+  mockIoProvider->waitUntilRunning();
+
+  mockIoProvider->addIfNameIfIndex({{ifName1, ifIndex1}, {ifName2, ifIndex2}});
+
+  // Bidirectional connectivity between 1 and 2.
+  ConnectedIfPairs connectedPairs = {
+      {ifName1, {{ifName2, 10}}},
+      {ifName2, {{ifName1, 10}}},
+  };
+  mockIoProvider->setConnectedPairs(connectedPairs);
+
+  int fd1 = createSocketAndJoinGroup(
+      mockIoProvider, ifIndex1, folly::IPAddress(kDiscardMulticastAddr));
+
+  int fd2 = createSocketAndJoinGroup(
+      mockIoProvider, ifIndex2, folly::IPAddress(kDiscardMulticastAddr));
+
+  const std::vector<std::string> packets = {
+      "This is batched message #1 from node1 to node2.",
+      "This is batched message #2 from node1 to node2.",
+      "This is batched message #3 from node1 to node2.",
+  };
+
+  // Send all packets with a single call
+  const folly::SocketAddress dstAddr(ipAddr2V6, kMockedUdpPort);
+  std::vector<IoProvider::SendMessage> sendMsgs;
+  for (auto const& packet : packets) {
+    sendMsgs.emplace_back(
+        IoProvider::SendMessage{ifIndex1, ipAddr1V6, dstAddr, packet});
+  }
+  auto bytesSent =
+      IoProvider::sendMessages(fd1, sendMsgs, mockIoProvider.get());
+  ASSERT_EQ(packets.size(), bytesSent.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(static_cast<ssize_t>(packets[i].size()), bytesSent[i]);
+  }
+
+  // Receive packets in batches till all of them are read. Messages are
+  // delivered in order they are sent
+  const unsigned int kNumMsgs = 4;
+  std::vector<unsigned char> recvBuf(kNumMsgs * kMinIpv6PktSize);
+  std::vector<std::string> recvPackets;
+  while (recvPackets.size() < packets.size()) {
+    waitForDataToRead(fd2);
+    auto recvMsgs = IoProvider::recvMessages(
+        fd2, recvBuf.data(), kMinIpv6PktSize, kNumMsgs, mockIoProvider.get());
+    EXPECT_GE(kNumMsgs, recvMsgs.size());
+    for (auto const& recvMsg : recvMsgs) {
+      EXPECT_EQ(ifIndex2, recvMsg.ifIndex);
+      EXPECT_EQ(folly::IPAddress(ipAddr1V6), recvMsg.srcAddr.getIPAddress());
+      recvPackets.emplace_back(
+          reinterpret_cast<const char*>(recvMsg.data.data()),
+          recvMsg.data.size());
+    }
+  }
+  EXPECT_EQ(packets, recvPackets);
+
+  // Sanity check. Nothing left to read
+  EXPECT_TRUE(
+      IoProvider::recvMessages(
+          fd2, recvBuf.data(), kMinIpv6PktSize, kNumMsgs, mockIoProvider.get())
+          .empty());
+
+  // Cleanup
+  mockIoProvider->stop();
+  mockIoProviderThread.join();
+}
+
 int
 main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
@@ -83,6 +83,7 @@ MockIoProvider::recvmsg(int sockFd, struct msghdr* msg, int /* flags */) {
   if (it->second.size() == 0) {
     VLOG(4) << "Empty mailbox for fd " << sockFd << " ifName "
             << fdToIfName_[sockFd];
+    errno = EAGAIN;
     return -1;
   }
 
@@ -250,6 +251,49 @@ MockIoProvider::sendmsg(int sockFd, const struct msghdr* msg, int /* flags */) {
   return -1;
 }
 
+int
+MockIoProvider::recvmmsg(
+    int sockFd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  VLOG(4) << "MockIoProvider::recvmmsg called";
+
+  unsigned int numRead{0};
+  // First message has been notified. Rest must be active to be delivered
+  while (numRead < vlen and (numRead == 0 or hasActiveMessage(sockFd))) {
+    auto bytesRead = recvmsg(sockFd, &msgvec[numRead].msg_hdr, flags);
+    if (bytesRead < 0) {
+      break;
+    }
+    msgvec[numRead].msg_len = bytesRead;
+    ++numRead;
+  }
+  return numRead ? numRead : -1;
+}
+
+int
+MockIoProvider::sendmmsg(
+    int sockFd, struct mmsghdr* msgvec, unsigned int vlen, int flags) {
+  VLOG(4) << "MockIoProvider::sendmmsg called";
+
+  unsigned int numSent{0};
+  while (numSent < vlen) {
+    auto bytesSent = sendmsg(sockFd, &msgvec[numSent].msg_hdr, flags);
+    if (bytesSent < 0) {
+      break;
+    }
+    msgvec[numSent].msg_len = bytesSent;
+    ++numSent;
+  }
+  return numSent ? numSent : -1;
+}
+
+bool
+MockIoProvider::hasActiveMessage(int sockFd) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = mailboxes_.find(sockFd);
+  return it != mailboxes_.end() and not it->second.empty() and
+      it->second.front().isActive();
+}
+
 //
 // Simply accept all setsockopts, and build fd to ifName mapping
 //
@@ -303,6 +347,16 @@ MockIoProvider::addIfNameIfIndex(const IfNameAndifIndex& entries) {
   }
 }
 
+size_t
+MockIoProvider::getNumPendingMessages() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t numMessages{0};
+  for (auto const& kv : mailboxes_) {
+    numMessages += kv.second.size();
+  }
+  return numMessages;
+}
+
 //
 // This is invoked often. It loops through all mailboxes and send a signal
 // to spark (via linux pipe) to read the message if there is any active
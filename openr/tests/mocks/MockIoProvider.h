@@ -92,6 +92,16 @@ class MockIoProvider final : public IoProvider {
 
   ssize_t sendmsg(int sockfd, const struct msghdr* msg, int flags) override;
 
+  // Batched versions are built on top of recvmsg/sendmsg. recvmmsg delivers
+  // the notified message and whichever messages behind it are active
+  int recvmmsg(
+      int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags)
+      override;
+
+  int sendmmsg(
+      int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags)
+      override;
+
   int setsockopt(
       int sockfd,
       int level,
@@ -104,6 +114,9 @@ class MockIoProvider final : public IoProvider {
   //
   void addIfNameIfIndex(const IfNameAndifIndex& entries);
 
+  // Number of messages sitting in mailboxes which are yet to be received
+  size_t getNumPendingMessages();
+
  private:
   // Boolean to keep track of running-state of MockIoProvider
   std::atomic<bool> isRunning_{false};
@@ -163,6 +176,9 @@ class MockIoProvider final : public IoProvider {
     bool clientNotified{false};
   };
 
+  // Is there an active message in mailbox of fd
+  bool hasActiveMessage(int sockFd);
+
   // the list of messages pending per fd
   std::map<int /* fd */, std::list<IoMessage>> mailboxes_{};
 };
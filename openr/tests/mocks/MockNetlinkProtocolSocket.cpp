@@ -53,6 +53,12 @@ MockNetlinkProtocolSocket::addRoute(const fbnl::Route& route) {
   } else {
     unicastRoutes_[proto][route.getDestination()] = route;
   }
+
+  // Send route event
+  if (routeEventCB_ and not routeEventsLost_) {
+    routeEventCB_(route, false);
+  }
+
   return folly::SemiFuture<int>(0);
 }
 
@@ -66,12 +72,53 @@ MockNetlinkProtocolSocket::deleteRoute(const fbnl::Route& route) {
   } else {
     cnt = unicastRoutes_[proto].erase(route.getDestination());
   }
+
+  // Send route event for deleted route
+  if (cnt and routeEventCB_ and not routeEventsLost_) {
+    fbnl::RouteBuilder builder;
+    if (route.getFamily() == AF_MPLS) {
+      builder.setMplsLabel(route.getMplsLabel().value());
+    } else {
+      builder.setDestination(route.getDestination());
+    }
+    builder.setProtocolId(proto)
+        .setRouteTable(route.getRouteTable())
+        .setValid(false);
+    routeEventCB_(builder.build(), false);
+  }
+
   // Return 0 on success else ESRCH (no such process) error code
   return folly::SemiFuture<int>(cnt ? 0 : ESRCH);
 }
 
+folly::SemiFuture<NetlinkRouteBatchMessage::Errors>
+MockNetlinkProtocolSocket::addRoutes(const std::vector<fbnl::Route>& routes) {
+  NetlinkRouteBatchMessage::Errors errors;
+  for (size_t i = 0; i < routes.size(); ++i) {
+    auto status = addRoute(routes[i]).get();
+    if (status != 0) {
+      errors.emplace_back(i, status);
+    }
+  }
+  return errors;
+}
+
+folly::SemiFuture<NetlinkRouteBatchMessage::Errors>
+MockNetlinkProtocolSocket::deleteRoutes(
+    const std::vector<fbnl::Route>& routes) {
+  NetlinkRouteBatchMessage::Errors errors;
+  for (size_t i = 0; i < routes.size(); ++i) {
+    auto status = deleteRoute(routes[i]).get();
+    if (status != 0) {
+      errors.emplace_back(i, status);
+    }
+  }
+  return errors;
+}
+
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
 MockNetlinkProtocolSocket::getRoutes(const fbnl::Route& filter) {
+  ++numGetRoutes_;
   const auto filterFamily = filter.getFamily();
   const auto filterProto = filter.getProtocolId();
   const auto filterType = filter.getType();
@@ -184,6 +231,26 @@ MockNetlinkProtocolSocket::addLink(const fbnl::Link& link) {
   // Create entry in ifAddr_ for link if doesn't exists
   ifAddrs_.emplace(link.getIfIndex(), std::list<fbnl::IfAddress>());
 
+  // Like kernel, silently flush IPv4 routes over link going down
+  if (not link.isUp()) {
+    for (auto& [_, routes] : unicastRoutes_) {
+      for (auto it = routes.begin(); it != routes.end();) {
+        bool isOverLink{false};
+        for (auto const& nh : it->second.getNextHops()) {
+          isOverLink |= nh.getIfIndex() == link.getIfIndex();
+        }
+        if (it->first.first.isV4() and isOverLink) {
+          it = routes.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    if (routesFlushedCB_) {
+      routesFlushedCB_(link.getIfIndex());
+    }
+  }
+
   // Send link event
   if (linkEventCB_) {
     linkEventCB_(link, false);
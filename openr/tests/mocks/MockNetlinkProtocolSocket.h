@@ -44,7 +44,8 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
       : NetlinkProtocolSocket(evb) {}
 
   /**
-   * API to create links for testing purposes
+   * API to create links for testing purposes. Link going down flushes IPv4
+   * routes over it without route events, like kernel does
    */
   folly::SemiFuture<int> addLink(const fbnl::Link& link);
 
@@ -54,6 +55,10 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
 
   folly::SemiFuture<int> addRoute(const fbnl::Route& route) override;
   folly::SemiFuture<int> deleteRoute(const fbnl::Route& route) override;
+  folly::SemiFuture<NetlinkRouteBatchMessage::Errors> addRoutes(
+      const std::vector<fbnl::Route>& routes) override;
+  folly::SemiFuture<NetlinkRouteBatchMessage::Errors> deleteRoutes(
+      const std::vector<fbnl::Route>& routes) override;
   folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>> getRoutes(
       const fbnl::Route& filter) override;
 
@@ -68,6 +73,26 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   folly::SemiFuture<folly::Expected<std::vector<fbnl::Neighbor>, int>>
   getAllNeighbors() override;
 
+  /**
+   * Number of getRoutes calls (route dumps) made so far
+   */
+  size_t
+  getNumGetRoutes() const {
+    return numGetRoutes_;
+  }
+
+  /**
+   * Drop route events while set, as if they were lost. Unsetting it reports
+   * lost events as on receive buffer overrun
+   */
+  void
+  setRouteEventsLost(bool lost) {
+    routeEventsLost_ = lost;
+    if (not lost and eventsLostCB_) {
+      eventsLostCB_();
+    }
+  }
+
  protected:
   void
   init() override {
@@ -88,6 +113,12 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   std::unordered_map<uint8_t, std::map<folly::CIDRNetwork, fbnl::Route>>
       unicastRoutes_;
   std::unordered_map<uint8_t, std::map<uint32_t, fbnl::Route>> mplsRoutes_;
+
+  // Number of getRoutes calls
+  size_t numGetRoutes_{0};
+
+  // Whether route events are dropped
+  bool routeEventsLost_{false};
 };
 
 } // namespace openr::fbnl